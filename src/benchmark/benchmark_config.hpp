@@ -1,7 +1,10 @@
 #ifndef BENCHMARK_CONFIG_HPP
 #define BENCHMARK_CONFIG_HPP
 
+#include "utils/thread_scheduling.hpp"
 #include <string>
+#include <vector>
+#include <utility>
 #include <optional>
 
 namespace video_bench {
@@ -22,11 +25,158 @@ struct BenchmarkConfig {
     // Optional: CSV output file path
     std::optional<std::string> csv_file;
 
+    // Optional: result cache directory (reuse points measured with same key)
+    std::optional<std::string> cache_dir;
+
+    // Re-measure cached points (results are still written to the cache)
+    bool force_remeasure = false;
+
     // Measurement duration per test in seconds
     double measurement_duration = 10.0;
 
     // CPU usage threshold percentage
     double cpu_threshold = 85.0;
+
+    // Optional: JPEG snapshot every N seconds per stream (default: disabled)
+    std::optional<double> snapshot_interval;
+
+    // Snapshot thumbnail width in pixels (height keeps aspect ratio)
+    int snapshot_width = 320;
+
+    // Shared snapshot encoder threads (0 = encode inline on each decoder thread)
+    int snapshot_workers = 0;
+
+    // Optional: run motion detection on up to N frames per second per stream
+    std::optional<double> motion_fps;
+
+    // Luma downsampling factor for motion detection (every Nth pixel)
+    int motion_downsample = 4;
+
+    // Optional: gather frames from all streams into NCHW float batches of N
+    // (resize + YUV -> RGB + normalize), as a CPU inference node would
+    std::optional<int> infer_batch;
+
+    // Frames per second each stream submits to the batcher
+    double infer_fps = 5.0;
+
+    // Square model input size in pixels
+    int infer_input = 224;
+
+    // A partial batch is flushed once its oldest frame has waited this long
+    double infer_deadline_ms = 100.0;
+
+    // Optional: keep a last-GOP packet ring per stream and simulate a
+    // channel switch (burst decode from last IDR) every N seconds
+    std::optional<double> switch_interval;
+
+    // Hash every decoded frame and compare against a single-threaded
+    // reference decode of the same file (local files only)
+    bool verify_output = false;
+
+    // Substream mode for very high stream counts: shared readers, small
+    // queues, single-threaded decoders and a doubling ladder into thousands
+    bool substream_mode = false;
+
+    // Serve the local file through an in-process RTSP server on loopback
+    // and benchmark it as a live source (Linux only)
+    bool stand_in = false;
+
+    // RTP transport requested from RTSP servers: "tcp" or "udp"
+    std::string rtsp_transport = "tcp";
+
+    // Optional: receive RTP over UDP with N recvmmsg() threads sharing one
+    // SO_REUSEPORT port instead of FFmpeg's per-stream sockets (Linux only)
+    std::optional<int> batched_udp;
+
+    // Stand-in also serves RTSPS; the ladder runs again with all ingest
+    // over TLS to compare max streams and reader CPU per Mbit
+    bool tls = false;
+
+    // OpenSSL cipher list or TLS 1.3 suites for the stand-in (empty = defaults)
+    std::string tls_cipher;
+
+    // Serve the local file as "hls" or "dash" from an in-process HTTP server
+    // on loopback (empty = disabled, Linux only)
+    std::string segment_format;
+
+    // Segment durations in seconds; the ladder runs once per duration
+    std::vector<double> segment_durations = {4.0};
+
+    // Optional: sample all threads with SIGPROF during each test and write
+    // flat and folded-stack profiles to this directory (Linux only)
+    std::optional<std::string> profile_dir;
+
+    // Samples per second of CPU time, per thread
+    int profile_hz = 499;
+
+    // Scheduling policy per thread role (default: inherit from the process)
+    SchedPolicy decoder_sched;
+    SchedPolicy reader_sched;
+    SchedPolicy background_sched = {SchedPolicy::Kind::Idle};
+
+    // The last N streams of each test are background streams: decoded under
+    // background_sched and left out of pass/fail (one stream stays foreground)
+    int background_streams = 0;
+
+    // Optional: repeat the ladder once per decoder policy and compare
+    std::vector<SchedPolicy> sched_compare;
+
+    // Fleet agent: serve coordinators on "PORT" or "ADDR:PORT" (empty = off)
+    std::string agent_listen;
+
+    // Fleet coordinator: agents as host:port (empty = off); agent_args is
+    // the rest of the command line, sent to every agent
+    std::vector<std::string> coordinator_agents;
+    std::vector<std::string> agent_args;
+
+    // Decode loop microbenchmark: frames per configuration (0 = off)
+    int loop_bench_frames = 0;
+
+    // Optional: production canary; decode a short reference clip within a
+    // CPU budget and compare its speed with the baseline in this file
+    std::optional<std::string> canary_baseline;
+    double canary_budget = 10.0;     // Percent of one core
+    double canary_tolerance = 10.0;  // Percent slower than the baseline
+    double canary_interval = 0.0;    // Seconds between checks (0 = once)
+    std::optional<std::string> canary_metrics;  // Prometheus textfile
+
+    // Optional: remux every stream into rolling segment files in this
+    // directory while decoding, then rerun the ladder without (Linux only)
+    std::optional<std::string> record_dir;
+
+    // Segment container ("mp4" fragmented or "mkv") and length in seconds
+    std::string record_format = "mp4";
+    double record_segment = 60.0;
+
+    // When recorded data is fsync'ed: "none", "segment" or "keyframe"
+    std::string record_fsync = "segment";
+
+    // Write segments with O_DIRECT, bypassing the page cache
+    bool record_direct = false;
+
+    // Optional: repeat the ladder as fast-forward playback at each speed
+    // (multiples of the target FPS, e.g. 2, 4, 8, 16)
+    std::vector<int> playback_speeds;
+
+    // Reverse playback: every stream plays the file backwards from a
+    // bounded cache of decoded frames (local file only)
+    bool reverse = false;
+    int reverse_cache = 120;  // Frames per stream
+    int reverse_width = 0;    // Cached frame width (0 = decoded size)
+
+    // Optional: video wall mosaic; every stream is scaled into a tile of a
+    // shared canvas presented at mosaic_fps. One ladder per canvas size
+    std::vector<std::pair<int, int>> mosaic_canvases;  // Width, height
+    double mosaic_fps = 30.0;
+
+    // Optional: repeat the ladder with packets above each temporal layer
+    // dropped before decoding (0 = base layer only)
+    std::vector<int> temporal_layers;
+
+    // Optional: hold a PM QoS request for this wakeup latency (us) during
+    // each test and report power and idle states; the ladder is repeated
+    // without it for comparison (Linux, needs root)
+    std::optional<int> cpu_latency_us;
 };
 
 } // namespace video_bench
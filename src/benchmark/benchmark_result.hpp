@@ -1,24 +1,322 @@
 #ifndef BENCHMARK_RESULT_HPP
 #define BENCHMARK_RESULT_HPP
 
+#include "utils/latency_stats.hpp"
 #include <string>
 #include <vector>
+#include <optional>
+#include <cstdint>
 
 namespace video_bench {
 
+// Late frames and their root causes for a single test (all streams combined)
+struct LagStats {
+    int64_t late_frames = 0;
+    double max_lag_ms = 0.0;
+    int64_t slow_decode = 0;       // The decode call itself dominated
+    int64_t slow_decode_key = 0;   // ...with a keyframe packet sent in the cycle
+    int64_t slow_decode_delta = 0; // ...with only non-key packets
+    int64_t stage_work = 0;        // Per-frame stages (snapshot, hash, motion, tile)
+    int64_t reader_starved = 0;    // Waiting on an empty packet queue
+    int64_t scheduler_delay = 0;   // Runnable but not running (schedstat)
+    int64_t oversleep = 0;         // Woke up late from the pacing sleep
+    bool run_delay_available = false;
+    LatencySummary lateness;       // Per frame past its deadline, foreground streams
+};
+
+// Snapshot stage statistics for a single test (all streams combined)
+struct SnapshotStats {
+    int64_t taken = 0;
+    int64_t dropped = 0;        // Requests dropped by a saturated worker pool
+    int64_t avg_bytes = 0;      // Average JPEG size
+    LatencySummary latency;     // Request-to-encoded latency
+};
+
+// Motion detection statistics for a single test (all streams combined)
+struct MotionStats {
+    int64_t frames_analyzed = 0;
+    int64_t motion_frames = 0;  // Frames with at least one changed block
+    LatencySummary cost;        // Per-frame processing time
+    std::string kernel;         // SAD kernel in use (avx2, sse2, neon, scalar)
+};
+
+// Channel switch (last-GOP burst decode) statistics for a single test
+struct SwitchStats {
+    int64_t switches = 0;
+    LatencySummary latency;         // Switch request to newest frame decoded
+    double avg_cpu_ms = 0.0;        // CPU time per switch
+    double avg_frames = 0.0;        // Frames burst-decoded per switch
+    size_t ring_kb_per_stream = 0;  // Average peak GOP ring size per stream
+    size_t ring_kb_total = 0;       // Sum of peak GOP ring sizes
+};
+
+// Output hash verification statistics for a single test
+struct HashCheckStats {
+    int64_t frames_checked = 0;
+    int64_t mismatches = 0;
+    int64_t unchecked = 0;      // Frames past the end of the reference sequence
+    std::vector<int64_t> per_stream_mismatches;
+    std::vector<int64_t> per_stream_first_mismatch;  // Frame index in loop, -1 if none
+    LatencySummary cost;        // Per-frame hashing time
+    std::string kernel;         // Hash kernel in use (avx2, sse2, neon, scalar)
+};
+
+// Cross-stream inference batching statistics for a single test
+struct BatchStats {
+    int batch_size = 0;
+    int64_t frames_batched = 0;
+    int64_t frames_dropped = 0;     // Submissions dropped by a saturated batcher
+    int64_t full_batches = 0;
+    int64_t deadline_batches = 0;   // Partial batches flushed at the deadline
+    double batches_per_sec = 0.0;
+    LatencySummary assembly;        // Oldest frame submitted to batch complete
+    LatencySummary convert;         // Per-frame resize + YUV -> RGB time
+    std::string kernel;             // YUV -> RGB kernel in use (avx2, sse2, neon, scalar)
+};
+
+// Network stack (IRQ/softirq) CPU for live ingest, split out of cpu_usage
+struct NetworkStats {
+    double cpu_usage = 0.0;          // Network share of total CPU (same scale as cpu_usage)
+    double decode_cpu_usage = 0.0;   // cpu_usage minus the network share
+    double rx_mbps = 0.0;            // Received Mbit/s on all interfaces
+    double cpu_ms_per_mbit = 0.0;    // Core-ms of IRQ/softirq time per received Mbit
+    double core_pct_per_stream = 0.0;  // Network CPU in % of one core per stream
+    int64_t net_rx_softirqs = 0;
+    int64_t nic_interrupts = 0;
+    int64_t udp_in_datagrams = 0;
+    int64_t udp_rcvbuf_errors = 0;
+    int64_t tcp_in_segs = 0;
+};
+
+// RTP ingest path cost for live sources
+struct IngestStats {
+    std::string path;                  // "ffmpeg-tcp", "ffmpeg-udp" or "recvmmsg"
+    int receiver_threads = 0;          // recvmmsg() threads (batched path only)
+    double recv_syscalls_per_sec = 0.0;  // 0 when unknown (stock TCP path)
+    double datagrams_per_sec = 0.0;
+    double stand_in_cpu_usage = 0.0;   // Stand-in server CPU removed from cpu_usage
+    double core_pct_per_stream = 0.0;  // cpu_usage in % of one core per stream
+    double reader_cpu_ms_per_mbit = 0.0;  // FFmpeg reader threads (socket, TLS, demux)
+    int64_t lost_packets = 0;          // RTP sequence gaps (batched path only)
+    int64_t dropped_units = 0;         // Access units dropped on full queues
+};
+
+// HLS/DASH fetch cost from the segment server (--segmented)
+struct SegmentStats {
+    std::string format;                // "hls" or "dash"
+    double segment_duration = 0.0;     // Mean served segment length in seconds
+    int64_t segments_fetched = 0;      // Media segment requests, all streams
+    int64_t manifest_fetches = 0;      // Playlist/MPD requests, all streams
+    double reader_cpu_ms_per_segment = 0.0;  // FFmpeg reader threads (HTTP, demux)
+    double server_cpu_usage = 0.0;     // Segment server CPU removed from cpu_usage
+};
+
+// Sampling profile of one test (--profile); full profile in the files
+struct ProfileStats {
+    int64_t samples = 0;
+    int64_t dropped = 0;          // Samples lost to a full buffer
+    int threads = 0;              // Threads sampled (decoders, readers, FFmpeg workers)
+    std::vector<std::string> top_symbols;  // Hottest functions by self samples
+    std::vector<double> top_self_pct;      // Their share of all samples
+    std::string flat_path;        // Flat profile text file
+    std::string folded_path;      // Folded stacks for flame graphs
+};
+
+// Recording path of a test (--record): all streams together
+struct RecordStats {
+    std::string format;            // "mp4" or "mkv"
+    double segment_seconds = 0.0;
+    std::string fsync;             // "none", "segment" or "keyframe"
+    bool direct_io = false;
+    int64_t bytes_written = 0;
+    double write_mb_per_sec = 0.0;
+    int64_t segments = 0;          // Segments completed
+    LatencySummary fsync_latency;
+};
+
+// Fast-forward playback of a test (--playback): FPS fields count media
+// frames played, so a session passes when media advances at speed x target
+struct PlaybackStats {
+    int speed = 0;
+    std::string strategy;        // "full", "nonref-drop" or "keyframes"
+    double displayed_fps = 0.0;  // Frames shown per second per session
+    double skipped_pct = 0.0;    // Media frames never shown
+};
+
+// Reverse playback of a test (--reverse): per session averages
+struct ReverseStats {
+    int cache_frames = 0;
+    int cache_width = 0;                 // 0 = decoded size
+    double cache_mb_per_session = 0.0;   // Peak size of the frame cache
+    double rss_mb_per_session = 0.0;     // Process RSS growth over idle
+    double decode_ratio = 0.0;           // Frames decoded per frame shown
+    double chunks_per_sec = 0.0;         // Seek + forward decode passes
+};
+
+// Temporal layer pruning of a test (--temporal-layers): FPS fields count
+// media frames, so a session passes when media advances at the target FPS
+struct LayerStats {
+    int max_layer = 0;               // Layers above this were dropped
+    int highest_layer = 0;           // Highest layer in the stream
+    double decoded_fps = 0.0;        // Frames decoded per second per session
+    double dropped_pct = 0.0;        // Packets dropped before the decoder
+    double parse_ns_per_packet = 0.0;
+    double parse_us_per_sec = 0.0;   // Header parsing time per second per session
+};
+
+// Package power and idle states of a test (--cpu-latency)
+struct PowerStats {
+    int cpu_latency_us = -1;          // PM QoS request held (-1 = none)
+    bool has_energy = false;          // RAPL counters readable (usually root only)
+    double package_watts = 0.0;
+    double idle_entries_per_sec = 0.0;  // Per core, all idle states
+    std::vector<std::string> cstate_names;      // Shallowest first
+    std::vector<int> cstate_latency_us;         // Exit latency
+    std::vector<double> cstate_residency_pct;   // Average over cores
+};
+
+// Video wall mosaic of a test (--mosaic): composites inside the window
+struct MosaicStats {
+    std::string canvas;              // WxH
+    std::string layout;              // Grid, e.g. "4x4"
+    int tile_width = 0;
+    int tile_height = 0;
+    double fps = 0.0;                // Composite rate
+    int64_t composites = 0;
+    int64_t slots = 0;               // Composite slots, including skipped ones
+    int64_t deadline_misses = 0;     // Slots without a composite ready in time
+    double stale_tile_pct = 0.0;     // Tiles shown without a fresh frame
+    LatencySummary compose;          // Canvas copy per composite
+    LatencySummary tile_scale;       // Per frame scaled into a tile
+    bool deadline_passed = true;     // Misses within 1% of slots
+};
+
+// Thread scheduling of a test (--decoder-sched, --background-streams, ...)
+struct SchedStats {
+    std::string decoder;           // Policy spec per thread role
+    std::string reader;
+    std::string background;
+    int background_streams = 0;    // Not part of min_fps or pass/fail
+    double background_avg_fps = 0.0;
+    double background_min_fps = 0.0;
+};
+
+// Per-stream harness footprint in substream mode
+struct HarnessStats {
+    double kb_per_stream = 0.0;  // RSS growth over the idle process per stream
+    int readers = 0;             // Demuxer/reader instances serving all streams
+    int queue_size = 0;          // Packet queue depth per stream
+    uint64_t fd_limit = 0;       // Open file limit after raising
+};
+
+// Plaintext vs TLS ingest from the stand-in (both ladders in test_results)
+struct TlsComparison {
+    std::string cipher;               // Negotiated cipher suite
+    int plain_max_streams = 0;
+    int tls_max_streams = 0;
+    double plain_reader_cpu_ms_per_mbit = 0.0;  // At 1 stream
+    double tls_reader_cpu_ms_per_mbit = 0.0;    // At 1 stream
+    double tls_cpu_ms_per_mbit = 0.0;           // Difference: TLS cost per Mbit
+};
+
+// Capacity with and without recording (--record); both ladders in test_results
+struct RecordComparison {
+    int recording_max_streams = 0;
+    int baseline_max_streams = 0;
+};
+
+// Capacity with and without snapshots (--snapshot-interval); both ladders in test_results
+struct SnapshotComparison {
+    int snapshot_max_streams = 0;
+    int baseline_max_streams = 0;
+};
+
+// Lateness and power with and without a PM QoS request (--cpu-latency);
+// both ladders in test_results, compared at their first (lowest) step
+struct CpuLatencyComparison {
+    int latency_us = 0;
+    int streams = 0;                  // Stream count of the compared step
+    int held_max_streams = 0;
+    int released_max_streams = 0;
+    LatencySummary held_lateness;
+    LatencySummary released_lateness;
+    bool has_energy = false;
+    double held_watts = 0.0;
+    double released_watts = 0.0;
+};
+
+// One ladder of a segment duration sweep (all ladders in test_results)
+struct SegmentSweepPoint {
+    double segment_duration = 0.0;
+    int max_streams = 0;
+    double reader_cpu_ms_per_segment = 0.0;  // At 1 stream
+};
+
+// One ladder of a playback speed (--playback; all ladders in test_results)
+struct PlaybackPoint {
+    int speed = 0;
+    std::string strategy;
+    int max_sessions = 0;
+    double displayed_fps = 0.0;  // Per session at max_sessions
+};
+
+// One ladder of a temporal layer (--temporal-layers; all ladders in test_results)
+struct LayerPoint {
+    int max_layer = 0;
+    int max_streams = 0;
+    double decoded_fps = 0.0;    // Per session at max_streams
+    double dropped_pct = 0.0;
+};
+
+// One ladder of a mosaic canvas size (--mosaic; all ladders in test_results)
+struct MosaicPoint {
+    std::string canvas;
+    std::string layout;          // Grid at max_tiles
+    int max_tiles = 0;
+    double deadline_miss_pct = 0.0;  // At max_tiles
+};
+
+// One ladder of a scheduling policy comparison (--sched-compare)
+struct SchedComparisonPoint {
+    std::string decoder;        // Decoder policy spec
+    int max_streams = 0;
+    LatencySummary lateness;    // Foreground frames at max_streams
+};
+
 // Result of a single stream count test
 struct StreamTestResult {
     int stream_count;
     double fps_per_stream;      // Average FPS across all streams
-    double min_fps;             // Minimum FPS among all streams
+    double min_fps;             // Minimum FPS among all (foreground) streams
     double max_fps;             // Maximum FPS among all streams
+    double window_seconds = 0.0;         // Common window frames were counted in
+    double legacy_fps_per_stream = 0.0;  // All decoded frames / main-thread elapsed
     std::vector<double> per_stream_fps;  // FPS for each individual stream
     std::vector<int64_t> per_stream_frames;  // Frame count for each stream
     double cpu_usage;           // Average CPU usage percentage
     size_t memory_usage_mb = 0; // Process RSS in MB (informational)
+    LagStats lag;                           // Late frames by root cause
+    std::optional<SnapshotStats> snapshot;  // Set when snapshot stage is enabled
+    std::optional<MotionStats> motion;      // Set when motion detection is enabled
+    std::optional<SwitchStats> channel_switch;  // Set when switch simulation is enabled
+    std::optional<HashCheckStats> hash_check;   // Set when output verification is enabled
+    std::optional<BatchStats> batch;            // Set when inference batching is enabled
+    std::optional<HarnessStats> harness;        // Set in substream mode
+    std::optional<NetworkStats> network;        // Set for live sources where supported
+    std::optional<IngestStats> ingest;          // Set for live sources
+    std::optional<SegmentStats> segment;        // Set for segmented (HLS/DASH) input
+    std::optional<ProfileStats> profile;        // Set when profiling is enabled
+    std::optional<SchedStats> sched;            // Set when a scheduling option is given
+    std::optional<RecordStats> record;          // Set while recording
+    std::optional<PlaybackStats> playback;      // Set for fast-forward playback ladders
+    std::optional<ReverseStats> reverse;        // Set in reverse playback mode
+    std::optional<MosaicStats> mosaic;          // Set in mosaic mode
+    std::optional<LayerStats> layers;           // Set for temporal layer ladders
+    std::optional<PowerStats> power;            // Set when comparing a PM QoS request
     bool fps_passed;            // Met FPS requirement (based on min_fps)
     bool cpu_passed;            // Met CPU threshold
     bool passed;                // Both requirements met
+    bool from_cache = false;    // Loaded from the result cache, not measured
 
     std::string getStatusSymbol() const {
         return passed ? "\xE2\x9C\x93" : "\xE2\x9C\x97";  // UTF-8 for ✓ and ✗
@@ -26,6 +324,8 @@ struct StreamTestResult {
 
     std::string getFailureReason() const {
         if (passed) return "";
+        if (hash_check && hash_check->mismatches > 0) return "Output mismatch";
+        if (mosaic && !mosaic->deadline_passed) return "Composite deadline missed";
         if (!fps_passed) return "FPS below target";
         if (!cpu_passed) return "CPU threshold exceeded";
         return "Unknown";
@@ -55,11 +355,52 @@ struct BenchmarkResult {
     // Maximum successful stream count
     int max_streams;
 
+    // Set when the ladder was repeated over TLS (--tls)
+    std::optional<TlsComparison> tls;
+
+    // One point per segment duration when several were swept (--segment-duration)
+    std::vector<SegmentSweepPoint> segment_sweep;
+
+    // One point per decoder policy when compared (--sched-compare)
+    std::vector<SchedComparisonPoint> sched_comparison;
+
+    // Set when recording (--record)
+    std::optional<RecordComparison> recording;
+
+    // Set when snapshots were taken (--snapshot-interval)
+    std::optional<SnapshotComparison> snapshots;
+
+    // Set when a PM QoS request was compared (--cpu-latency)
+    std::optional<CpuLatencyComparison> cpu_latency;
+
+    // One point per fast-forward speed (--playback)
+    std::vector<PlaybackPoint> playback;
+
+    // One point per temporal layer (--temporal-layers)
+    std::vector<LayerPoint> layers;
+
+    // One point per mosaic canvas size (--mosaic)
+    std::vector<MosaicPoint> mosaic;
+
     // Whether benchmark completed successfully
     bool success;
     std::string error_message;
 };
 
+// One agent of a fleet run (--coordinator)
+struct FleetHostResult {
+    std::string agent;        // host:port as given
+    BenchmarkResult result;   // Host and source info, tests and max streams
+};
+
+// Fleet report: every step ran on all remaining agents at the same time
+struct FleetResult {
+    std::vector<FleetHostResult> hosts;
+    int total_max_streams = 0;  // Sum of per-agent max streams
+    bool success = false;
+    std::string error_message;
+};
+
 } // namespace video_bench
 
 #endif // BENCHMARK_RESULT_HPP
@@ -1,8 +1,30 @@
 #include "benchmark/benchmark_runner.hpp"
 #include "decoder/decoder_thread.hpp"
+#include "decoder/channel_switch_simulator.hpp"
+#include "decoder/decode_loop.hpp"
+#include "decoder/packet_queue.hpp"
+#include "decoder/packet_reader.hpp"
+#include "decoder/reverse_player.hpp"
+#include "pipeline/simd_kernels.hpp"
+#include "pipeline/frame_hasher.hpp"
+#include "pipeline/inference_batcher.hpp"
+#include "pipeline/mosaic_compositor.hpp"
 #include "monitor/cpu_monitor.hpp"
 #include "monitor/memory_monitor.hpp"
+#include "monitor/network_monitor.hpp"
+#include "monitor/power_monitor.hpp"
 #include "monitor/system_info.hpp"
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+#include "network/batched_rtp_receiver.hpp"
+#include "network/rtsp_stand_in.hpp"
+#include "network/segment_server.hpp"
+#endif
+#ifdef VIDEO_BENCH_SAMPLING_PROFILER
+#include "monitor/sampling_profiler.hpp"
+#endif
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+#include "pipeline/segment_recorder.hpp"
+#endif
 #include <vector>
 #include <memory>
 #include <chrono>
@@ -10,6 +32,10 @@
 #include <barrier>
 #include <atomic>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
 
 namespace video_bench {
 
@@ -26,15 +52,47 @@ constexpr int kExtraStepStreams = 12;
 constexpr int kLinearStepSize = 4;
 // First linear step value
 constexpr int kLinearStepStart = 20;
+// Substream mode: decoders fed by one shared reader (local files only)
+constexpr int kStreamsPerSharedReader = 16;
+// Substream mode: packet queue depth per stream
+constexpr size_t kSubstreamQueueSize = 8;
+// Substream mode: default upper bound when --max-streams is not given
+constexpr int kSubstreamDefaultMaxStreams = 4096;
+// Profiler: hottest functions kept in the result (all are in the files)
+constexpr size_t kProfileTopFunctions = 5;
+
+bool writeTextFile(const std::string& path, const std::string& text, std::string& error_message) {
+    std::ofstream out(path, std::ios::trunc);
+    out << text;
+    if (!out) {
+        error_message = "Failed to write " + path;
+        return false;
+    }
+    return true;
+}
 } // namespace
 
 BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config, const VideoInfo& video_info)
-    : config_(config), video_info_(video_info) {
+    : config_(config), video_info_(video_info)
+    , cpu_latency_us_(config.cpu_latency_us.value_or(-1)) {
+}
+
+int BenchmarkRunner::getDefaultMaxStreams(bool substream_mode, unsigned int thread_count) {
+    return substream_mode ? kSubstreamDefaultMaxStreams : static_cast<int>(thread_count);
 }
 
-std::vector<int> BenchmarkRunner::getStreamCountsToTest(int max_streams) const {
+std::vector<int> BenchmarkRunner::getStreamCountsToTest(int max_streams, bool substream_mode) {
     std::vector<int> counts;
 
+    // Substream mode: keep doubling, binary search refines the last step
+    if (substream_mode) {
+        for (int n = 1; n < max_streams; n *= 2) {
+            counts.push_back(n);
+        }
+        counts.push_back(max_streams);
+        return counts;
+    }
+
     // Start with powers of 2 up to kPowerOfTwoMaxStreams
     for (int n = 1; n <= kPowerOfTwoMaxStreams && n <= max_streams; n *= 2) {
         counts.push_back(n);
@@ -74,6 +132,30 @@ BenchmarkRunner::SingleTestResult BenchmarkRunner::runSingleTest(int stream_coun
     auto cpu_monitor = CpuMonitor::create();
     auto memory_monitor = MemoryMonitor::create();
 
+    // Live ingest: attribute IRQ/softirq time to the network stack
+    std::unique_ptr<NetworkMonitor> network_monitor;
+    if (video_info_.is_live_stream) {
+        network_monitor = NetworkMonitor::create();
+        if (!network_monitor->isSupported()) {
+            network_monitor.reset();
+        }
+    }
+
+    // Wakeup latency bound for the whole test, from before the threads start
+    CpuLatencyRequest cpu_latency_request;
+    std::unique_ptr<PowerMonitor> power_monitor;
+    if (config_.cpu_latency_us) {
+        if (cpu_latency_us_ >= 0 &&
+            !cpu_latency_request.acquire(cpu_latency_us_, single_result.error_message)) {
+            single_result.has_error = true;
+            return single_result;
+        }
+        power_monitor = PowerMonitor::create();
+    }
+
+    // Idle footprint, for per-stream harness memory in substream mode
+    size_t baseline_memory_mb = memory_monitor->getProcessMemoryMB();
+
     // Calculate decoder thread count based on CPU cores and stream count
     // For high stream counts (>=4), use single-threaded decoding to avoid
     // thread oversubscription (N OS threads + N*M FFmpeg threads competing)
@@ -81,7 +163,7 @@ BenchmarkRunner::SingleTestResult BenchmarkRunner::runSingleTest(int stream_coun
     if (cpu_cores == 0) cpu_cores = 4;  // fallback
 
     int decoder_threads;
-    if (stream_count >= kMultiThreadStreamThreshold) {
+    if (stream_count >= kMultiThreadStreamThreshold || config_.substream_mode) {
         // High stream count: single-threaded FFmpeg to prevent oversubscription
         decoder_threads = 1;
     } else {
@@ -89,34 +171,292 @@ BenchmarkRunner::SingleTestResult BenchmarkRunner::runSingleTest(int stream_coun
         decoder_threads = std::max(1, static_cast<int>(cpu_cores) / stream_count);
     }
 
+    // Segment server requests are counted from before the readers open
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    SegmentServerCounters segment_start;
+    if (segment_server_) {
+        segment_start = segment_server_->getCounters(segment_variant_);
+    }
+#endif
+
     // Create decoder threads
     std::vector<std::unique_ptr<DecoderThread>> threads;
     threads.reserve(stream_count);
 
     bool is_live = video_info_.is_live_stream;
 
+    // Optional per-stream stages
+    DecoderThreadOptions options;
+    std::unique_ptr<SnapshotWorkerPool> snapshot_pool;
+    if (config_.snapshot_interval) {
+        options.snapshot_interval = *config_.snapshot_interval;
+        options.snapshot_width = config_.snapshot_width;
+        if (config_.snapshot_workers > 0) {
+            snapshot_pool = std::make_unique<SnapshotWorkerPool>(
+                config_.snapshot_workers, config_.snapshot_width);
+            options.snapshot_pool = snapshot_pool.get();
+        }
+    }
+    if (config_.motion_fps) {
+        options.motion_fps = *config_.motion_fps;
+        options.motion_downsample = config_.motion_downsample;
+    }
+    if (config_.verify_output) {
+        options.reference_hashes = &reference_hashes_;
+    }
+    if (config_.reverse) {
+        options.reverse_keyframes = &reverse_keyframes_;
+        options.reverse_cache_frames = config_.reverse_cache;
+        options.reverse_width = config_.reverse_width;
+    }
+    std::unique_ptr<InferenceBatcher> batcher;
+    if (config_.infer_batch) {
+        batcher = std::make_unique<InferenceBatcher>(
+            *config_.infer_batch, config_.infer_input, config_.infer_deadline_ms);
+        options.batcher = batcher.get();
+        options.infer_fps = config_.infer_fps;
+    }
+    if (config_.substream_mode) {
+        options.queue_size = kSubstreamQueueSize;
+    }
+    options.rtsp_transport = config_.rtsp_transport;
+    options.reader_sched = config_.reader_sched;
+    options.playback_speed = playback_speed_;
+    options.intra_only = video_info_.intra_only;
+    options.temporal_layer = temporal_layer_;
+
+    // Background streams come last; at least one stream stays foreground
+    const int background_streams = std::min(config_.background_streams, stream_count - 1);
+    const int foreground_streams = stream_count - background_streams;
+
+    // Frames count toward the result only if completed inside this window
+    MeasurementWindow window;
+    options.window = &window;
+
+    // Shared video wall canvas, one tile per stream
+    std::unique_ptr<MosaicCompositor> mosaic;
+    if (!config_.mosaic_canvases.empty()) {
+        const auto [canvas_width, canvas_height] = config_.mosaic_canvases[mosaic_canvas_];
+        mosaic = std::make_unique<MosaicCompositor>(
+            stream_count, canvas_width, canvas_height, config_.mosaic_fps, target_fps, &window);
+        options.mosaic = mosaic.get();
+    }
+
+    // Per-stream GOP rings for channel switch simulation
+    std::vector<std::unique_ptr<GopCache>> gop_caches;
+    if (config_.switch_interval) {
+        gop_caches.reserve(stream_count);
+        for (int i = 0; i < stream_count; i++) {
+            gop_caches.push_back(std::make_unique<GopCache>());
+        }
+    }
+
+    // Per-stream segment recorders fed by the readers
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+    std::vector<std::unique_ptr<SegmentRecorder>> recorders;
+    if (config_.record_dir) {
+        SegmentRecorderOptions record_options;
+        record_options.directory = *config_.record_dir;
+        record_options.format = config_.record_format;
+        record_options.segment_seconds = config_.record_segment;
+        record_options.fsync = parseFsyncPolicy(config_.record_fsync).value_or(FsyncPolicy::Segment);
+        record_options.direct_io = config_.record_direct;
+        record_options.window = &window;
+        recorders.reserve(stream_count);
+        for (int i = 0; i < stream_count; i++) {
+            recorders.push_back(std::make_unique<SegmentRecorder>(record_options, i));
+        }
+    }
+#endif
+
+    // Substream mode on a file: one reader demuxes for a group of streams and
+    // fans refcounted packets out to small per-stream queues
+    std::vector<std::unique_ptr<PacketQueue>> shared_queues;
+    std::vector<std::unique_ptr<PacketReader>> shared_readers;
+    if (config_.substream_mode && !is_live) {
+        shared_queues.reserve(stream_count);
+        for (int i = 0; i < stream_count; i++) {
+            shared_queues.push_back(std::make_unique<PacketQueue>(kSubstreamQueueSize));
+        }
+
+        for (int first = 0; first < stream_count; first += kStreamsPerSharedReader) {
+            int last = std::min(first + kStreamsPerSharedReader, stream_count);
+            auto reader = std::make_unique<PacketReader>(
+                config_.video_path, *shared_queues[first], stop_flag, is_live);
+            if (!reader->init(single_result.error_message)) {
+                single_result.has_error = true;
+                return single_result;
+            }
+            for (int i = first + 1; i < last; i++) {
+                reader->addQueue(*shared_queues[i]);
+            }
+            for (int i = first; i < last && !gop_caches.empty(); i++) {
+                gop_caches[i]->setCodecParameters(reader->getCodecParameters());
+                reader->addObserver(gop_caches[i].get());
+            }
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+            for (int i = first; i < last && !recorders.empty(); i++) {
+                if (!recorders[i]->onStreamStart(reader->getCodecParameters(), reader->getTimeBase(),
+                                                 single_result.error_message)) {
+                    single_result.has_error = true;
+                    return single_result;
+                }
+                reader->addObserver(recorders[i].get());
+            }
+#endif
+            shared_readers.push_back(std::move(reader));
+        }
+    }
+
+    // Batched UDP ingest: one receiver sets up every RTSP session and
+    // delivers access units straight into per-stream queues
+    const AVCodecParameters* ingest_params = nullptr;
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    std::unique_ptr<BatchedRtpReceiver> batched_receiver;
+    if (config_.batched_udp) {
+        std::vector<PacketQueue*> queues;
+        shared_queues.reserve(stream_count);
+        for (int i = 0; i < stream_count; i++) {
+            shared_queues.push_back(std::make_unique<PacketQueue>(options.queue_size));
+            queues.push_back(shared_queues.back().get());
+        }
+        batched_receiver = std::make_unique<BatchedRtpReceiver>(
+            config_.video_path, *config_.batched_udp, stop_flag, &window);
+        if (!batched_receiver->open(queues, single_result.error_message)) {
+            single_result.has_error = true;
+            return single_result;
+        }
+        ingest_params = batched_receiver->getCodecParameters();
+        // No reader to tap: the receiver feeds the GOP rings itself
+        for (int i = 0; i < stream_count && !gop_caches.empty(); i++) {
+            gop_caches[i]->setCodecParameters(ingest_params);
+            batched_receiver->addObserver(i, gop_caches[i].get());
+        }
+    }
+#endif
+
     for (int i = 0; i < stream_count; i++) {
+        if (!gop_caches.empty()) {
+            options.gop_cache = gop_caches[i].get();
+        }
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+        if (!recorders.empty()) {
+            options.recorder = recorders[i].get();
+        }
+#endif
+        if (!shared_readers.empty()) {
+            const PacketReader& reader = *shared_readers[i / kStreamsPerSharedReader];
+            options.packet_queue = shared_queues[i].get();
+            options.codec_params = reader.getCodecParameters();
+        } else if (ingest_params) {
+            options.packet_queue = shared_queues[i].get();
+            options.codec_params = ingest_params;
+        }
+        options.sched = i < foreground_streams ? config_.decoder_sched : config_.background_sched;
         threads.push_back(std::make_unique<DecoderThread>(
             i, config_.video_path, target_fps, decoder_threads, is_live,
-            start_barrier, stop_flag));
+            start_barrier, stop_flag, options));
+    }
+
+    std::unique_ptr<ChannelSwitchSimulator> switch_simulator;
+    if (config_.switch_interval) {
+        std::vector<GopCache*> caches;
+        for (const auto& cache : gop_caches) {
+            caches.push_back(cache.get());
+        }
+        switch_simulator = std::make_unique<ChannelSwitchSimulator>(
+            std::move(caches), *config_.switch_interval);
     }
 
     // Wait for all threads to complete setup and be ready
     start_barrier.arrive_and_wait();
 
+    std::vector<std::thread> shared_reader_threads;
+    shared_reader_threads.reserve(shared_readers.size());
+    for (const auto& reader : shared_readers) {
+        shared_reader_threads.emplace_back([&reader, this] {
+            std::string sched_error;
+            applySchedPolicy(config_.reader_sched, sched_error);
+            reader->run();
+        });
+    }
+
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (batched_receiver) {
+        std::string receiver_error;
+        if (!batched_receiver->start(receiver_error)) {
+            single_result.has_error = true;
+            single_result.error_message = receiver_error;
+        }
+    }
+#endif
+
+    if (switch_simulator) {
+        switch_simulator->start();
+    }
+
+    if (mosaic && !single_result.has_error &&
+        !mosaic->start(single_result.error_message)) {
+        single_result.has_error = true;
+    }
+
     // Start CPU monitoring after threads begin decoding
+    double loopback_start_ms = loopbackCpuMs();
     cpu_monitor->startMeasurement();
+    if (network_monitor) {
+        network_monitor->startMeasurement();
+    }
+    if (power_monitor) {
+        power_monitor->startMeasurement();
+    }
+#ifdef VIDEO_BENCH_SAMPLING_PROFILER
+    // Sample only while the window is open; warm-up and drain are excluded
+    std::unique_ptr<SamplingProfiler> profiler;
+    std::string profiler_error;
+    if (config_.profile_dir) {
+        profiler = std::make_unique<SamplingProfiler>(config_.profile_hz);
+        if (!profiler->start(profiler_error)) {
+            profiler.reset();
+        }
+    }
+#endif
+
     auto start_time = std::chrono::steady_clock::now();
+    window.open();
 
     // Wait for measurement duration
     std::this_thread::sleep_for(
         std::chrono::duration<double>(config_.measurement_duration));
 
-    // Signal threads to stop
+    // Close the window before signaling, so frames drained after the stop
+    // signal never count
+    window.close();
+#ifdef VIDEO_BENCH_SAMPLING_PROFILER
+    if (profiler) {
+        profiler->stop();
+    }
+#endif
     stop_flag.store(true, std::memory_order_release);
 
+    if (switch_simulator) {
+        switch_simulator->stop();
+    }
+    if (mosaic) {
+        mosaic->stop();
+    }
+
     // Get CPU and memory usage before threads finish
     double cpu_usage = cpu_monitor->getCpuUsage();
+    double loopback_cpu_ms = loopbackCpuMs() - loopback_start_ms;
+    std::optional<NetworkUsage> network_usage;
+    if (network_monitor) {
+        network_usage = network_monitor->getUsage();
+    }
+    std::optional<PowerUsage> power_usage;
+    if (power_monitor) {
+        power_usage = power_monitor->getUsage();
+    }
+    cpu_latency_request.release();
     size_t memory_mb = memory_monitor->getProcessMemoryMB();
 
     auto end_time = std::chrono::steady_clock::now();
@@ -129,9 +469,25 @@ BenchmarkRunner::SingleTestResult BenchmarkRunner::runSingleTest(int stream_coun
     }
 
     // Collect frame counts after threads have joined
+    // total_frames uses the window; legacy_frames is every frame decoded
     int64_t total_frames = 0;
+    int64_t legacy_frames = 0;
     std::vector<int64_t> per_stream_frames;
     per_stream_frames.reserve(stream_count);
+    SnapshotCounters snapshots;
+    MotionCounters motion;
+    HashCheckCounters hash_check;
+    std::vector<int64_t> per_stream_mismatches;
+    std::vector<int64_t> per_stream_first_mismatch;
+    double reader_cpu_ms = 0.0;
+    int64_t reader_bytes = 0;
+    LagStats lag;
+    LagCounters lag_causes;
+    LatencyHistogram lateness;
+    int64_t displayed_frames = 0;
+    ReverseCounters reverse_counters;
+    LayerFilterCounters layer_counters;
+    lag.run_delay_available = true;
 
     for (const auto& thread : threads) {
         auto thread_result = thread->getResult();
@@ -142,15 +498,468 @@ BenchmarkRunner::SingleTestResult BenchmarkRunner::runSingleTest(int stream_coun
                                             + ": " + thread_result.error_message;
             }
         }
-        total_frames += thread_result.frames_decoded;
-        per_stream_frames.push_back(thread_result.frames_decoded);
+        // Playback and layer pruning pass on media played; shown frames are
+        // reported apart
+        const int64_t window_frames = playback_speed_ > 0 || temporal_layer_ >= 0
+            ? thread_result.window_media_frames : thread_result.window_frames;
+        total_frames += window_frames;
+        legacy_frames += thread_result.frames_decoded;
+        per_stream_frames.push_back(window_frames);
+        displayed_frames += thread_result.window_frames;
+        snapshots.merge(thread_result.snapshots);
+        motion.merge(thread_result.motion);
+        hash_check.merge(thread_result.hash_check);
+        reader_cpu_ms += thread_result.reader_cpu_ms;
+        reader_bytes += thread_result.reader_bytes;
+        lag.late_frames += thread_result.lag_count;
+        lag.max_lag_ms = std::max(lag.max_lag_ms, thread_result.max_lag_ms);
+        lag_causes.merge(thread_result.lag_causes);
+        reverse_counters.merge(thread_result.reverse);
+        layer_counters.merge(thread_result.layer_filter);
+        lag.run_delay_available = lag.run_delay_available && thread_result.run_delay_available;
+        if (thread_result.thread_id < foreground_streams) {
+            lateness.merge(thread_result.lateness);
+        }
+        per_stream_mismatches.push_back(thread_result.hash_check.mismatches);
+        per_stream_first_mismatch.push_back(thread_result.hash_check.mismatch_frames.empty()
+                                            ? -1 : thread_result.hash_check.mismatch_frames.front());
     }
 
     // Clear threads (already joined)
     threads.clear();
 
+    // Shared readers exit on the stop flag; report the first reader error
+    for (auto& reader_thread : shared_reader_threads) {
+        reader_thread.join();
+    }
+    for (const auto& reader : shared_readers) {
+        if (reader->hasError() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = reader->getError();
+        }
+    }
+
+    // Every reader has stopped: finish the open segments
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+    RecorderCounters record_counters;
+    for (const auto& recorder : recorders) {
+        recorder->close();
+        record_counters.merge(recorder->getCounters());
+        if (!recorder->getError().empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = recorder->getError();
+        }
+    }
+#endif
+
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (batched_receiver) {
+        batched_receiver->stop();
+    }
+    if (stand_in_) {
+        std::string stand_in_error = stand_in_->getError();
+        if (!stand_in_error.empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = stand_in_error;
+        }
+    }
+    SegmentServerCounters segment_counters;
+    if (segment_server_) {
+        SegmentServerCounters end = segment_server_->getCounters(segment_variant_);
+        segment_counters.segments = end.segments - segment_start.segments;
+        segment_counters.manifests = end.manifests - segment_start.manifests;
+        std::string server_error = segment_server_->getError();
+        if (!server_error.empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = server_error;
+        }
+    }
+#endif
+
+    // Loopback servers run in this process; keep their CPU out of the measurement
+    double loopback_cpu_usage = 0.0;
+    if (elapsed > 0) {
+        loopback_cpu_usage = loopback_cpu_ms / (elapsed * 1000.0) * 100.0 / cpu_cores;
+        cpu_usage = std::max(0.0, cpu_usage - loopback_cpu_usage);
+    }
+
+    // Drain pending snapshots; encode errors in the pool fail the test
+    if (snapshot_pool) {
+        snapshot_pool->stop();
+        snapshots.merge(snapshot_pool->getCounters());
+        std::string pool_error = snapshot_pool->getError();
+        if (!pool_error.empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = pool_error;
+        }
+    }
+
+    // Flush the open batch; conversion errors fail the test
+    BatcherCounters batch_counters;
+    if (batcher) {
+        batcher->stop();
+        batch_counters = batcher->getCounters();
+        std::string batcher_error = batcher->getError();
+        if (!batcher_error.empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = batcher_error;
+        }
+    }
+
+#ifdef VIDEO_BENCH_SAMPLING_PROFILER
+    if (!profiler_error.empty() && !single_result.has_error) {
+        single_result.has_error = true;
+        single_result.error_message = profiler_error;
+    }
+    if (profiler) {
+        ProfileReport report = profiler->report();
+        ProfileStats stats;
+        stats.samples = report.samples;
+        stats.dropped = report.dropped;
+        stats.threads = report.threads;
+        for (size_t i = 0; i < report.flat.size() && i < kProfileTopFunctions; i++) {
+            stats.top_symbols.push_back(report.flat[i].symbol);
+            stats.top_self_pct.push_back(report.samples > 0
+                ? 100.0 * report.flat[i].self_samples / report.samples : 0.0);
+        }
+
+        // Step number keeps repeated stream counts (bisection, TLS and
+        // segment ladders) apart
+        char name[64];
+        std::snprintf(name, sizeof(name), "step%03d-%dstreams", ++profile_step_, stream_count);
+        auto base = std::filesystem::path(*config_.profile_dir) / name;
+        stats.flat_path = base.string() + ".txt";
+        stats.folded_path = base.string() + ".folded";
+        std::string write_error;
+        if ((!writeTextFile(stats.flat_path, report.formatFlat(), write_error) ||
+             !writeTextFile(stats.folded_path, report.formatFolded(), write_error)) &&
+            !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = "Profiler: " + write_error;
+        }
+        single_result.result.profile = stats;
+    }
+#endif
+
+    const int speed = std::max(1, playback_speed_);
     calculateTestResult(single_result, per_stream_frames, total_frames,
-                        elapsed, cpu_usage, memory_mb, stream_count, target_fps);
+                        window.seconds(), cpu_usage, memory_mb, stream_count,
+                        foreground_streams, target_fps * speed);
+
+    // Previous method, for comparison: all frames over main-thread elapsed time
+    single_result.result.window_seconds = window.seconds();
+    if (elapsed > 0) {
+        single_result.result.legacy_fps_per_stream =
+            static_cast<double>(legacy_frames) / elapsed / stream_count;
+    }
+
+    lag.slow_decode = lag_causes.slow_decode;
+    lag.slow_decode_key = lag_causes.slow_decode_key;
+    lag.slow_decode_delta = lag_causes.slow_decode_delta;
+    lag.stage_work = lag_causes.stage_work;
+    lag.reader_starved = lag_causes.reader_starved;
+    lag.scheduler_delay = lag_causes.scheduler_delay;
+    lag.oversleep = lag_causes.oversleep;
+    lag.lateness = lateness.summarize();
+    single_result.result.lag = lag;
+
+    if (config_.snapshot_interval) {
+        SnapshotStats stats;
+        stats.taken = snapshots.taken;
+        stats.dropped = snapshots.dropped;
+        stats.avg_bytes = snapshots.taken > 0 ? snapshots.bytes / snapshots.taken : 0;
+        stats.latency = snapshots.latency.summarize();
+        single_result.result.snapshot = stats;
+    }
+
+    if (config_.motion_fps) {
+        MotionStats stats;
+        stats.frames_analyzed = motion.frames_analyzed;
+        stats.motion_frames = motion.motion_frames;
+        stats.cost = motion.cost.summarize();
+        stats.kernel = getSadRowKernelName();
+        single_result.result.motion = stats;
+    }
+
+    if (config_.verify_output) {
+        HashCheckStats stats;
+        stats.frames_checked = hash_check.frames_checked;
+        stats.mismatches = hash_check.mismatches;
+        stats.unchecked = hash_check.unchecked;
+        stats.per_stream_mismatches = std::move(per_stream_mismatches);
+        stats.per_stream_first_mismatch = std::move(per_stream_first_mismatch);
+        stats.cost = hash_check.cost.summarize();
+        stats.kernel = getHashStripesKernelName();
+        single_result.result.hash_check = stats;
+
+        // Bit-exactness is a hard requirement, not just a throughput metric
+        if (stats.mismatches > 0) {
+            single_result.result.passed = false;
+        }
+    }
+
+    if (config_.infer_batch) {
+        BatchStats stats;
+        stats.batch_size = *config_.infer_batch;
+        stats.frames_batched = batch_counters.frames_batched;
+        stats.frames_dropped = batch_counters.frames_dropped;
+        stats.full_batches = batch_counters.full_batches;
+        stats.deadline_batches = batch_counters.deadline_batches;
+        if (elapsed > 0) {
+            stats.batches_per_sec = (stats.full_batches + stats.deadline_batches) / elapsed;
+        }
+        stats.assembly = batch_counters.assembly.summarize();
+        stats.convert = batch_counters.convert.summarize();
+        stats.kernel = getYuvRowToRgbKernelName();
+        single_result.result.batch = stats;
+    }
+
+    if (network_usage) {
+        const NetworkUsage& usage = *network_usage;
+        double net_seconds = usage.irq_seconds + usage.softirq_seconds;
+        double rx_mbit = static_cast<double>(usage.rx_bytes) * 8.0 / 1e6;
+
+        NetworkStats stats;
+        stats.cpu_usage = usage.cpu_usage;
+        stats.decode_cpu_usage = std::max(0.0, cpu_usage - usage.cpu_usage);
+        if (usage.elapsed_seconds > 0) {
+            stats.rx_mbps = rx_mbit / usage.elapsed_seconds;
+            stats.core_pct_per_stream = 100.0 * net_seconds / usage.elapsed_seconds
+                                        / stream_count;
+        }
+        if (rx_mbit > 0) {
+            stats.cpu_ms_per_mbit = net_seconds * 1000.0 / rx_mbit;
+        }
+        stats.net_rx_softirqs = static_cast<int64_t>(usage.net_rx_softirqs);
+        stats.nic_interrupts = static_cast<int64_t>(usage.nic_interrupts);
+        stats.udp_in_datagrams = static_cast<int64_t>(usage.udp_in_datagrams);
+        stats.udp_rcvbuf_errors = static_cast<int64_t>(usage.udp_rcvbuf_errors);
+        stats.tcp_in_segs = static_cast<int64_t>(usage.tcp_in_segs);
+        single_result.result.network = stats;
+    }
+
+    if (power_usage) {
+        PowerStats stats;
+        stats.cpu_latency_us = cpu_latency_us_;
+        stats.has_energy = power_usage->has_energy;
+        stats.package_watts = power_usage->package_watts;
+        for (const CStateResidency& state : power_usage->cstates) {
+            stats.cstate_names.push_back(state.name);
+            stats.cstate_latency_us.push_back(state.exit_latency_us);
+            stats.cstate_residency_pct.push_back(state.residency_pct);
+            if (power_usage->cores > 0) {
+                stats.idle_entries_per_sec += state.entries_per_sec / power_usage->cores;
+            }
+        }
+        single_result.result.power = stats;
+    }
+
+    if (is_live) {
+        IngestStats stats;
+        stats.stand_in_cpu_usage = loopback_cpu_usage;
+        stats.core_pct_per_stream = cpu_usage * cpu_cores / stream_count;
+        if (config_.batched_udp) {
+            stats.path = "recvmmsg";
+            stats.receiver_threads = *config_.batched_udp;
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+            RtpReceiveCounters counters = batched_receiver->getCounters();
+            if (window.seconds() > 0) {
+                stats.recv_syscalls_per_sec = counters.window_recv_calls / window.seconds();
+                stats.datagrams_per_sec = counters.window_datagrams / window.seconds();
+            }
+            stats.lost_packets = counters.lost_packets;
+            stats.dropped_units = counters.dropped_units;
+#endif
+        } else {
+            bool tls = config_.video_path.rfind("rtsps://", 0) == 0;
+            stats.path = tls ? "ffmpeg-tls" : "ffmpeg-" + config_.rtsp_transport;
+            double reader_mbit = static_cast<double>(reader_bytes) * 8.0 / 1e6;
+            if (reader_mbit > 0) {
+                stats.reader_cpu_ms_per_mbit = reader_cpu_ms / reader_mbit;
+            }
+            // FFmpeg's UDP input does one recvfrom() per datagram
+            if (network_usage && network_usage->elapsed_seconds > 0) {
+                stats.datagrams_per_sec = network_usage->udp_in_datagrams
+                                          / network_usage->elapsed_seconds;
+                if (config_.rtsp_transport == "udp") {
+                    stats.recv_syscalls_per_sec = stats.datagrams_per_sec;
+                }
+            }
+        }
+        single_result.result.ingest = stats;
+    }
+
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (segment_server_) {
+        SegmentStats stats;
+        stats.format = config_.segment_format;
+        stats.segment_duration = segment_server_->getSegmentDuration(segment_variant_);
+        stats.segments_fetched = segment_counters.segments;
+        stats.manifest_fetches = segment_counters.manifests;
+        if (segment_counters.segments > 0) {
+            stats.reader_cpu_ms_per_segment = reader_cpu_ms / segment_counters.segments;
+        }
+        stats.server_cpu_usage = loopback_cpu_usage;
+        single_result.result.segment = stats;
+    }
+#endif
+
+    if (!config_.decoder_sched.isDefault() || !config_.reader_sched.isDefault() ||
+        background_streams > 0 || !config_.sched_compare.empty()) {
+        SchedStats stats;
+        stats.decoder = config_.decoder_sched.toString();
+        stats.reader = config_.reader_sched.toString();
+        stats.background = config_.background_sched.toString();
+        stats.background_streams = background_streams;
+        if (background_streams > 0) {
+            const auto& fps = single_result.result.per_stream_fps;
+            auto first = fps.begin() + foreground_streams;
+            double sum = 0.0;
+            for (auto it = first; it != fps.end(); ++it) {
+                sum += *it;
+            }
+            stats.background_avg_fps = sum / background_streams;
+            stats.background_min_fps = *std::min_element(first, fps.end());
+        }
+        single_result.result.sched = stats;
+    }
+
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+    if (!recorders.empty()) {
+        RecordStats stats;
+        stats.format = config_.record_format;
+        stats.segment_seconds = config_.record_segment;
+        stats.fsync = config_.record_fsync;
+        stats.direct_io = config_.record_direct;
+        stats.bytes_written = record_counters.bytes_written;
+        stats.segments = record_counters.segments;
+        // Warm-up and the drain after the stop signal are left out
+        if (window.seconds() > 0) {
+            stats.write_mb_per_sec = static_cast<double>(record_counters.window_bytes_written) /
+                                     (1024.0 * 1024.0) / window.seconds();
+        }
+        stats.fsync_latency = record_counters.fsync.summarize();
+        single_result.result.record = stats;
+    }
+#endif
+
+    if (playback_speed_ > 0) {
+        PlaybackStats stats;
+        stats.speed = playback_speed_;
+        stats.strategy = playbackStrategyName(
+            playbackStrategyFor(playback_speed_, video_info_.intra_only));
+        if (window.seconds() > 0) {
+            stats.displayed_fps = static_cast<double>(displayed_frames) / window.seconds()
+                                  / stream_count;
+        }
+        if (total_frames > 0) {
+            stats.skipped_pct = std::max(0.0, 100.0 * (1.0 - static_cast<double>(displayed_frames)
+                                                             / total_frames));
+        }
+        single_result.result.playback = stats;
+    }
+
+    if (temporal_layer_ >= 0) {
+        LayerStats stats;
+        stats.max_layer = temporal_layer_;
+        stats.highest_layer = layer_counters.highest_layer;
+        if (window.seconds() > 0) {
+            stats.decoded_fps = static_cast<double>(displayed_frames) / window.seconds()
+                                / stream_count;
+        }
+        if (layer_counters.packets > 0) {
+            stats.dropped_pct = 100.0 * layer_counters.dropped / layer_counters.packets;
+            stats.parse_ns_per_packet = static_cast<double>(layer_counters.parse_ns)
+                                        / layer_counters.packets;
+        }
+        if (elapsed > 0) {
+            stats.parse_us_per_sec = layer_counters.parse_ns / 1e3 / elapsed / stream_count;
+        }
+        single_result.result.layers = stats;
+    }
+
+    if (config_.reverse) {
+        ReverseStats stats;
+        stats.cache_frames = config_.reverse_cache;
+        stats.cache_width = config_.reverse_width;
+        stats.cache_mb_per_session = static_cast<double>(reverse_counters.peak_cache_bytes)
+                                     / (1024.0 * 1024.0) / stream_count;
+        size_t grown_mb = memory_mb > baseline_memory_mb ? memory_mb - baseline_memory_mb : 0;
+        stats.rss_mb_per_session = static_cast<double>(grown_mb) / stream_count;
+        if (reverse_counters.frames_shown > 0) {
+            stats.decode_ratio = static_cast<double>(reverse_counters.frames_decoded)
+                                 / reverse_counters.frames_shown;
+        }
+        if (elapsed > 0) {
+            stats.chunks_per_sec = reverse_counters.chunks / elapsed / stream_count;
+        }
+        single_result.result.reverse = stats;
+    }
+
+    if (mosaic) {
+        MosaicCounters counters = mosaic->getCounters();
+        const auto [canvas_width, canvas_height] = config_.mosaic_canvases[mosaic_canvas_];
+        MosaicStats stats;
+        stats.canvas = std::to_string(canvas_width) + "x" + std::to_string(canvas_height);
+        stats.layout = std::to_string(mosaic->getColumns()) + "x" +
+                       std::to_string(mosaic->getColumns());
+        stats.tile_width = mosaic->getTileWidth();
+        stats.tile_height = mosaic->getTileHeight();
+        stats.fps = config_.mosaic_fps;
+        stats.composites = counters.composites;
+        stats.slots = counters.slots;
+        stats.deadline_misses = counters.deadline_misses;
+        if (counters.composites > 0) {
+            stats.stale_tile_pct = 100.0 * counters.stale_tiles
+                                   / (static_cast<double>(counters.composites) * stream_count);
+        }
+        stats.compose = counters.compose.summarize();
+        stats.tile_scale = counters.tile_scale.summarize();
+
+        // A wall drops a composite now and then; more than 1% is visible
+        stats.deadline_passed = counters.slots > 0 &&
+                                counters.deadline_misses * 100 <= counters.slots;
+        if (!stats.deadline_passed) {
+            single_result.result.passed = false;
+        }
+        single_result.result.mosaic = stats;
+    }
+
+    if (config_.substream_mode) {
+        HarnessStats stats;
+        size_t grown_mb = memory_mb > baseline_memory_mb ? memory_mb - baseline_memory_mb : 0;
+        stats.kb_per_stream = static_cast<double>(grown_mb) * 1024.0 / stream_count;
+        stats.readers = shared_readers.empty()
+            ? stream_count : static_cast<int>(shared_readers.size());
+        stats.queue_size = static_cast<int>(kSubstreamQueueSize);
+        stats.fd_limit = fd_limit_;
+        single_result.result.harness = stats;
+    }
+
+    if (switch_simulator) {
+        SwitchCounters counters = switch_simulator->getCounters();
+        std::string switch_error = switch_simulator->getError();
+        if (!switch_error.empty() && !single_result.has_error) {
+            single_result.has_error = true;
+            single_result.error_message = switch_error;
+        }
+
+        size_t ring_bytes_total = 0;
+        for (const auto& cache : gop_caches) {
+            ring_bytes_total += cache->getPeakBytes();
+        }
+
+        SwitchStats stats;
+        stats.switches = counters.switches;
+        stats.latency = counters.latency.summarize();
+        if (counters.switches > 0) {
+            stats.avg_cpu_ms = counters.cpu_ms / counters.switches;
+            stats.avg_frames = static_cast<double>(counters.frames_decoded) / counters.switches;
+        }
+        stats.ring_kb_total = ring_bytes_total / 1024;
+        stats.ring_kb_per_stream = stats.ring_kb_total / stream_count;
+        single_result.result.channel_switch = stats;
+    }
 
     return single_result;
 }
@@ -159,7 +968,8 @@ void BenchmarkRunner::calculateTestResult(SingleTestResult& single_result,
                                            const std::vector<int64_t>& per_stream_frames,
                                            int64_t total_frames, double elapsed,
                                            double cpu_usage, size_t memory_mb,
-                                           int stream_count, double target_fps) {
+                                           int stream_count, int foreground_streams,
+                                           double target_fps) {
     // Calculate per-stream FPS from frame counts and elapsed time
     std::vector<double> per_stream_fps;
     per_stream_fps.reserve(stream_count);
@@ -175,11 +985,11 @@ void BenchmarkRunner::calculateTestResult(SingleTestResult& single_result,
     test_result.per_stream_fps = std::move(per_stream_fps);
     test_result.per_stream_frames = std::move(per_stream_frames);
 
-    // Calculate min/max FPS from per-stream data
-    test_result.min_fps = *std::min_element(test_result.per_stream_fps.begin(),
-                                             test_result.per_stream_fps.end());
-    test_result.max_fps = *std::max_element(test_result.per_stream_fps.begin(),
-                                             test_result.per_stream_fps.end());
+    // Calculate min/max FPS from per-stream data (background streams are
+    // last and do not count toward pass/fail)
+    auto foreground_end = test_result.per_stream_fps.begin() + foreground_streams;
+    test_result.min_fps = *std::min_element(test_result.per_stream_fps.begin(), foreground_end);
+    test_result.max_fps = *std::max_element(test_result.per_stream_fps.begin(), foreground_end);
 
     if (elapsed > 0 && stream_count > 0) {
         double total_fps = static_cast<double>(total_frames) / elapsed;
@@ -194,6 +1004,152 @@ void BenchmarkRunner::calculateTestResult(SingleTestResult& single_result,
     test_result.passed = test_result.fps_passed && test_result.cpu_passed;
 }
 
+std::string BenchmarkRunner::cacheKey(double target_fps) const {
+    // The stand-in and segment server URLs carry a fresh port every run,
+    // so the ingest path is keyed by protocol instead
+    std::string ingest = "file";
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (segment_server_) {
+        std::ostringstream duration;
+        duration << config_.segment_durations[segment_variant_];
+        ingest = config_.segment_format + " " + duration.str() + "s";
+    } else if (stand_in_) {
+        ingest = config_.video_path == stand_in_->getTlsUrl() ? "rtsps" : "rtsp";
+    }
+#endif
+
+    std::ostringstream out;
+    out << ResultCache::configFingerprint(config_, target_fps)
+        << "ingest=" << ingest << "\n"
+        << "playback_speed=" << playback_speed_ << "\n"
+        << "temporal_layer=" << temporal_layer_ << "\n"
+        << "cpu_latency_us=" << cpu_latency_us_ << "\n";
+    if (!config_.mosaic_canvases.empty()) {
+        const auto& [width, height] = config_.mosaic_canvases[mosaic_canvas_];
+        out << "mosaic_canvas=" << width << "x" << height << "\n";
+    } else {
+        out << "mosaic_canvas=none\n";
+    }
+    return out.str();
+}
+
+BenchmarkRunner::SingleTestResult BenchmarkRunner::measure(int stream_count, double target_fps,
+                                                           const ResultCache* cache) {
+    const std::string cache_key = cache ? cacheKey(target_fps) : std::string();
+    if (cache && !config_.force_remeasure) {
+        if (auto cached = cache->lookup(cache_key, stream_count)) {
+            SingleTestResult single_result;
+            single_result.has_error = false;
+            single_result.result = std::move(*cached);
+            single_result.result.from_cache = true;
+            return single_result;
+        }
+    }
+
+    SingleTestResult single_result = runSingleTest(stream_count, target_fps);
+
+    if (cache && !single_result.has_error) {
+        std::string cache_error;
+        if (!cache->store(cache_key, single_result.result, cache_error)) {
+            single_result.has_error = true;
+            single_result.error_message = cache_error;
+        }
+    }
+
+    return single_result;
+}
+
+bool BenchmarkRunner::prepare(std::string& error_message) {
+    // Thousands of streams need more descriptors than the default soft limit
+    // (live sources hold a socket per stream)
+    if (config_.substream_mode) {
+        fd_limit_ = SystemInfo::raiseFileDescriptorLimit();
+    }
+
+    // Reference hashes come from a single-threaded decode of one loop
+    if (config_.verify_output && !video_info_.is_live_stream) {
+        if (!FrameHasher::captureReference(config_.video_path, reference_hashes_,
+                                           error_message)) {
+            return false;
+        }
+    }
+
+    // Layers are read from packet headers; VP9 signals them only in RTP
+    if (!config_.temporal_layers.empty() && video_info_.codec_type != VideoCodec::H264 &&
+        video_info_.codec_type != VideoCodec::H265 && video_info_.codec_type != VideoCodec::AV1) {
+        error_message = "--temporal-layers: " + video_info_.codec_name +
+                        " has no temporal layer headers (H.264, HEVC and AV1 only)";
+        return false;
+    }
+
+    // One demux pass finds the keyframes every reverse session seeks to
+    if (config_.reverse &&
+        !ReversePlayer::indexKeyframes(config_.video_path, reverse_keyframes_, error_message)) {
+        return false;
+    }
+
+#ifdef VIDEO_BENCH_SEGMENT_RECORDER
+    if (config_.record_dir) {
+        std::error_code ec;
+        std::filesystem::create_directories(*config_.record_dir, ec);
+        if (ec) {
+            error_message = "Recorder: failed to create directory " +
+                            *config_.record_dir + ": " + ec.message();
+            return false;
+        }
+    }
+#endif
+
+#ifdef VIDEO_BENCH_SAMPLING_PROFILER
+    if (config_.profile_dir) {
+        std::error_code ec;
+        std::filesystem::create_directories(*config_.profile_dir, ec);
+        if (ec) {
+            error_message = "Profiler: failed to create directory " +
+                            *config_.profile_dir + ": " + ec.message();
+            return false;
+        }
+    }
+#endif
+
+    // Fail early if the PM QoS device cannot be written (root only)
+    if (config_.cpu_latency_us) {
+        CpuLatencyRequest probe;
+        if (!probe.acquire(*config_.cpu_latency_us, error_message)) {
+            return false;
+        }
+    }
+
+    // Fail early on policies that are not permitted (real-time policies and
+    // negative nice need CAP_SYS_NICE or a matching rlimit)
+    std::vector<SchedPolicy> policies = {config_.decoder_sched, config_.reader_sched};
+    if (config_.background_streams > 0) {
+        policies.push_back(config_.background_sched);
+    }
+    policies.insert(policies.end(), config_.sched_compare.begin(), config_.sched_compare.end());
+    for (const SchedPolicy& policy : policies) {
+        if (!checkSchedPolicy(policy, error_message)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double BenchmarkRunner::getTargetFps() const {
+    return config_.target_fps.value_or(video_info_.fps);
+}
+
+bool BenchmarkRunner::runStep(int stream_count, StreamTestResult& result,
+                              std::string& error_message) {
+    auto single_result = measure(stream_count, getTargetFps(), nullptr);
+    if (single_result.has_error) {
+        error_message = single_result.error_message;
+        return false;
+    }
+    result = single_result.result;
+    return true;
+}
+
 BenchmarkResult BenchmarkRunner::run(ProgressCallback progress_callback) {
     BenchmarkResult result;
     result.success = false;
@@ -213,24 +1169,313 @@ BenchmarkResult BenchmarkRunner::run(ProgressCallback progress_callback) {
     result.is_live_stream = video_info_.is_live_stream;
 
     // Determine target FPS
-    result.target_fps = config_.target_fps.value_or(video_info_.fps);
+    result.target_fps = getTargetFps();
 
     // Determine max streams to test
     int max_streams = config_.max_streams.value_or(
-        static_cast<int>(result.thread_count));
+        getDefaultMaxStreams(config_.substream_mode, result.thread_count));
+
+    if (!prepare(result.error_message)) {
+        return result;
+    }
 
     // Get stream counts to test
-    auto stream_counts = getStreamCountsToTest(max_streams);
+    auto stream_counts = getStreamCountsToTest(max_streams, config_.substream_mode);
+
+    // Optional result cache: skip points already measured with the same key
+    // Loopback servers are fed from the local file, which is what gets hashed
+    std::optional<ResultCache> cache;
+    if (config_.cache_dir) {
+        std::string source_path = config_.video_path;
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+        if (segment_server_) {
+            source_path = segment_server_->getFilePath();
+        } else if (stand_in_) {
+            source_path = stand_in_->getFilePath();
+        }
+#endif
+        cache.emplace();
+        if (!cache->init(*config_.cache_dir, source_path, result.error_message)) {
+            return result;
+        }
+    }
+    const ResultCache* cache_ptr = cache ? &*cache : nullptr;
+
+    if (!config_.sched_compare.empty()) {
+        config_.decoder_sched = config_.sched_compare.front();
+    }
 
     int last_passing = 0;
+    if (!runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                   result, last_passing)) {
+        return result;
+    }
+    result.max_streams = last_passing;
+    // Comparison ladders are appended after it; points of the base ladder stop here
+    const size_t base_tests = result.test_results.size();
+
+    // Same ladder again with every stream ingested over TLS from the stand-in
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (config_.tls && stand_in_) {
+        const size_t plain_tests = result.test_results.size();
+        const std::string plain_path = config_.video_path;
+        config_.video_path = stand_in_->getTlsUrl();
+        int tls_passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, tls_passing);
+        config_.video_path = plain_path;
+        if (!ok) {
+            return result;
+        }
+
+        // Reader cost per Mbit at 1 stream, free of decode contention
+        TlsComparison tls;
+        tls.cipher = stand_in_->getTlsCipher();
+        tls.plain_max_streams = last_passing;
+        tls.tls_max_streams = tls_passing;
+        tls.plain_reader_cpu_ms_per_mbit =
+            result.test_results.front().ingest->reader_cpu_ms_per_mbit;
+        tls.tls_reader_cpu_ms_per_mbit =
+            result.test_results[plain_tests].ingest->reader_cpu_ms_per_mbit;
+        tls.tls_cpu_ms_per_mbit = std::max(
+            0.0, tls.tls_reader_cpu_ms_per_mbit - tls.plain_reader_cpu_ms_per_mbit);
+        result.tls = tls;
+    }
+
+    // Same ladder again for every further segment duration
+    if (segment_server_ && segment_server_->getVariantCount() > 1) {
+        auto sweepPoint = [&](size_t first_test, int passing) {
+            SegmentSweepPoint point;
+            point.segment_duration = segment_server_->getSegmentDuration(segment_variant_);
+            point.max_streams = passing;
+            point.reader_cpu_ms_per_segment =
+                result.test_results[first_test].segment->reader_cpu_ms_per_segment;
+            return point;
+        };
+        result.segment_sweep.push_back(sweepPoint(0, last_passing));
+
+        const std::string first_path = config_.video_path;
+        for (size_t variant = 1; variant < segment_server_->getVariantCount(); variant++) {
+            const size_t first_test = result.test_results.size();
+            config_.video_path = segment_server_->getUrl(variant);
+            segment_variant_ = variant;
+            int passing = 0;
+            bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                                result, passing);
+            if (ok) {
+                result.segment_sweep.push_back(sweepPoint(first_test, passing));
+            }
+            config_.video_path = first_path;
+            segment_variant_ = 0;
+            if (!ok) {
+                return result;
+            }
+        }
+    }
+#endif
+
+    // Same ladder again without recording: the capacity recording costs
+    if (config_.record_dir) {
+        const auto record_dir = config_.record_dir;
+        config_.record_dir.reset();
+        int baseline_passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, baseline_passing);
+        config_.record_dir = record_dir;
+        if (!ok) {
+            return result;
+        }
+        RecordComparison recording;
+        recording.recording_max_streams = last_passing;
+        recording.baseline_max_streams = baseline_passing;
+        result.recording = recording;
+    }
+
+    // Same ladder again without snapshots: the capacity the stage costs
+    if (config_.snapshot_interval) {
+        const auto snapshot_interval = config_.snapshot_interval;
+        config_.snapshot_interval.reset();
+        int baseline_passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, baseline_passing);
+        config_.snapshot_interval = snapshot_interval;
+        if (!ok) {
+            return result;
+        }
+        SnapshotComparison snapshots;
+        snapshots.snapshot_max_streams = last_passing;
+        snapshots.baseline_max_streams = baseline_passing;
+        result.snapshots = snapshots;
+    }
+
+    // Same ladder again without the PM QoS request: lateness and power it buys
+    if (config_.cpu_latency_us) {
+        const size_t first_test = result.test_results.size();
+        cpu_latency_us_ = -1;
+        int released_passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, released_passing);
+        cpu_latency_us_ = *config_.cpu_latency_us;
+        if (!ok) {
+            return result;
+        }
+
+        // Lowest step: the pacing sleeps are longest there
+        const StreamTestResult& held = result.test_results.front();
+        const StreamTestResult& released = result.test_results[first_test];
+        CpuLatencyComparison comparison;
+        comparison.latency_us = *config_.cpu_latency_us;
+        comparison.streams = held.stream_count;
+        comparison.held_max_streams = last_passing;
+        comparison.released_max_streams = released_passing;
+        comparison.held_lateness = held.lag.lateness;
+        comparison.released_lateness = released.lag.lateness;
+        comparison.has_energy = held.power->has_energy && released.power->has_energy;
+        comparison.held_watts = held.power->package_watts;
+        comparison.released_watts = released.power->package_watts;
+        result.cpu_latency = comparison;
+    }
+
+    // Same ladder again as fast-forward playback at every speed
+    for (int speed : config_.playback_speeds) {
+        const size_t first_test = result.test_results.size();
+        playback_speed_ = speed;
+        int passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, passing);
+        playback_speed_ = 0;
+        if (!ok) {
+            return result;
+        }
+
+        PlaybackPoint point;
+        point.speed = speed;
+        point.strategy = playbackStrategyName(playbackStrategyFor(speed, video_info_.intra_only));
+        point.max_sessions = passing;
+        for (size_t i = first_test; i < result.test_results.size(); i++) {
+            if (result.test_results[i].stream_count == passing) {
+                point.displayed_fps = result.test_results[i].playback->displayed_fps;
+            }
+        }
+        result.playback.push_back(point);
+    }
+
+    // Same ladder again with packets above each temporal layer dropped
+    for (int layer : config_.temporal_layers) {
+        const size_t first_test = result.test_results.size();
+        temporal_layer_ = layer;
+        int passing = 0;
+        bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                            result, passing);
+        temporal_layer_ = -1;
+        if (!ok) {
+            return result;
+        }
+
+        LayerPoint point;
+        point.max_layer = layer;
+        point.max_streams = passing;
+        for (size_t i = first_test; i < result.test_results.size(); i++) {
+            if (result.test_results[i].stream_count == passing) {
+                point.decoded_fps = result.test_results[i].layers->decoded_fps;
+                point.dropped_pct = result.test_results[i].layers->dropped_pct;
+            }
+        }
+        result.layers.push_back(point);
+    }
+
+    // Same ladder again for every further mosaic canvas size
+    if (!config_.mosaic_canvases.empty()) {
+        auto mosaicPoint = [&](size_t first_test, size_t end_test, int passing) {
+            MosaicPoint point;
+            point.canvas = result.test_results[first_test].mosaic->canvas;
+            point.max_tiles = passing;
+            for (size_t i = first_test; i < end_test; i++) {
+                const StreamTestResult& test = result.test_results[i];
+                if (test.stream_count == passing && test.mosaic) {
+                    point.layout = test.mosaic->layout;
+                    if (test.mosaic->slots > 0) {
+                        point.deadline_miss_pct = 100.0 * test.mosaic->deadline_misses
+                                                  / test.mosaic->slots;
+                    }
+                }
+            }
+            return point;
+        };
+        result.mosaic.push_back(mosaicPoint(0, base_tests, last_passing));
+
+        for (size_t canvas = 1; canvas < config_.mosaic_canvases.size(); canvas++) {
+            const size_t first_test = result.test_results.size();
+            mosaic_canvas_ = canvas;
+            int passing = 0;
+            bool ok = runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                                result, passing);
+            mosaic_canvas_ = 0;
+            if (!ok) {
+                return result;
+            }
+            result.mosaic.push_back(mosaicPoint(first_test, result.test_results.size(), passing));
+        }
+    }
+
+    // Same ladder again for every further decoder policy
+    if (!config_.sched_compare.empty()) {
+        auto comparisonPoint = [&](size_t first_test, size_t end_test, int passing) {
+            SchedComparisonPoint point;
+            point.decoder = config_.decoder_sched.toString();
+            point.max_streams = passing;
+            for (size_t i = first_test; i < end_test; i++) {
+                if (result.test_results[i].stream_count == passing) {
+                    point.lateness = result.test_results[i].lag.lateness;
+                }
+            }
+            return point;
+        };
+        result.sched_comparison.push_back(comparisonPoint(0, base_tests, last_passing));
+
+        for (size_t i = 1; i < config_.sched_compare.size(); i++) {
+            const size_t first_test = result.test_results.size();
+            config_.decoder_sched = config_.sched_compare[i];
+            int passing = 0;
+            if (!runLadder(stream_counts, result.target_fps, cache_ptr, progress_callback,
+                           result, passing)) {
+                return result;
+            }
+            result.sched_comparison.push_back(
+                comparisonPoint(first_test, result.test_results.size(), passing));
+        }
+        config_.decoder_sched = config_.sched_compare.front();
+    }
+
+    result.success = true;
+
+    return result;
+}
+
+double BenchmarkRunner::loopbackCpuMs() const {
+    double cpu_ms = 0.0;
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    if (stand_in_) {
+        cpu_ms += stand_in_->getCpuMs();
+    }
+    if (segment_server_) {
+        cpu_ms += segment_server_->getCpuMs();
+    }
+#endif
+    return cpu_ms;
+}
+
+bool BenchmarkRunner::runLadder(const std::vector<int>& stream_counts, double target_fps,
+                                const ResultCache* cache, const ProgressCallback& progress_callback,
+                                BenchmarkResult& result, int& last_passing) {
+    last_passing = 0;
 
     for (int count : stream_counts) {
-        auto single_result = runSingleTest(count, result.target_fps);
+        auto single_result = measure(count, target_fps, cache);
 
         if (single_result.has_error) {
             result.error_message = single_result.error_message;
-            result.success = false;
-            return result;
+            return false;
         }
 
         result.test_results.push_back(single_result.result);
@@ -249,12 +1494,11 @@ BenchmarkResult BenchmarkRunner::run(ProgressCallback progress_callback) {
 
                 while (low <= high) {
                     int mid = low + (high - low) / 2;
-                    auto mid_result = runSingleTest(mid, result.target_fps);
+                    auto mid_result = measure(mid, target_fps, cache);
 
                     if (mid_result.has_error) {
                         result.error_message = mid_result.error_message;
-                        result.success = false;
-                        return result;
+                        return false;
                     }
 
                     result.test_results.push_back(mid_result.result);
@@ -275,10 +1519,7 @@ BenchmarkResult BenchmarkRunner::run(ProgressCallback progress_callback) {
         }
     }
 
-    result.max_streams = last_passing;
-    result.success = true;
-
-    return result;
+    return true;
 }
 
 } // namespace video_bench
@@ -3,11 +3,17 @@
 
 #include "benchmark/benchmark_config.hpp"
 #include "benchmark/benchmark_result.hpp"
+#include "benchmark/result_cache.hpp"
 #include "video/video_info.hpp"
 #include <functional>
+#include <vector>
+#include <cstdint>
 
 namespace video_bench {
 
+class RtspStandIn;
+class SegmentServer;
+
 // Callback for progress updates
 using ProgressCallback = std::function<void(const StreamTestResult&)>;
 
@@ -19,10 +25,30 @@ public:
     // Returns the complete benchmark result
     BenchmarkResult run(ProgressCallback progress_callback = nullptr);
 
-private:
+    // Single tests driven from outside (fleet agent): call prepare() once,
+    // then runStep() per stream count. run() does both itself.
+    bool prepare(std::string& error_message);
+    bool runStep(int stream_count, StreamTestResult& result, std::string& error_message);
+
+    // Configured target FPS, or the video's native FPS
+    double getTargetFps() const;
+
     // Get stream counts to test (1, 2, 4, 8, 12, 16, 20, 24, ...)
-    std::vector<int> getStreamCountsToTest(int max_streams) const;
+    // Substream mode doubles all the way: 1, 2, 4, ..., 1024, 2048, ...
+    static std::vector<int> getStreamCountsToTest(int max_streams, bool substream_mode);
+
+    // Max streams when --max-streams is not given
+    static int getDefaultMaxStreams(bool substream_mode, unsigned int thread_count);
 
+    // Loopback server serving the source (--stand-in); its CPU time is
+    // removed from the measured usage so only ingest and decode are billed
+    void setStandIn(const RtspStandIn* stand_in) { stand_in_ = stand_in; }
+
+    // HTTP server serving the source as HLS/DASH (--segmented); the ladder
+    // runs once per segment duration, with its CPU removed like the stand-in
+    void setSegmentServer(const SegmentServer* server) { segment_server_ = server; }
+
+private:
     // Result of a single stream count test (internal use)
     struct SingleTestResult {
         StreamTestResult result;
@@ -33,15 +59,51 @@ private:
     // Run a single stream count test
     SingleTestResult runSingleTest(int stream_count, double target_fps);
 
+    // Get a cached result for the stream count, or run and cache it
+    SingleTestResult measure(int stream_count, double target_fps, const ResultCache* cache);
+
+    // Cache config key of the running ladder: the current config plus the
+    // variant it is run for (ingest, speed, layer, canvas, PM QoS request)
+    std::string cacheKey(double target_fps) const;
+
+    // Walk the stream counts, then binary search after the first failure
+    // Appends every test to result; false on a test error (error_message set)
+    bool runLadder(const std::vector<int>& stream_counts, double target_fps,
+                   const ResultCache* cache, const ProgressCallback& progress_callback,
+                   BenchmarkResult& result, int& last_passing);
+
+    // CPU time so far of the in-process servers feeding the streams
+    double loopbackCpuMs() const;
+
     // Calculate test result from collected frame data
     void calculateTestResult(SingleTestResult& single_result,
                              const std::vector<int64_t>& per_stream_frames,
                              int64_t total_frames, double elapsed,
                              double cpu_usage, size_t memory_mb,
-                             int stream_count, double target_fps);
+                             int stream_count, int foreground_streams,
+                             double target_fps);
 
     BenchmarkConfig config_;
     VideoInfo video_info_;
+
+    // Reference frame hashes for --verify-output (one loop of the file)
+    std::vector<uint64_t> reference_hashes_;
+
+    // Keyframe timestamps for --reverse, shared by all streams
+    std::vector<int64_t> reverse_keyframes_;
+
+    // Open file limit after raising it (substream mode)
+    uint64_t fd_limit_ = 0;
+
+    const RtspStandIn* stand_in_ = nullptr;
+    const SegmentServer* segment_server_ = nullptr;
+    size_t segment_variant_ = 0;  // Variant served at config_.video_path
+    int playback_speed_ = 0;      // Fast-forward speed of the running ladder (0 = real time)
+    int temporal_layer_ = -1;     // Highest temporal layer decoded by the running ladder (-1 = all)
+    size_t mosaic_canvas_ = 0;    // Index into config_.mosaic_canvases of the running ladder
+    int cpu_latency_us_ = -1;     // PM QoS request held by the running ladder (-1 = none)
+
+    int profile_step_ = 0;  // Profiled tests so far (--profile file names)
 };
 
 } // namespace video_bench
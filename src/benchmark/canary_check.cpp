@@ -0,0 +1,297 @@
+#include "benchmark/canary_check.hpp"
+#include "benchmark/result_cache.hpp"
+#include "decoder/decode_loop.hpp"
+#include "decoder/video_decoder.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace video_bench {
+
+namespace {
+// Bump when the baseline format or the measurement changes
+constexpr int kBaselineFormatVersion = 1;
+
+constexpr int kRounds = 5;
+// The reference clip: this many packets from the start of the file
+constexpr int64_t kCanaryPackets = 120;
+
+using FieldMap = std::map<std::string, std::string>;
+
+// Owns the preloaded packets
+struct PacketList {
+    std::vector<AVPacket*> packets;
+    ~PacketList() {
+        for (AVPacket* packet : packets) {
+            av_packet_free(&packet);
+        }
+    }
+};
+
+std::string hashString(uint64_t hash) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+}
+
+// key=value lines; later keys win
+FieldMap parseFields(std::istream& in) {
+    FieldMap fields;
+    std::string line;
+    while (std::getline(in, line)) {
+        auto pos = line.find('=');
+        if (pos != std::string::npos) {
+            fields[line.substr(0, pos)] = line.substr(pos + 1);
+        }
+    }
+    return fields;
+}
+
+// Write to a temporary file and rename, so readers never see a partial file
+bool writeFileAtomically(const std::string& path, const std::string& content,
+                         std::string& error_message) {
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "Canary: failed to open " + temp_path;
+            return false;
+        }
+        file << content;
+        if (!file.flush()) {
+            error_message = "Canary: failed to write " + temp_path;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        error_message = "Canary: failed to replace " + path + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+CanaryCheck::CanaryCheck(std::string video_path, std::string baseline_path,
+                         double cpu_budget_pct, double tolerance_pct)
+    : video_path_(std::move(video_path))
+    , baseline_path_(std::move(baseline_path))
+    , cpu_budget_pct_(cpu_budget_pct)
+    , tolerance_pct_(tolerance_pct) {
+}
+
+bool CanaryCheck::run(CanaryResult& result, std::string& error_message) {
+    auto source_hash = ResultCache::hashFile(video_path_);
+    if (!source_hash) {
+        error_message = "Canary: failed to read reference clip: " + video_path_;
+        return false;
+    }
+
+    // Check the baseline before spending the CPU budget on decoding
+    FieldMap baseline;
+    std::ifstream baseline_file(baseline_path_);
+    if (baseline_file.is_open()) {
+        baseline = parseFields(baseline_file);
+        if (baseline["format"] != std::to_string(kBaselineFormatVersion) ||
+            !baseline.count("fps")) {
+            error_message = "Canary: unrecognized baseline " + baseline_path_ +
+                            " (delete it to record a new one)";
+            return false;
+        }
+        if (baseline["source"] != hashString(*source_hash)) {
+            error_message = "Canary: baseline " + baseline_path_ +
+                            " was recorded with a different reference clip";
+            return false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!decodeRounds(result, error_message)) {
+        return false;
+    }
+    result.elapsed_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    result.baseline_path = baseline_path_;
+    result.tolerance_pct = tolerance_pct_;
+
+    std::istringstream host_in(ResultCache::hostFingerprint());
+    FieldMap host = parseFields(host_in);
+
+    if (baseline.empty()) {
+        std::ostringstream out;
+        out.precision(17);
+        out << "format=" << kBaselineFormatVersion << "\n"
+            << "source=" << hashString(*source_hash) << "\n"
+            << "packets=" << result.packets << "\n"
+            << "fps=" << result.fps << "\n";
+        for (const auto& [key, value] : host) {
+            out << "host." << key << "=" << value << "\n";
+        }
+        if (!writeFileAtomically(baseline_path_, out.str(), error_message)) {
+            return false;
+        }
+        result.baseline_recorded = true;
+        result.baseline_fps = result.fps;
+        return true;
+    }
+
+    if (baseline["packets"] != std::to_string(result.packets)) {
+        error_message = "Canary: baseline " + baseline_path_ + " was recorded with " +
+                        baseline["packets"] + " packets per round, the clip now gives " +
+                        std::to_string(result.packets);
+        return false;
+    }
+    std::istringstream(baseline["fps"]) >> result.baseline_fps;
+    if (result.baseline_fps > 0.0) {
+        result.drift_pct = 100.0 * (result.fps - result.baseline_fps) / result.baseline_fps;
+    }
+    // Only slowdowns are capacity degradation; a faster host is reported as drift
+    result.degraded = result.drift_pct < -tolerance_pct_;
+
+    for (const auto& [key, value] : host) {
+        auto it = baseline.find("host." + key);
+        if (it != baseline.end() && it->second != value) {
+            result.host_changes.push_back(key + ": " + it->second + " -> " + value);
+        }
+    }
+    return true;
+}
+
+bool CanaryCheck::decodeRounds(CanaryResult& result, std::string& error_message) {
+    AVFormatContext* format_ctx_raw = nullptr;
+    int ret = avformat_open_input(&format_ctx_raw, video_path_.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Canary: failed to open reference clip: " + ffmpegErrorString(ret);
+        return false;
+    }
+    UniqueAVFormatContext format_ctx(format_ctx_raw);
+
+    ret = avformat_find_stream_info(format_ctx.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Canary: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    int video_stream_index = -1;
+    for (unsigned int i = 0; i < format_ctx->nb_streams; i++) {
+        if (format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+            video_stream_index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (video_stream_index < 0) {
+        error_message = "Canary: no video stream found";
+        return false;
+    }
+    const AVCodecParameters* codec_params = format_ctx->streams[video_stream_index]->codecpar;
+
+    // Read up front so no round pays for demuxing or disk I/O
+    PacketList preloaded;
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        error_message = "Canary: failed to allocate packet";
+        return false;
+    }
+    while (static_cast<int64_t>(preloaded.packets.size()) < kCanaryPackets &&
+           av_read_frame(format_ctx.get(), packet.get()) >= 0) {
+        if (packet->stream_index == video_stream_index) {
+            preloaded.packets.push_back(av_packet_clone(packet.get()));
+            if (!preloaded.packets.back()) {
+                preloaded.packets.pop_back();
+                av_packet_unref(packet.get());
+                error_message = "Canary: failed to clone packet";
+                return false;
+            }
+        }
+        av_packet_unref(packet.get());
+    }
+    if (preloaded.packets.empty()) {
+        error_message = "Canary: no video packets in reference clip";
+        return false;
+    }
+
+    result.packets = static_cast<int64_t>(preloaded.packets.size());
+    result.rounds = kRounds;
+    result.cpu_budget_pct = cpu_budget_pct_;
+
+    std::vector<double> round_fps;
+    for (int round = 0; round < kRounds; round++) {
+        auto round_start = LoopClock::now();
+
+        // A fresh decoder per round: every round starts from the same state
+        VideoDecoder decoder;
+        if (!decoder.initFromParams(codec_params, error_message, 1, false)) {
+            return false;
+        }
+
+        FreeRunPacer pacer;
+        MemoryPacketSource source(preloaded.packets, result.packets);
+        NullSink sink;
+        BareRecorder recorder;
+        std::atomic<bool> stop_flag{false};
+        std::atomic<int64_t> frames_decoded{0};
+        int64_t total_frames = 0;
+
+        auto decode_start = LoopClock::now();
+        if (!runDecodeLoop(decoder, pacer, source, sink, recorder, stop_flag,
+                           frames_decoded, total_frames, error_message)) {
+            return false;
+        }
+        auto round_end = LoopClock::now();
+        if (total_frames == 0) {
+            error_message = "Canary: no frames decoded";
+            return false;
+        }
+        round_fps.push_back(static_cast<double>(total_frames) /
+                            std::chrono::duration<double>(round_end - decode_start).count());
+
+        // Idle long enough that busy time stays within the budget
+        if (round + 1 < kRounds) {
+            auto busy = round_end - round_start;
+            std::this_thread::sleep_for(std::chrono::duration_cast<LoopClock::duration>(
+                busy * (100.0 / cpu_budget_pct_ - 1.0)));
+        }
+    }
+
+    // Median: one interrupted round neither hides nor raises an alarm
+    std::sort(round_fps.begin(), round_fps.end());
+    result.fps = round_fps[round_fps.size() / 2];
+    return true;
+}
+
+bool CanaryCheck::writeMetrics(const CanaryResult& result, const std::string& path,
+                               std::string& error_message) {
+    const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3)
+        << "# HELP video_bench_canary_fps Reference clip decode speed on one thread, median round\n"
+        << "# TYPE video_bench_canary_fps gauge\n"
+        << "video_bench_canary_fps " << result.fps << "\n"
+        << "# HELP video_bench_canary_baseline_fps Stored baseline decode speed for this host\n"
+        << "# TYPE video_bench_canary_baseline_fps gauge\n"
+        << "video_bench_canary_baseline_fps " << result.baseline_fps << "\n"
+        << "# HELP video_bench_canary_drift_percent Decode speed against the baseline\n"
+        << "# TYPE video_bench_canary_drift_percent gauge\n"
+        << "video_bench_canary_drift_percent " << result.drift_pct << "\n"
+        << "# HELP video_bench_canary_degraded 1 if slower than the baseline beyond tolerance\n"
+        << "# TYPE video_bench_canary_degraded gauge\n"
+        << "video_bench_canary_degraded " << (result.degraded ? 1 : 0) << "\n"
+        << "# HELP video_bench_canary_host_changes Host fingerprint fields changed since the baseline\n"
+        << "# TYPE video_bench_canary_host_changes gauge\n"
+        << "video_bench_canary_host_changes " << result.host_changes.size() << "\n"
+        << "# HELP video_bench_canary_last_run_timestamp_seconds Completion time of the last check\n"
+        << "# TYPE video_bench_canary_last_run_timestamp_seconds gauge\n"
+        << "video_bench_canary_last_run_timestamp_seconds " << now << "\n";
+    return writeFileAtomically(path, out.str(), error_message);
+}
+
+} // namespace video_bench
@@ -0,0 +1,58 @@
+#ifndef CANARY_CHECK_HPP
+#define CANARY_CHECK_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace video_bench {
+
+// One canary check against the host's stored baseline
+struct CanaryResult {
+    int64_t packets = 0;  // Packets per round (the reference clip)
+    int rounds = 0;
+    double fps = 0.0;     // Median round
+    double cpu_budget_pct = 0.0;
+    double elapsed_seconds = 0.0;  // Including the budget sleeps
+
+    std::string baseline_path;
+    bool baseline_recorded = false;  // No baseline yet: this check became it
+    double baseline_fps = 0.0;
+    double drift_pct = 0.0;          // Against the baseline, negative = slower
+    double tolerance_pct = 0.0;
+    bool degraded = false;           // Slower than the baseline beyond tolerance
+
+    // Host fingerprint fields that changed since the baseline, "key: old -> new"
+    std::vector<std::string> host_changes;
+};
+
+// Production canary: decodes the first packets of a local reference clip
+// from memory, unpaced, on one single-threaded decoder, several rounds
+// with sleeps in between so the check stays within cpu_budget_pct of one
+// core. The median round's speed is compared with a per-host baseline
+// file; the first check on a host writes it. The baseline keeps the
+// clip's content hash (a different clip is an error) and the host
+// fingerprint, so microcode, kernel or governor changes can be named.
+class CanaryCheck {
+public:
+    CanaryCheck(std::string video_path, std::string baseline_path,
+                double cpu_budget_pct, double tolerance_pct);
+
+    bool run(CanaryResult& result, std::string& error_message);
+
+    // Prometheus text format, for the node_exporter textfile collector
+    static bool writeMetrics(const CanaryResult& result, const std::string& path,
+                             std::string& error_message);
+
+private:
+    bool decodeRounds(CanaryResult& result, std::string& error_message);
+
+    std::string video_path_;
+    std::string baseline_path_;
+    double cpu_budget_pct_;
+    double tolerance_pct_;
+};
+
+} // namespace video_bench
+
+#endif // CANARY_CHECK_HPP
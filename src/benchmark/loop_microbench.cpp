@@ -0,0 +1,149 @@
+#include "benchmark/loop_microbench.hpp"
+#include "decoder/decode_loop.hpp"
+#include "decoder/video_decoder.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace video_bench {
+
+namespace {
+constexpr int kRounds = 5;
+// Packets kept in memory; the loop cycles through them
+constexpr int64_t kMaxPreloadPackets = 1000;
+
+// Owns the preloaded packets
+struct PacketList {
+    std::vector<AVPacket*> packets;
+    ~PacketList() {
+        for (AVPacket* packet : packets) {
+            av_packet_free(&packet);
+        }
+    }
+};
+
+// Decode frames packets with one loop configuration; returns ns per frame
+template <typename Recorder>
+bool timeRound(const AVCodecParameters* codec_params, const std::vector<AVPacket*>& packets,
+               int64_t frames, Recorder& recorder, double& ns_per_frame,
+               std::string& error_message) {
+    // A fresh decoder per round: same state for both configurations
+    VideoDecoder decoder;
+    if (!decoder.initFromParams(codec_params, error_message, 1, false)) {
+        return false;
+    }
+
+    FreeRunPacer pacer;
+    MemoryPacketSource source(packets, frames);
+    NullSink sink;
+    std::atomic<bool> stop_flag{false};
+    std::atomic<int64_t> frames_decoded{0};
+    int64_t total_frames = 0;
+
+    auto start = LoopClock::now();
+    if (!runDecodeLoop(decoder, pacer, source, sink, recorder, stop_flag,
+                       frames_decoded, total_frames, error_message)) {
+        return false;
+    }
+    auto elapsed_ns = std::chrono::duration<double, std::nano>(LoopClock::now() - start).count();
+    if (total_frames == 0) {
+        error_message = "Loop microbenchmark: no frames decoded";
+        return false;
+    }
+    ns_per_frame = elapsed_ns / static_cast<double>(total_frames);
+    return true;
+}
+} // namespace
+
+LoopMicrobench::LoopMicrobench(std::string video_path, int64_t frames)
+    : video_path_(std::move(video_path))
+    , frames_(frames) {
+}
+
+bool LoopMicrobench::run(LoopMicrobenchResult& result, std::string& error_message) {
+    AVFormatContext* format_ctx_raw = nullptr;
+    int ret = avformat_open_input(&format_ctx_raw, video_path_.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Loop microbenchmark: failed to open source: " + ffmpegErrorString(ret);
+        return false;
+    }
+    UniqueAVFormatContext format_ctx(format_ctx_raw);
+
+    ret = avformat_find_stream_info(format_ctx.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Loop microbenchmark: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    int video_stream_index = -1;
+    for (unsigned int i = 0; i < format_ctx->nb_streams; i++) {
+        if (format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+            video_stream_index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (video_stream_index < 0) {
+        error_message = "Loop microbenchmark: no video stream found";
+        return false;
+    }
+    const AVCodecParameters* codec_params = format_ctx->streams[video_stream_index]->codecpar;
+
+    // Read up front so no round pays for demuxing
+    PacketList preloaded;
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        error_message = "Loop microbenchmark: failed to allocate packet";
+        return false;
+    }
+    const int64_t preload_limit = std::min(frames_, kMaxPreloadPackets);
+    while (static_cast<int64_t>(preloaded.packets.size()) < preload_limit &&
+           av_read_frame(format_ctx.get(), packet.get()) >= 0) {
+        if (packet->stream_index == video_stream_index) {
+            preloaded.packets.push_back(av_packet_clone(packet.get()));
+            if (!preloaded.packets.back()) {
+                preloaded.packets.pop_back();
+                av_packet_unref(packet.get());
+                error_message = "Loop microbenchmark: failed to clone packet";
+                return false;
+            }
+        }
+        av_packet_unref(packet.get());
+    }
+    if (preloaded.packets.empty()) {
+        error_message = "Loop microbenchmark: no video packets in source";
+        return false;
+    }
+
+    result.frames = frames_;
+    result.rounds = kRounds;
+    result.preloaded_packets = static_cast<int64_t>(preloaded.packets.size());
+    result.bare_ns_per_frame = std::numeric_limits<double>::max();
+    result.instrumented_ns_per_frame = std::numeric_limits<double>::max();
+
+    // An open window that never closes: every frame takes the window check
+    MeasurementWindow window;
+    window.open();
+
+    for (int round = 0; round < kRounds; round++) {
+        double ns_per_frame = 0.0;
+        BareRecorder bare;
+        if (!timeRound(codec_params, preloaded.packets, frames_, bare, ns_per_frame,
+                       error_message)) {
+            return false;
+        }
+        result.bare_ns_per_frame = std::min(result.bare_ns_per_frame, ns_per_frame);
+
+        std::atomic<int64_t> window_frames{0};
+        LatencyHistogram lateness;
+        InstrumentedRecorder instrumented(&window, window_frames, lateness);
+        if (!timeRound(codec_params, preloaded.packets, frames_, instrumented, ns_per_frame,
+                       error_message)) {
+            return false;
+        }
+        result.instrumented_ns_per_frame = std::min(result.instrumented_ns_per_frame, ns_per_frame);
+    }
+    return true;
+}
+
+} // namespace video_bench
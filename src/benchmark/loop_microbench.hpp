@@ -0,0 +1,38 @@
+#ifndef LOOP_MICROBENCH_HPP
+#define LOOP_MICROBENCH_HPP
+
+#include <string>
+#include <cstdint>
+
+namespace video_bench {
+
+// Per-frame cost of the decode loop with and without instrumentation
+struct LoopMicrobenchResult {
+    int64_t frames = 0;  // Frames decoded per round and configuration
+    int rounds = 0;
+    int64_t preloaded_packets = 0;
+    double bare_ns_per_frame = 0.0;          // Fastest round
+    double instrumented_ns_per_frame = 0.0;  // Fastest round
+
+    double overheadNsPerFrame() const { return instrumented_ns_per_frame - bare_ns_per_frame; }
+};
+
+// Decodes the same in-memory packets with the bare loop (BareRecorder) and
+// the instrumented loop the benchmark uses (InstrumentedRecorder), both
+// unpaced and without stages, on one single-threaded decoder. Rounds
+// alternate between the two and the fastest of each is kept, so the
+// difference is the per-frame cost of instrumentation, not I/O or noise.
+class LoopMicrobench {
+public:
+    LoopMicrobench(std::string video_path, int64_t frames);
+
+    bool run(LoopMicrobenchResult& result, std::string& error_message);
+
+private:
+    std::string video_path_;
+    int64_t frames_;
+};
+
+} // namespace video_bench
+
+#endif // LOOP_MICROBENCH_HPP
@@ -0,0 +1,207 @@
+#include "benchmark/result_cache.hpp"
+#include "benchmark/result_serializer.hpp"
+#include "monitor/system_info.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <system_error>
+
+namespace video_bench {
+
+namespace {
+
+// Bump when the stored format or measurement method changes
+// 2: FPS counted inside the measurement window
+// 3: lateness inside the window, from a histogram
+// 4: playback fields
+// 5: mosaic misses counted per slot
+// 6: power and C-state fields
+// 7: slow decode split by the packet sent, not the frame output
+// 8: stage work as a late frame cause
+constexpr int kCacheFormatVersion = 8;
+
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = kFnvOffsetBasis) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+std::string toHex(uint64_t value) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << value;
+    return out.str();
+}
+
+} // namespace
+
+std::string ResultCache::hostFingerprint() {
+    std::ostringstream out;
+    out << "cpu=" << SystemInfo::getCpuName() << "\n"
+        << "threads=" << SystemInfo::getThreadCount() << "\n"
+        << "microcode=" << SystemInfo::getMicrocodeVersion() << "\n"
+        << "kernel=" << SystemInfo::getKernelVersion() << "\n"
+        << "governor=" << SystemInfo::getCpuGovernor() << "\n"
+        << "ffmpeg=" << av_version_info() << "\n"
+        << "ffmpeg_config=" << avcodec_configuration() << "\n";
+    return out.str();
+}
+
+std::string ResultCache::configFingerprint(const BenchmarkConfig& config, double target_fps) {
+    std::ostringstream out;
+    out.precision(17);
+    out << "format=" << kCacheFormatVersion << "\n"
+        << "target_fps=" << target_fps << "\n"
+        << "measurement_duration=" << config.measurement_duration << "\n"
+        << "cpu_threshold=" << config.cpu_threshold << "\n"
+        << "snapshot_interval=" << config.snapshot_interval.value_or(0.0) << "\n"
+        << "snapshot_width=" << config.snapshot_width << "\n"
+        << "snapshot_workers=" << config.snapshot_workers << "\n"
+        << "motion_fps=" << config.motion_fps.value_or(0.0) << "\n"
+        << "motion_downsample=" << config.motion_downsample << "\n"
+        << "switch_interval=" << config.switch_interval.value_or(0.0) << "\n"
+        << "infer_batch=" << config.infer_batch.value_or(0) << "\n"
+        << "infer_fps=" << config.infer_fps << "\n"
+        << "infer_input=" << config.infer_input << "\n"
+        << "infer_deadline_ms=" << config.infer_deadline_ms << "\n"
+        << "verify_output=" << (config.verify_output ? 1 : 0) << "\n"
+        << "substream_mode=" << (config.substream_mode ? 1 : 0) << "\n"
+        << "decoder_sched=" << config.decoder_sched.toString() << "\n"
+        << "reader_sched=" << config.reader_sched.toString() << "\n"
+        << "background_sched=" << config.background_sched.toString() << "\n"
+        << "background_streams=" << config.background_streams << "\n"
+        << "rtsp_transport=" << config.rtsp_transport << "\n"
+        << "batched_udp=" << config.batched_udp.value_or(0) << "\n"
+        << "tls_cipher=" << config.tls_cipher << "\n"
+        << "segment_format=" << config.segment_format << "\n"
+        << "reverse=" << (config.reverse ? 1 : 0) << "\n"
+        << "reverse_cache=" << config.reverse_cache << "\n"
+        << "reverse_width=" << config.reverse_width << "\n"
+        << "mosaic_fps=" << config.mosaic_fps << "\n";
+    // Recording is switched off for its comparison ladder
+    if (config.record_dir) {
+        out << "record_format=" << config.record_format << "\n"
+            << "record_segment=" << config.record_segment << "\n"
+            << "record_fsync=" << config.record_fsync << "\n"
+            << "record_direct=" << (config.record_direct ? 1 : 0) << "\n";
+    } else {
+        out << "record_format=none\n";
+    }
+    return out.str();
+}
+
+std::optional<uint64_t> ResultCache::hashFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    uint64_t hash = kFnvOffsetBasis;
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = fnv1a(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    if (file.bad()) {
+        return std::nullopt;
+    }
+    return hash;
+}
+
+bool ResultCache::init(const std::string& cache_dir,
+                       const std::string& source_path,
+                       std::string& error_message) {
+    auto source_hash = hashFile(source_path);
+    if (!source_hash) {
+        error_message = "Result cache: failed to read source: " + source_path;
+        return false;
+    }
+
+    std::error_code ec;
+    dir_ = cache_dir;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        error_message = "Result cache: failed to create directory " + cache_dir +
+                        ": " + ec.message();
+        return false;
+    }
+
+    host_source_ = hostFingerprint() + "source=" + toHex(*source_hash) + "\n";
+    return true;
+}
+
+std::string ResultCache::keyMaterial(const std::string& config_key) const {
+    return host_source_ + config_key;
+}
+
+std::string ResultCache::keyPrefix(const std::string& config_key) const {
+    std::string material = keyMaterial(config_key);
+    return toHex(fnv1a(material.data(), material.size()));
+}
+
+std::filesystem::path ResultCache::pointPath(const std::string& config_key,
+                                             int stream_count) const {
+    return dir_ / (keyPrefix(config_key) + "-" + std::to_string(stream_count) + ".result");
+}
+
+std::optional<StreamTestResult> ResultCache::lookup(const std::string& config_key,
+                                                    int stream_count) const {
+    std::ifstream file(pointPath(config_key, stream_count));
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    auto result = ResultSerializer::deserialize(content.str());
+    if (!result || result->stream_count != stream_count) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool ResultCache::store(const std::string& config_key, const StreamTestResult& result,
+                        std::string& error_message) const {
+    // Human-readable key next to the entries, for inspecting the cache
+    std::filesystem::path key_path = dir_ / (keyPrefix(config_key) + ".key");
+    if (!std::filesystem::exists(key_path)) {
+        std::ofstream key_file(key_path);
+        key_file << keyMaterial(config_key);
+    }
+
+    // Write to a temporary file and rename so readers never see partial entries
+    std::filesystem::path path = pointPath(config_key, result.stream_count);
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream file(tmp_path);
+        if (!file.is_open()) {
+            error_message = "Result cache: failed to write " + tmp_path.string();
+            return false;
+        }
+        file << ResultSerializer::serialize(result);
+        if (!file.good()) {
+            error_message = "Result cache: failed to write " + tmp_path.string();
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        error_message = "Result cache: failed to rename " + tmp_path.string() +
+                        ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+} // namespace video_bench
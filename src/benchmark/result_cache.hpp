@@ -0,0 +1,55 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include "benchmark/benchmark_config.hpp"
+#include "benchmark/benchmark_result.hpp"
+#include <string>
+#include <optional>
+#include <filesystem>
+#include <cstdint>
+
+namespace video_bench {
+
+// Local cache of measured stream count points
+// A point is keyed by host fingerprint (CPU model, microcode, kernel,
+// FFmpeg version/configuration, governor), the source file content hash,
+// a config key (the measurement-relevant settings of the ladder being
+// run, given per lookup) and the stream count.
+class ResultCache {
+public:
+    // Fingerprint this host and source and prepare the directory
+    bool init(const std::string& cache_dir,
+              const std::string& source_path,
+              std::string& error_message);
+
+    // Get a previously stored result for this config key and stream count
+    std::optional<StreamTestResult> lookup(const std::string& config_key,
+                                           int stream_count) const;
+
+    // Store a measured result under the config key (overwrites an existing entry)
+    bool store(const std::string& config_key, const StreamTestResult& result,
+               std::string& error_message) const;
+
+    // Description of the host used in the cache key
+    static std::string hostFingerprint();
+
+    // Description of the config fields that affect measurements
+    static std::string configFingerprint(const BenchmarkConfig& config, double target_fps);
+
+    // Content hash of a source file (FNV-1a 64), nullopt if unreadable
+    static std::optional<uint64_t> hashFile(const std::string& path);
+
+private:
+    // Key material and its hash for one config key
+    std::string keyMaterial(const std::string& config_key) const;
+    std::string keyPrefix(const std::string& config_key) const;
+
+    std::filesystem::path pointPath(const std::string& config_key, int stream_count) const;
+
+    std::filesystem::path dir_;
+    std::string host_source_;  // Host fingerprint and source hash lines
+};
+
+} // namespace video_bench
+
+#endif // RESULT_CACHE_HPP
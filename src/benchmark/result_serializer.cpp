@@ -0,0 +1,635 @@
+#include "benchmark/result_serializer.hpp"
+#include <sstream>
+#include <map>
+#include <limits>
+
+namespace video_bench {
+
+namespace {
+
+using FieldMap = std::map<std::string, std::string>;
+
+class FieldWriter {
+public:
+    FieldWriter() {
+        out_.precision(std::numeric_limits<double>::max_digits10);
+    }
+
+    template <typename T>
+    void put(const std::string& key, const T& value) {
+        out_ << key << "=" << value << "\n";
+    }
+
+    void putBool(const std::string& key, bool value) {
+        out_ << key << "=" << (value ? 1 : 0) << "\n";
+    }
+
+    template <typename T>
+    void putList(const std::string& key, const std::vector<T>& values) {
+        out_ << key << "=";
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i > 0) out_ << ",";
+            out_ << values[i];
+        }
+        out_ << "\n";
+    }
+
+    void putLatency(const std::string& prefix, const LatencySummary& summary) {
+        put(prefix + ".count", summary.count);
+        put(prefix + ".avg_ms", summary.avg_ms);
+        put(prefix + ".p50_ms", summary.p50_ms);
+        put(prefix + ".p95_ms", summary.p95_ms);
+        put(prefix + ".p99_ms", summary.p99_ms);
+        put(prefix + ".max_ms", summary.max_ms);
+    }
+
+    std::string str() const { return out_.str(); }
+
+private:
+    std::ostringstream out_;
+};
+
+class FieldReader {
+public:
+    explicit FieldReader(const std::string& text) {
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t pos = line.find('=');
+            if (pos != std::string::npos) {
+                fields_[line.substr(0, pos)] = line.substr(pos + 1);
+            }
+        }
+    }
+
+    bool has(const std::string& key) const { return fields_.count(key) > 0; }
+
+    template <typename T>
+    bool get(const std::string& key, T& value) {
+        auto it = fields_.find(key);
+        if (it == fields_.end()) {
+            ok_ = false;
+            return false;
+        }
+        std::istringstream in(it->second);
+        if (!(in >> value)) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    bool get(const std::string& key, std::string& value) {
+        auto it = fields_.find(key);
+        if (it == fields_.end()) {
+            ok_ = false;
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    void getBool(const std::string& key, bool& value) {
+        int raw = 0;
+        if (get(key, raw)) {
+            value = raw != 0;
+        }
+    }
+
+    template <typename T>
+    void getList(const std::string& key, std::vector<T>& values) {
+        auto it = fields_.find(key);
+        if (it == fields_.end()) {
+            ok_ = false;
+            return;
+        }
+        values.clear();
+        std::istringstream in(it->second);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            std::istringstream item_in(item);
+            T value{};
+            if (!(item_in >> value)) {
+                ok_ = false;
+                return;
+            }
+            values.push_back(value);
+        }
+    }
+
+    void getLatency(const std::string& prefix, LatencySummary& summary) {
+        get(prefix + ".count", summary.count);
+        get(prefix + ".avg_ms", summary.avg_ms);
+        get(prefix + ".p50_ms", summary.p50_ms);
+        get(prefix + ".p95_ms", summary.p95_ms);
+        get(prefix + ".p99_ms", summary.p99_ms);
+        get(prefix + ".max_ms", summary.max_ms);
+    }
+
+    bool ok() const { return ok_; }
+
+private:
+    FieldMap fields_;
+    bool ok_ = true;
+};
+
+} // namespace
+
+std::string ResultSerializer::serialize(const StreamTestResult& result) {
+    FieldWriter w;
+    w.put("stream_count", result.stream_count);
+    w.put("fps_per_stream", result.fps_per_stream);
+    w.put("min_fps", result.min_fps);
+    w.put("max_fps", result.max_fps);
+    w.put("window_seconds", result.window_seconds);
+    w.put("legacy_fps_per_stream", result.legacy_fps_per_stream);
+    w.putList("per_stream_fps", result.per_stream_fps);
+    w.putList("per_stream_frames", result.per_stream_frames);
+    w.put("cpu_usage", result.cpu_usage);
+    w.put("memory_usage_mb", result.memory_usage_mb);
+    w.putBool("fps_passed", result.fps_passed);
+    w.putBool("cpu_passed", result.cpu_passed);
+    w.putBool("passed", result.passed);
+
+    w.put("lag.late_frames", result.lag.late_frames);
+    w.put("lag.max_lag_ms", result.lag.max_lag_ms);
+    w.put("lag.slow_decode", result.lag.slow_decode);
+    w.put("lag.slow_decode_key", result.lag.slow_decode_key);
+    w.put("lag.slow_decode_delta", result.lag.slow_decode_delta);
+    w.put("lag.stage_work", result.lag.stage_work);
+    w.put("lag.reader_starved", result.lag.reader_starved);
+    w.put("lag.scheduler_delay", result.lag.scheduler_delay);
+    w.put("lag.oversleep", result.lag.oversleep);
+    w.putBool("lag.run_delay_available", result.lag.run_delay_available);
+    w.putLatency("lag.lateness", result.lag.lateness);
+
+    if (result.snapshot) {
+        w.put("snapshot.taken", result.snapshot->taken);
+        w.put("snapshot.dropped", result.snapshot->dropped);
+        w.put("snapshot.avg_bytes", result.snapshot->avg_bytes);
+        w.putLatency("snapshot.latency", result.snapshot->latency);
+    }
+
+    if (result.motion) {
+        w.put("motion.frames_analyzed", result.motion->frames_analyzed);
+        w.put("motion.motion_frames", result.motion->motion_frames);
+        w.putLatency("motion.cost", result.motion->cost);
+        w.put("motion.kernel", result.motion->kernel);
+    }
+
+    if (result.channel_switch) {
+        w.put("switch.switches", result.channel_switch->switches);
+        w.putLatency("switch.latency", result.channel_switch->latency);
+        w.put("switch.avg_cpu_ms", result.channel_switch->avg_cpu_ms);
+        w.put("switch.avg_frames", result.channel_switch->avg_frames);
+        w.put("switch.ring_kb_per_stream", result.channel_switch->ring_kb_per_stream);
+        w.put("switch.ring_kb_total", result.channel_switch->ring_kb_total);
+    }
+
+    if (result.hash_check) {
+        w.put("hash.frames_checked", result.hash_check->frames_checked);
+        w.put("hash.mismatches", result.hash_check->mismatches);
+        w.put("hash.unchecked", result.hash_check->unchecked);
+        w.putList("hash.per_stream_mismatches", result.hash_check->per_stream_mismatches);
+        w.putList("hash.per_stream_first_mismatch", result.hash_check->per_stream_first_mismatch);
+        w.putLatency("hash.cost", result.hash_check->cost);
+        w.put("hash.kernel", result.hash_check->kernel);
+    }
+
+    if (result.batch) {
+        w.put("batch.batch_size", result.batch->batch_size);
+        w.put("batch.frames_batched", result.batch->frames_batched);
+        w.put("batch.frames_dropped", result.batch->frames_dropped);
+        w.put("batch.full_batches", result.batch->full_batches);
+        w.put("batch.deadline_batches", result.batch->deadline_batches);
+        w.put("batch.batches_per_sec", result.batch->batches_per_sec);
+        w.putLatency("batch.assembly", result.batch->assembly);
+        w.putLatency("batch.convert", result.batch->convert);
+        w.put("batch.kernel", result.batch->kernel);
+    }
+
+    if (result.harness) {
+        w.put("harness.kb_per_stream", result.harness->kb_per_stream);
+        w.put("harness.readers", result.harness->readers);
+        w.put("harness.queue_size", result.harness->queue_size);
+        w.put("harness.fd_limit", result.harness->fd_limit);
+    }
+
+    if (result.network) {
+        w.put("network.cpu_usage", result.network->cpu_usage);
+        w.put("network.decode_cpu_usage", result.network->decode_cpu_usage);
+        w.put("network.rx_mbps", result.network->rx_mbps);
+        w.put("network.cpu_ms_per_mbit", result.network->cpu_ms_per_mbit);
+        w.put("network.core_pct_per_stream", result.network->core_pct_per_stream);
+        w.put("network.net_rx_softirqs", result.network->net_rx_softirqs);
+        w.put("network.nic_interrupts", result.network->nic_interrupts);
+        w.put("network.udp_in_datagrams", result.network->udp_in_datagrams);
+        w.put("network.udp_rcvbuf_errors", result.network->udp_rcvbuf_errors);
+        w.put("network.tcp_in_segs", result.network->tcp_in_segs);
+    }
+
+    if (result.ingest) {
+        w.put("ingest.path", result.ingest->path);
+        w.put("ingest.receiver_threads", result.ingest->receiver_threads);
+        w.put("ingest.recv_syscalls_per_sec", result.ingest->recv_syscalls_per_sec);
+        w.put("ingest.datagrams_per_sec", result.ingest->datagrams_per_sec);
+        w.put("ingest.stand_in_cpu_usage", result.ingest->stand_in_cpu_usage);
+        w.put("ingest.core_pct_per_stream", result.ingest->core_pct_per_stream);
+        w.put("ingest.reader_cpu_ms_per_mbit", result.ingest->reader_cpu_ms_per_mbit);
+        w.put("ingest.lost_packets", result.ingest->lost_packets);
+        w.put("ingest.dropped_units", result.ingest->dropped_units);
+    }
+
+    if (result.segment) {
+        w.put("segment.format", result.segment->format);
+        w.put("segment.segment_duration", result.segment->segment_duration);
+        w.put("segment.segments_fetched", result.segment->segments_fetched);
+        w.put("segment.manifest_fetches", result.segment->manifest_fetches);
+        w.put("segment.reader_cpu_ms_per_segment", result.segment->reader_cpu_ms_per_segment);
+        w.put("segment.server_cpu_usage", result.segment->server_cpu_usage);
+    }
+
+    if (result.sched) {
+        w.put("sched.decoder", result.sched->decoder);
+        w.put("sched.reader", result.sched->reader);
+        w.put("sched.background", result.sched->background);
+        w.put("sched.background_streams", result.sched->background_streams);
+        w.put("sched.background_avg_fps", result.sched->background_avg_fps);
+        w.put("sched.background_min_fps", result.sched->background_min_fps);
+    }
+
+    if (result.record) {
+        w.put("record.format", result.record->format);
+        w.put("record.segment_seconds", result.record->segment_seconds);
+        w.put("record.fsync", result.record->fsync);
+        w.putBool("record.direct_io", result.record->direct_io);
+        w.put("record.bytes_written", result.record->bytes_written);
+        w.put("record.write_mb_per_sec", result.record->write_mb_per_sec);
+        w.put("record.segments", result.record->segments);
+        w.putLatency("record.fsync_latency", result.record->fsync_latency);
+    }
+
+    if (result.playback) {
+        w.put("playback.speed", result.playback->speed);
+        w.put("playback.strategy", result.playback->strategy);
+        w.put("playback.displayed_fps", result.playback->displayed_fps);
+        w.put("playback.skipped_pct", result.playback->skipped_pct);
+    }
+
+    if (result.reverse) {
+        w.put("reverse.cache_frames", result.reverse->cache_frames);
+        w.put("reverse.cache_width", result.reverse->cache_width);
+        w.put("reverse.cache_mb_per_session", result.reverse->cache_mb_per_session);
+        w.put("reverse.rss_mb_per_session", result.reverse->rss_mb_per_session);
+        w.put("reverse.decode_ratio", result.reverse->decode_ratio);
+        w.put("reverse.chunks_per_sec", result.reverse->chunks_per_sec);
+    }
+
+    if (result.layers) {
+        w.put("layers.max_layer", result.layers->max_layer);
+        w.put("layers.highest_layer", result.layers->highest_layer);
+        w.put("layers.decoded_fps", result.layers->decoded_fps);
+        w.put("layers.dropped_pct", result.layers->dropped_pct);
+        w.put("layers.parse_ns_per_packet", result.layers->parse_ns_per_packet);
+        w.put("layers.parse_us_per_sec", result.layers->parse_us_per_sec);
+    }
+
+    if (result.power) {
+        w.put("power.cpu_latency_us", result.power->cpu_latency_us);
+        w.putBool("power.has_energy", result.power->has_energy);
+        w.put("power.package_watts", result.power->package_watts);
+        w.put("power.idle_entries_per_sec", result.power->idle_entries_per_sec);
+        // State names are driver-defined: one key each
+        w.put("power.cstate_count", result.power->cstate_names.size());
+        for (size_t i = 0; i < result.power->cstate_names.size(); i++) {
+            const std::string prefix = "power.cstate." + std::to_string(i);
+            w.put(prefix + ".name", result.power->cstate_names[i]);
+            w.put(prefix + ".latency_us", result.power->cstate_latency_us[i]);
+            w.put(prefix + ".residency_pct", result.power->cstate_residency_pct[i]);
+        }
+    }
+
+    if (result.mosaic) {
+        w.put("mosaic.canvas", result.mosaic->canvas);
+        w.put("mosaic.layout", result.mosaic->layout);
+        w.put("mosaic.tile_width", result.mosaic->tile_width);
+        w.put("mosaic.tile_height", result.mosaic->tile_height);
+        w.put("mosaic.fps", result.mosaic->fps);
+        w.put("mosaic.composites", result.mosaic->composites);
+        w.put("mosaic.slots", result.mosaic->slots);
+        w.put("mosaic.deadline_misses", result.mosaic->deadline_misses);
+        w.put("mosaic.stale_tile_pct", result.mosaic->stale_tile_pct);
+        w.putLatency("mosaic.compose", result.mosaic->compose);
+        w.putLatency("mosaic.tile_scale", result.mosaic->tile_scale);
+        w.putBool("mosaic.deadline_passed", result.mosaic->deadline_passed);
+    }
+
+    if (result.profile) {
+        w.put("profile.samples", result.profile->samples);
+        w.put("profile.dropped", result.profile->dropped);
+        w.put("profile.threads", result.profile->threads);
+        // Symbols may contain commas and spaces: one key each
+        w.put("profile.top_count", result.profile->top_symbols.size());
+        for (size_t i = 0; i < result.profile->top_symbols.size(); i++) {
+            const std::string prefix = "profile.top." + std::to_string(i);
+            w.put(prefix + ".symbol", result.profile->top_symbols[i]);
+            w.put(prefix + ".self_pct", result.profile->top_self_pct[i]);
+        }
+        w.put("profile.flat_path", result.profile->flat_path);
+        w.put("profile.folded_path", result.profile->folded_path);
+    }
+
+    return w.str();
+}
+
+std::optional<StreamTestResult> ResultSerializer::deserialize(const std::string& text) {
+    FieldReader r(text);
+    StreamTestResult result;
+
+    r.get("stream_count", result.stream_count);
+    r.get("fps_per_stream", result.fps_per_stream);
+    r.get("min_fps", result.min_fps);
+    r.get("max_fps", result.max_fps);
+    // Required: entries without it counted frames over the whole run
+    r.get("window_seconds", result.window_seconds);
+    r.get("legacy_fps_per_stream", result.legacy_fps_per_stream);
+    r.getList("per_stream_fps", result.per_stream_fps);
+    r.getList("per_stream_frames", result.per_stream_frames);
+    r.get("cpu_usage", result.cpu_usage);
+    r.get("memory_usage_mb", result.memory_usage_mb);
+    r.getBool("fps_passed", result.fps_passed);
+    r.getBool("cpu_passed", result.cpu_passed);
+    r.getBool("passed", result.passed);
+
+    // Entries written before lag classification have no lag block
+    if (r.has("lag.late_frames")) {
+        r.get("lag.late_frames", result.lag.late_frames);
+        r.get("lag.max_lag_ms", result.lag.max_lag_ms);
+        r.get("lag.slow_decode", result.lag.slow_decode);
+        r.get("lag.slow_decode_key", result.lag.slow_decode_key);
+        r.get("lag.slow_decode_delta", result.lag.slow_decode_delta);
+        r.get("lag.stage_work", result.lag.stage_work);
+        r.get("lag.reader_starved", result.lag.reader_starved);
+        r.get("lag.scheduler_delay", result.lag.scheduler_delay);
+        r.get("lag.oversleep", result.lag.oversleep);
+        r.getBool("lag.run_delay_available", result.lag.run_delay_available);
+    }
+    if (r.has("lag.lateness.count")) {
+        r.getLatency("lag.lateness", result.lag.lateness);
+    }
+
+    if (r.has("snapshot.taken")) {
+        SnapshotStats snap;
+        r.get("snapshot.taken", snap.taken);
+        r.get("snapshot.dropped", snap.dropped);
+        r.get("snapshot.avg_bytes", snap.avg_bytes);
+        r.getLatency("snapshot.latency", snap.latency);
+        result.snapshot = snap;
+    }
+
+    if (r.has("motion.frames_analyzed")) {
+        MotionStats motion;
+        r.get("motion.frames_analyzed", motion.frames_analyzed);
+        r.get("motion.motion_frames", motion.motion_frames);
+        r.getLatency("motion.cost", motion.cost);
+        r.get("motion.kernel", motion.kernel);
+        result.motion = motion;
+    }
+
+    if (r.has("switch.switches")) {
+        SwitchStats sw;
+        r.get("switch.switches", sw.switches);
+        r.getLatency("switch.latency", sw.latency);
+        r.get("switch.avg_cpu_ms", sw.avg_cpu_ms);
+        r.get("switch.avg_frames", sw.avg_frames);
+        r.get("switch.ring_kb_per_stream", sw.ring_kb_per_stream);
+        r.get("switch.ring_kb_total", sw.ring_kb_total);
+        result.channel_switch = sw;
+    }
+
+    if (r.has("hash.frames_checked")) {
+        HashCheckStats hash;
+        r.get("hash.frames_checked", hash.frames_checked);
+        r.get("hash.mismatches", hash.mismatches);
+        r.get("hash.unchecked", hash.unchecked);
+        r.getList("hash.per_stream_mismatches", hash.per_stream_mismatches);
+        r.getList("hash.per_stream_first_mismatch", hash.per_stream_first_mismatch);
+        r.getLatency("hash.cost", hash.cost);
+        r.get("hash.kernel", hash.kernel);
+        result.hash_check = hash;
+    }
+
+    if (r.has("batch.batch_size")) {
+        BatchStats batch;
+        r.get("batch.batch_size", batch.batch_size);
+        r.get("batch.frames_batched", batch.frames_batched);
+        r.get("batch.frames_dropped", batch.frames_dropped);
+        r.get("batch.full_batches", batch.full_batches);
+        r.get("batch.deadline_batches", batch.deadline_batches);
+        r.get("batch.batches_per_sec", batch.batches_per_sec);
+        r.getLatency("batch.assembly", batch.assembly);
+        r.getLatency("batch.convert", batch.convert);
+        r.get("batch.kernel", batch.kernel);
+        result.batch = batch;
+    }
+
+    if (r.has("harness.kb_per_stream")) {
+        HarnessStats harness;
+        r.get("harness.kb_per_stream", harness.kb_per_stream);
+        r.get("harness.readers", harness.readers);
+        r.get("harness.queue_size", harness.queue_size);
+        r.get("harness.fd_limit", harness.fd_limit);
+        result.harness = harness;
+    }
+
+    if (r.has("network.cpu_usage")) {
+        NetworkStats net;
+        r.get("network.cpu_usage", net.cpu_usage);
+        r.get("network.decode_cpu_usage", net.decode_cpu_usage);
+        r.get("network.rx_mbps", net.rx_mbps);
+        r.get("network.cpu_ms_per_mbit", net.cpu_ms_per_mbit);
+        r.get("network.core_pct_per_stream", net.core_pct_per_stream);
+        r.get("network.net_rx_softirqs", net.net_rx_softirqs);
+        r.get("network.nic_interrupts", net.nic_interrupts);
+        r.get("network.udp_in_datagrams", net.udp_in_datagrams);
+        r.get("network.udp_rcvbuf_errors", net.udp_rcvbuf_errors);
+        r.get("network.tcp_in_segs", net.tcp_in_segs);
+        result.network = net;
+    }
+
+    if (r.has("ingest.path")) {
+        IngestStats ingest;
+        r.get("ingest.path", ingest.path);
+        r.get("ingest.receiver_threads", ingest.receiver_threads);
+        r.get("ingest.recv_syscalls_per_sec", ingest.recv_syscalls_per_sec);
+        r.get("ingest.datagrams_per_sec", ingest.datagrams_per_sec);
+        r.get("ingest.stand_in_cpu_usage", ingest.stand_in_cpu_usage);
+        r.get("ingest.core_pct_per_stream", ingest.core_pct_per_stream);
+        r.get("ingest.reader_cpu_ms_per_mbit", ingest.reader_cpu_ms_per_mbit);
+        r.get("ingest.lost_packets", ingest.lost_packets);
+        r.get("ingest.dropped_units", ingest.dropped_units);
+        result.ingest = ingest;
+    }
+
+    if (r.has("segment.format")) {
+        SegmentStats segment;
+        r.get("segment.format", segment.format);
+        r.get("segment.segment_duration", segment.segment_duration);
+        r.get("segment.segments_fetched", segment.segments_fetched);
+        r.get("segment.manifest_fetches", segment.manifest_fetches);
+        r.get("segment.reader_cpu_ms_per_segment", segment.reader_cpu_ms_per_segment);
+        r.get("segment.server_cpu_usage", segment.server_cpu_usage);
+        result.segment = segment;
+    }
+
+    if (r.has("sched.decoder")) {
+        SchedStats sched;
+        r.get("sched.decoder", sched.decoder);
+        r.get("sched.reader", sched.reader);
+        r.get("sched.background", sched.background);
+        r.get("sched.background_streams", sched.background_streams);
+        r.get("sched.background_avg_fps", sched.background_avg_fps);
+        r.get("sched.background_min_fps", sched.background_min_fps);
+        result.sched = sched;
+    }
+
+    if (r.has("record.format")) {
+        RecordStats record;
+        r.get("record.format", record.format);
+        r.get("record.segment_seconds", record.segment_seconds);
+        r.get("record.fsync", record.fsync);
+        r.getBool("record.direct_io", record.direct_io);
+        r.get("record.bytes_written", record.bytes_written);
+        r.get("record.write_mb_per_sec", record.write_mb_per_sec);
+        r.get("record.segments", record.segments);
+        r.getLatency("record.fsync_latency", record.fsync_latency);
+        result.record = record;
+    }
+
+    if (r.has("playback.speed")) {
+        PlaybackStats playback;
+        r.get("playback.speed", playback.speed);
+        r.get("playback.strategy", playback.strategy);
+        r.get("playback.displayed_fps", playback.displayed_fps);
+        r.get("playback.skipped_pct", playback.skipped_pct);
+        result.playback = playback;
+    }
+
+    if (r.has("reverse.cache_frames")) {
+        ReverseStats reverse;
+        r.get("reverse.cache_frames", reverse.cache_frames);
+        r.get("reverse.cache_width", reverse.cache_width);
+        r.get("reverse.cache_mb_per_session", reverse.cache_mb_per_session);
+        r.get("reverse.rss_mb_per_session", reverse.rss_mb_per_session);
+        r.get("reverse.decode_ratio", reverse.decode_ratio);
+        r.get("reverse.chunks_per_sec", reverse.chunks_per_sec);
+        result.reverse = reverse;
+    }
+
+    if (r.has("layers.max_layer")) {
+        LayerStats layers;
+        r.get("layers.max_layer", layers.max_layer);
+        r.get("layers.highest_layer", layers.highest_layer);
+        r.get("layers.decoded_fps", layers.decoded_fps);
+        r.get("layers.dropped_pct", layers.dropped_pct);
+        r.get("layers.parse_ns_per_packet", layers.parse_ns_per_packet);
+        r.get("layers.parse_us_per_sec", layers.parse_us_per_sec);
+        result.layers = layers;
+    }
+
+    if (r.has("power.cpu_latency_us")) {
+        PowerStats power;
+        r.get("power.cpu_latency_us", power.cpu_latency_us);
+        r.getBool("power.has_energy", power.has_energy);
+        r.get("power.package_watts", power.package_watts);
+        r.get("power.idle_entries_per_sec", power.idle_entries_per_sec);
+        size_t cstate_count = 0;
+        r.get("power.cstate_count", cstate_count);
+        for (size_t i = 0; i < cstate_count; i++) {
+            const std::string prefix = "power.cstate." + std::to_string(i);
+            std::string name;
+            int latency_us = 0;
+            double residency_pct = 0.0;
+            r.get(prefix + ".name", name);
+            r.get(prefix + ".latency_us", latency_us);
+            r.get(prefix + ".residency_pct", residency_pct);
+            power.cstate_names.push_back(name);
+            power.cstate_latency_us.push_back(latency_us);
+            power.cstate_residency_pct.push_back(residency_pct);
+        }
+        result.power = power;
+    }
+
+    if (r.has("mosaic.canvas")) {
+        MosaicStats mosaic;
+        r.get("mosaic.canvas", mosaic.canvas);
+        r.get("mosaic.layout", mosaic.layout);
+        r.get("mosaic.tile_width", mosaic.tile_width);
+        r.get("mosaic.tile_height", mosaic.tile_height);
+        r.get("mosaic.fps", mosaic.fps);
+        r.get("mosaic.composites", mosaic.composites);
+        r.get("mosaic.slots", mosaic.slots);
+        r.get("mosaic.deadline_misses", mosaic.deadline_misses);
+        r.get("mosaic.stale_tile_pct", mosaic.stale_tile_pct);
+        r.getLatency("mosaic.compose", mosaic.compose);
+        r.getLatency("mosaic.tile_scale", mosaic.tile_scale);
+        r.getBool("mosaic.deadline_passed", mosaic.deadline_passed);
+        result.mosaic = mosaic;
+    }
+
+    if (r.has("profile.samples")) {
+        ProfileStats profile;
+        r.get("profile.samples", profile.samples);
+        r.get("profile.dropped", profile.dropped);
+        r.get("profile.threads", profile.threads);
+        size_t top_count = 0;
+        r.get("profile.top_count", top_count);
+        for (size_t i = 0; i < top_count; i++) {
+            const std::string prefix = "profile.top." + std::to_string(i);
+            std::string symbol;
+            double self_pct = 0.0;
+            r.get(prefix + ".symbol", symbol);
+            r.get(prefix + ".self_pct", self_pct);
+            profile.top_symbols.push_back(symbol);
+            profile.top_self_pct.push_back(self_pct);
+        }
+        r.get("profile.flat_path", profile.flat_path);
+        r.get("profile.folded_path", profile.folded_path);
+        result.profile = profile;
+    }
+
+    if (!r.ok()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::string ResultSerializer::serializeHost(const BenchmarkResult& result) {
+    FieldWriter w;
+    w.put("cpu_name", result.cpu_name);
+    w.put("thread_count", result.thread_count);
+    w.put("total_system_memory_mb", result.total_system_memory_mb);
+    w.put("video_path", result.video_path);
+    w.put("video_resolution", result.video_resolution);
+    w.put("codec_name", result.codec_name);
+    w.put("video_fps", result.video_fps);
+    w.putBool("is_live_stream", result.is_live_stream);
+    w.put("target_fps", result.target_fps);
+    return w.str();
+}
+
+bool ResultSerializer::deserializeHost(const std::string& text, BenchmarkResult& result) {
+    FieldReader r(text);
+    r.get("cpu_name", result.cpu_name);
+    r.get("thread_count", result.thread_count);
+    r.get("total_system_memory_mb", result.total_system_memory_mb);
+    r.get("video_path", result.video_path);
+    r.get("video_resolution", result.video_resolution);
+    r.get("codec_name", result.codec_name);
+    r.get("video_fps", result.video_fps);
+    r.getBool("is_live_stream", result.is_live_stream);
+    r.get("target_fps", result.target_fps);
+    return r.ok();
+}
+
+} // namespace video_bench
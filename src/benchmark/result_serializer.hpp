@@ -0,0 +1,28 @@
+#ifndef RESULT_SERIALIZER_HPP
+#define RESULT_SERIALIZER_HPP
+
+#include "benchmark/benchmark_result.hpp"
+#include <string>
+#include <optional>
+
+namespace video_bench {
+
+// Text serialization of a single stream count test result
+// Format: one "key=value" pair per line; vectors are comma-separated.
+// Used by the result cache and for shipping results between processes.
+class ResultSerializer {
+public:
+    static std::string serialize(const StreamTestResult& result);
+
+    // Returns nullopt if required fields are missing or malformed
+    static std::optional<StreamTestResult> deserialize(const std::string& text);
+
+    // Host, source and target FPS of a run (no test results), e.g. for a
+    // fleet agent's handshake; false if fields are missing or malformed
+    static std::string serializeHost(const BenchmarkResult& result);
+    static bool deserializeHost(const std::string& text, BenchmarkResult& result);
+};
+
+} // namespace video_bench
+
+#endif // RESULT_SERIALIZER_HPP
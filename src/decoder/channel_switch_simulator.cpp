@@ -0,0 +1,122 @@
+#include "decoder/channel_switch_simulator.hpp"
+#include "decoder/video_decoder.hpp"
+#include "utils/thread_cpu_time.hpp"
+#include <chrono>
+#include <algorithm>
+
+namespace video_bench {
+
+ChannelSwitchSimulator::ChannelSwitchSimulator(std::vector<GopCache*> caches,
+                                               double interval_seconds)
+    : caches_(std::move(caches))
+    , interval_seconds_(interval_seconds) {
+}
+
+ChannelSwitchSimulator::~ChannelSwitchSimulator() {
+    stop();
+}
+
+void ChannelSwitchSimulator::start() {
+    if (!thread_.joinable() && !caches_.empty()) {
+        thread_ = std::thread([this] { run(); });
+    }
+}
+
+void ChannelSwitchSimulator::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+SwitchCounters ChannelSwitchSimulator::getCounters() const {
+    std::lock_guard lock(mutex_);
+    return counters_;
+}
+
+std::string ChannelSwitchSimulator::getError() const {
+    std::lock_guard lock(mutex_);
+    return error_message_;
+}
+
+void ChannelSwitchSimulator::run() {
+    using Clock = std::chrono::steady_clock;
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(interval_seconds_));
+    auto next_switch = Clock::now() + interval;
+    size_t next_stream = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            if (cv_.wait_until(lock, next_switch, [this] { return stopping_; })) {
+                return;
+            }
+        }
+
+        if (!simulateSwitch(*caches_[next_stream])) {
+            return;
+        }
+
+        next_stream = (next_stream + 1) % caches_.size();
+        next_switch = std::max(next_switch + interval, Clock::now());
+    }
+}
+
+bool ChannelSwitchSimulator::simulateSwitch(GopCache& cache) {
+    using Clock = std::chrono::steady_clock;
+
+    auto request_time = Clock::now();
+    double cpu_start = threadCpuTimeMs();
+
+    // Packets from the last IDR up to "now"
+    std::vector<UniqueAVPacket> packets = cache.snapshot();
+    if (packets.empty()) {
+        return true;  // No keyframe seen yet on this stream
+    }
+
+    std::string error;
+    VideoDecoder decoder;
+    if (!decoder.initFromParams(cache.getCodecParameters(), error, 1, false)) {
+        std::lock_guard lock(mutex_);
+        error_message_ = "Switch: " + error;
+        return false;
+    }
+
+    int64_t frames = 0;
+    for (auto& packet : packets) {
+        SingleFrameResult result = decoder.decodeFromPacket(packet.get());
+        if (!result.error_message.empty()) {
+            std::lock_guard lock(mutex_);
+            error_message_ = "Switch: " + result.error_message;
+            return false;
+        }
+        if (result.success) {
+            frames++;
+        }
+    }
+
+    // Drain reordered frames; the last one is the "now" picture
+    while (decoder.flushDecoder().success) {
+        frames++;
+    }
+
+    double latency_ms = std::chrono::duration<double, std::milli>(
+        Clock::now() - request_time).count();
+    double cpu_ms = threadCpuTimeMs() - cpu_start;
+
+    std::lock_guard lock(mutex_);
+    counters_.switches++;
+    counters_.frames_decoded += frames;
+    counters_.cpu_ms += cpu_ms;
+    counters_.latency.add(latency_ms);
+    return true;
+}
+
+} // namespace video_bench
@@ -0,0 +1,70 @@
+#ifndef CHANNEL_SWITCH_SIMULATOR_HPP
+#define CHANNEL_SWITCH_SIMULATOR_HPP
+
+#include "decoder/gop_cache.hpp"
+#include "utils/latency_stats.hpp"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+
+namespace video_bench {
+
+// Statistics collected by the switch simulator
+struct SwitchCounters {
+    int64_t switches = 0;
+    int64_t frames_decoded = 0;    // Frames burst-decoded across all switches
+    double cpu_ms = 0.0;           // CPU time spent burst-decoding
+    LatencyRecorder latency;       // Request to "now" frame decoded, in ms
+};
+
+// Simulates live-view channel switches against per-stream GOP caches
+// Every interval it picks the next stream round-robin and burst-decodes
+// the cached packets from the last keyframe to the newest packet with a
+// fresh single-threaded decoder, like a client opening that camera.
+class ChannelSwitchSimulator {
+public:
+    ChannelSwitchSimulator(std::vector<GopCache*> caches, double interval_seconds);
+    ~ChannelSwitchSimulator();
+
+    // Non-copyable, non-movable (owns thread)
+    ChannelSwitchSimulator(const ChannelSwitchSimulator&) = delete;
+    ChannelSwitchSimulator& operator=(const ChannelSwitchSimulator&) = delete;
+    ChannelSwitchSimulator(ChannelSwitchSimulator&&) = delete;
+    ChannelSwitchSimulator& operator=(ChannelSwitchSimulator&&) = delete;
+
+    // Start issuing switch requests
+    void start();
+
+    // Stop and wait for an in-flight switch to finish
+    void stop();
+
+    // Get accumulated statistics (call after stop())
+    SwitchCounters getCounters() const;
+
+    // Get first decode error, empty if none
+    std::string getError() const;
+
+private:
+    void run();
+
+    // Burst-decode one stream's cached GOP; returns false on decoder error
+    bool simulateSwitch(GopCache& cache);
+
+    std::vector<GopCache*> caches_;
+    double interval_seconds_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    SwitchCounters counters_;
+    std::string error_message_;
+
+    std::thread thread_;
+};
+
+} // namespace video_bench
+
+#endif // CHANNEL_SWITCH_SIMULATOR_HPP
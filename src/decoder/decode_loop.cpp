@@ -0,0 +1,292 @@
+#include "decoder/decode_loop.hpp"
+#include "decoder/video_decoder.hpp"
+#include "decoder/packet_reader.hpp"
+#include <cmath>
+
+namespace video_bench {
+
+namespace {
+constexpr auto kPopTimeout = std::chrono::milliseconds(100);
+
+// Fastest playback speed per strategy
+constexpr int kFullDecodeMaxSpeed = 2;
+constexpr int kDropNonRefMaxSpeed = 8;
+
+// Stagger first slots per stream so cameras don't fire in lockstep
+constexpr double kGoldenRatioFraction = 0.6180339887;
+
+std::chrono::nanoseconds secondsToNs(double seconds) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(seconds));
+}
+} // namespace
+
+PacketPull QueuePacketSource::pull(AVPacket*& packet, std::string& error_message) {
+    auto packet_opt = queue_.pop(kPopTimeout);
+    if (!packet_opt) {
+        // Check for EOF or reader error; otherwise a timeout
+        if (!queue_.isEof()) {
+            return PacketPull::Timeout;
+        }
+        if (reader_ && reader_->hasError()) {
+            error_message = reader_->getError();
+            return PacketPull::Error;
+        }
+        return PacketPull::End;
+    }
+
+    // nullptr sentinel: the reader looped the file
+    packet = *packet_opt;
+    return packet ? PacketPull::Packet : PacketPull::Flush;
+}
+
+PlaybackStrategy playbackStrategyFor(int speed, bool intra_only) {
+    // Up to 2x the decoder keeps up with every frame; up to 8x dropping
+    // non-reference frames keeps motion smooth; beyond that only keyframes
+    if (speed <= kFullDecodeMaxSpeed) {
+        return PlaybackStrategy::FullDecode;
+    }
+    if (intra_only) {
+        return PlaybackStrategy::Decimate;
+    }
+    if (speed <= kDropNonRefMaxSpeed) {
+        return PlaybackStrategy::DropNonRef;
+    }
+    return PlaybackStrategy::KeyframesOnly;
+}
+
+std::string playbackStrategyName(PlaybackStrategy strategy) {
+    switch (strategy) {
+        case PlaybackStrategy::FullDecode: return "full";
+        case PlaybackStrategy::DropNonRef: return "nonref-drop";
+        case PlaybackStrategy::KeyframesOnly: return "keyframes";
+        case PlaybackStrategy::Decimate: return "decimate";
+    }
+    return "full";
+}
+
+int playbackDecimation(int speed) {
+    return std::max(1, (speed + kFullDecodeMaxSpeed - 1) / kFullDecodeMaxSpeed);
+}
+
+PacketPull PlaybackPacketSource::pull(AVPacket*& packet, std::string& error_message) {
+    while (true) {
+        PacketPull pulled = queue_source_.pull(packet, error_message);
+        if (pulled != PacketPull::Packet) {
+            return pulled;
+        }
+
+        media_frames_++;
+        if (window_ && window_->contains(MeasurementWindow::nowNs())) {
+            window_media_frames_++;
+        }
+        bool strategy_keeps = true;
+        if (strategy_ == PlaybackStrategy::KeyframesOnly) {
+            strategy_keeps = packet->flags & AV_PKT_FLAG_KEY;
+        } else if (strategy_ == PlaybackStrategy::Decimate) {
+            strategy_keeps = (media_frames_ - 1) % decimation_ == 0;
+        }
+        if (strategy_keeps && (!layer_filter_ || layer_filter_->keep(packet))) {
+            return PacketPull::Packet;
+        }
+        av_packet_free(&packet);
+        skipped_packets_++;
+    }
+}
+
+StageSink::StageSink(int thread_id, const StageSinkOptions& options)
+    : thread_id_(thread_id)
+    , options_(options) {
+    if (options_.snapshot_interval > 0.0) {
+        snapshot_interval_ = secondsToNs(options_.snapshot_interval);
+        if (!options_.snapshot_pool) {
+            snapshot_encoder_ = std::make_unique<SnapshotEncoder>(options_.snapshot_width);
+        }
+    }
+    if (options_.motion_fps > 0.0) {
+        motion_interval_ = secondsToNs(1.0 / options_.motion_fps);
+        motion_detector_ = std::make_unique<MotionDetector>(options_.motion_downsample);
+    }
+    if (options_.batcher) {
+        infer_interval_ = secondsToNs(1.0 / options_.infer_fps);
+    }
+}
+
+StageSink::~StageSink() = default;
+
+bool StageSink::anyEnabled(const StageSinkOptions& options) {
+    return options.snapshot_interval > 0.0 || options.motion_fps > 0.0 ||
+           options.batcher != nullptr || options.reference_hashes != nullptr ||
+           options.mosaic != nullptr;
+}
+
+void StageSink::start(LoopClock::time_point start_time) {
+    const double stagger = std::fmod(1.0 + thread_id_ * kGoldenRatioFraction, 1.0);
+    next_snapshot_time_ = start_time + std::chrono::duration_cast<std::chrono::nanoseconds>(
+        snapshot_interval_ * stagger);
+    next_motion_time_ = start_time;
+    next_infer_time_ = start_time + std::chrono::duration_cast<std::chrono::nanoseconds>(
+        infer_interval_ * stagger);
+}
+
+bool StageSink::consume(const AVFrame* frame, std::string& error_message) {
+    // Snapshot stage: grab the current frame every snapshot_interval
+    if (options_.snapshot_interval > 0.0 && LoopClock::now() >= next_snapshot_time_) {
+        // Skip missed slots instead of bursting when decoding runs late
+        next_snapshot_time_ = std::max(next_snapshot_time_ + snapshot_interval_,
+                                       LoopClock::now());
+        if (options_.snapshot_pool) {
+            options_.snapshot_pool->submit(frame);
+        } else {
+            auto snapshot_start = LoopClock::now();
+            int64_t size = snapshot_encoder_->encode(frame, error_message);
+            if (size < 0) {
+                return false;
+            }
+            snapshots_.taken++;
+            snapshots_.bytes += size;
+            snapshots_.latency.add(std::chrono::duration<double, std::milli>(
+                LoopClock::now() - snapshot_start).count());
+        }
+    }
+
+    // Hash output and compare against the reference frame at this index
+    if (options_.reference_hashes) {
+        constexpr size_t kMaxReportedMismatches = 16;
+        const std::vector<uint64_t>& reference = *options_.reference_hashes;
+        auto hash_start = LoopClock::now();
+        uint64_t hash = frame_hasher_.hashFrame(frame);
+        if (loop_frame_index_ < static_cast<int64_t>(reference.size())) {
+            hash_check_.frames_checked++;
+            if (hash != reference[loop_frame_index_]) {
+                hash_check_.mismatches++;
+                if (hash_check_.mismatch_frames.size() < kMaxReportedMismatches) {
+                    hash_check_.mismatch_frames.push_back(loop_frame_index_);
+                }
+            }
+        } else {
+            hash_check_.unchecked++;
+        }
+        hash_check_.cost.add(std::chrono::duration<double, std::milli>(
+            LoopClock::now() - hash_start).count());
+    }
+    loop_frame_index_++;
+
+    // Motion detection at a configurable rate
+    if (motion_detector_) {
+        auto motion_start = LoopClock::now();
+        if (motion_start >= next_motion_time_) {
+            next_motion_time_ = std::max(next_motion_time_ + motion_interval_, motion_start);
+            if (motion_detector_->process(frame)) {
+                motion_.motion_frames++;
+            }
+            motion_.frames_analyzed++;
+            motion_.cost.add(std::chrono::duration<double, std::milli>(
+                LoopClock::now() - motion_start).count());
+        }
+    }
+
+    // Inference batching: the batcher drops frames when it falls behind
+    if (options_.batcher && LoopClock::now() >= next_infer_time_) {
+        next_infer_time_ = std::max(next_infer_time_ + infer_interval_, LoopClock::now());
+        options_.batcher->submit(frame);
+    }
+
+    // Mosaic: every frame is scaled into this stream's tile
+    if (options_.mosaic && !options_.mosaic->updateTile(thread_id_, frame, error_message)) {
+        return false;
+    }
+    return true;
+}
+
+template <typename Pacer, typename Source, typename Sink, typename Recorder>
+bool runDecodeLoop(VideoDecoder& decoder, Pacer& pacer, Source& source, Sink& sink,
+                   Recorder& recorder, const std::atomic<bool>& stop_flag,
+                   std::atomic<int64_t>& frames_decoded, int64_t& total_frames,
+                   std::string& error_message) {
+    constexpr int kBatchSize = 16;
+
+    const auto start_time = LoopClock::now();
+    pacer.start(start_time);
+    sink.start(start_time);
+    recorder.start();
+
+    while (true) {
+        if ((total_frames % kBatchSize) == 0) {
+            if (stop_flag.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        AVPacket* packet = nullptr;
+        recorder.beforeWait();
+        PacketPull pulled = source.pull(packet, error_message);
+        recorder.afterWait();
+
+        switch (pulled) {
+            case PacketPull::Packet:
+                break;
+            case PacketPull::Flush:
+                decoder.flushBuffers();
+                sink.onLoopRestart();
+                continue;
+            case PacketPull::Timeout:
+                continue;
+            case PacketPull::End:
+                return true;
+            case PacketPull::Error:
+                return false;
+        }
+
+        // Decode from packet (may produce 0 or 1 frame due to B-frames)
+        recorder.onDecodeInput(packet->flags & AV_PKT_FLAG_KEY);
+        recorder.beforeDecode();
+        SingleFrameResult result = decoder.decodeFromPacket(packet);
+        recorder.afterDecode();
+        av_packet_free(&packet);
+
+        if (!result.error_message.empty()) {
+            error_message = result.error_message;
+            return false;
+        }
+
+        if (!result.success) {
+            // No frame yet (need more packets) - continue without timing
+            continue;
+        }
+
+        total_frames++;
+        if ((total_frames % kBatchSize) == 0) {
+            frames_decoded.store(total_frames, std::memory_order_relaxed);
+        }
+        recorder.onFrame(decoder.getFrame());
+
+        recorder.beforeSink();
+        const bool consumed = sink.consume(decoder.getFrame(), error_message);
+        recorder.afterSink();
+        if (!consumed) {
+            return false;
+        }
+
+        recorder.onPaced(pacer.pace());
+    }
+}
+
+// The combinations in use; see DecoderThread::run() and LoopMicrobench
+template bool runDecodeLoop<RealTimePacer, QueuePacketSource, StageSink, InstrumentedRecorder>(
+    VideoDecoder&, RealTimePacer&, QueuePacketSource&, StageSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+template bool runDecodeLoop<RealTimePacer, QueuePacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, RealTimePacer&, QueuePacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+template bool runDecodeLoop<PlaybackPacer, PlaybackPacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, PlaybackPacer&, PlaybackPacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+template bool runDecodeLoop<FreeRunPacer, MemoryPacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, FreeRunPacer&, MemoryPacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+template bool runDecodeLoop<FreeRunPacer, MemoryPacketSource, NullSink, BareRecorder>(
+    VideoDecoder&, FreeRunPacer&, MemoryPacketSource&, NullSink&, BareRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+
+} // namespace video_bench
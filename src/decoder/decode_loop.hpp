@@ -0,0 +1,402 @@
+#ifndef DECODE_LOOP_HPP
+#define DECODE_LOOP_HPP
+
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "decoder/lag_classifier.hpp"
+#include "decoder/measurement_window.hpp"
+#include "decoder/packet_queue.hpp"
+#include "decoder/temporal_layer_filter.hpp"
+#include "pipeline/snapshot_stage.hpp"
+#include "pipeline/motion_detector.hpp"
+#include "pipeline/frame_hasher.hpp"
+#include "pipeline/inference_batcher.hpp"
+#include "pipeline/mosaic_compositor.hpp"
+#include "utils/latency_stats.hpp"
+
+namespace video_bench {
+
+class VideoDecoder;
+class PacketReader;
+
+// The per-frame decode loop is a template over four policies. What is fixed
+// at compile time is which policy runs: NullSink or StageSink, and the
+// pacer/source pair (real-time from a queue, fast-forward, or free-running
+// from memory). StageSink::consume still checks per stage at run time which
+// stages are enabled, and production streams always use InstrumentedRecorder;
+// BareRecorder only serves the loop microbenchmark and the canary.
+//   Pacer     start(t), pace() -> PaceResult     frame timing
+//   Source    pull(packet, error) -> PacketPull  where packets come from
+//   Sink      start(t), consume(frame, error), onLoopRestart()
+//   Recorder  start(), before/after Wait/Decode/Sink, onDecodeInput(key),
+//             onFrame(frame), onPaced(r)
+// Only the combinations instantiated in decode_loop.cpp exist; a caller
+// picks one once, at thread start.
+
+using LoopClock = std::chrono::steady_clock;
+
+// Outcome of pacing one frame
+struct PaceResult {
+    double lateness_ms = 0.0;   // Past the frame's deadline (0 if on time)
+    double oversleep_ms = 0.0;  // Woke up this late from the pacing sleep
+    bool late = false;          // Beyond the lag tolerance
+};
+
+// Fast-forward playback strategy, picked from the speed
+enum class PlaybackStrategy {
+    FullDecode,     // Every frame, decoded at speed times the frame rate
+    DropNonRef,     // The decoder skips non-reference frames
+    KeyframesOnly,  // Only keyframe packets reach the decoder
+    Decimate        // Intra-only codecs: every Nth packet reaches the decoder
+};
+
+// intra_only: every frame is a keyframe (MJPEG), so keyframes-only would
+// decode them all; such streams are decimated instead
+PlaybackStrategy playbackStrategyFor(int speed, bool intra_only);
+// Decimate: packets per kept packet, so decoding stays at the full-decode limit
+int playbackDecimation(int speed);
+std::string playbackStrategyName(PlaybackStrategy strategy);
+
+// Real-time pacing: sleep until each frame's deadline; a late frame resets
+// the schedule instead of bursting to catch up
+class RealTimePacer {
+public:
+    explicit RealTimePacer(double target_fps)
+        : frame_interval_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::duration<double>(1.0 / target_fps))) {}
+
+    void start(LoopClock::time_point start_time) { next_frame_time_ = start_time; }
+
+    PaceResult pace() { return paceBy(1); }
+
+    // Pace a frame that advances the schedule by frames intervals
+    PaceResult paceBy(int64_t frames) {
+        PaceResult result;
+        next_frame_time_ += frame_interval_ * frames;
+        auto now = LoopClock::now();
+        if (now > next_frame_time_) {
+            result.lateness_ms = std::chrono::duration<double, std::milli>(
+                now - next_frame_time_).count();
+        }
+
+        if (now > next_frame_time_ + kLagTolerance) {
+            result.late = true;
+            lag_count_++;
+            max_lag_ms_ = std::max(max_lag_ms_, result.lateness_ms);
+            next_frame_time_ = now;
+        } else if (now < next_frame_time_) {
+            std::this_thread::sleep_until(next_frame_time_);
+            result.oversleep_ms = std::chrono::duration<double, std::milli>(
+                LoopClock::now() - next_frame_time_).count();
+        }
+        return result;
+    }
+
+    int64_t getLagCount() const { return lag_count_; }
+    double getMaxLagMs() const { return max_lag_ms_; }
+
+private:
+    static constexpr auto kLagTolerance = std::chrono::milliseconds(1);
+
+    std::chrono::nanoseconds frame_interval_;
+    LoopClock::time_point next_frame_time_;
+    int64_t lag_count_ = 0;
+    double max_lag_ms_ = 0.0;
+};
+
+// No pacing: decode as fast as possible (loop microbenchmark)
+class FreeRunPacer {
+public:
+    void start(LoopClock::time_point) {}
+    PaceResult pace() { return {}; }
+};
+
+// What a source produced
+enum class PacketPull { Packet, Flush, Timeout, End, Error };
+
+// Packets from a PacketQueue filled by a reader thread
+class QueuePacketSource {
+public:
+    // reader: the stream's own reader, checked for errors at EOF
+    // (nullptr with a shared reader, which reports its own)
+    QueuePacketSource(PacketQueue& queue, const PacketReader* reader)
+        : queue_(queue), reader_(reader) {}
+
+    PacketPull pull(AVPacket*& packet, std::string& error_message);
+
+private:
+    PacketQueue& queue_;
+    const PacketReader* reader_;
+};
+
+// Packets cloned from an in-memory list, looped with a flush between
+// passes like a looping file (no I/O, no queue); ends after max_packets
+class MemoryPacketSource {
+public:
+    MemoryPacketSource(const std::vector<AVPacket*>& packets, int64_t max_packets)
+        : packets_(packets), remaining_(max_packets) {}
+
+    PacketPull pull(AVPacket*& packet, std::string& error_message) {
+        if (packets_.empty() || remaining_ <= 0) {
+            return PacketPull::End;
+        }
+        if (next_ == packets_.size()) {
+            next_ = 0;
+            return PacketPull::Flush;
+        }
+        packet = av_packet_clone(packets_[next_++]);
+        if (!packet) {
+            error_message = "Failed to clone packet";
+            return PacketPull::Error;
+        }
+        remaining_--;
+        return PacketPull::Packet;
+    }
+
+private:
+    const std::vector<AVPacket*>& packets_;
+    int64_t remaining_;
+    size_t next_ = 0;
+};
+
+// Fast-forward playback from a stream's queue: every packet pulled counts
+// as one frame of media time; with KeyframesOnly or Decimate the other
+// packets are dropped here, before the decoder sees them, and so are
+// packets the temporal layer filter rejects (at any speed, including 1x)
+class PlaybackPacketSource {
+public:
+    // window: media frames pulled while it is open are counted separately
+    // decimation: with Decimate, packets per kept packet
+    // layer_filter: nullptr = keep every layer
+    PlaybackPacketSource(PacketQueue& queue, const PacketReader* reader,
+                         PlaybackStrategy strategy, int decimation,
+                         const MeasurementWindow* window,
+                         TemporalLayerFilter* layer_filter = nullptr)
+        : queue_source_(queue, reader), strategy_(strategy), decimation_(decimation)
+        , window_(window), layer_filter_(layer_filter) {}
+
+    PacketPull pull(AVPacket*& packet, std::string& error_message);
+
+    int64_t getMediaFrames() const { return media_frames_; }
+    int64_t getWindowMediaFrames() const { return window_media_frames_; }
+    int64_t getSkippedPackets() const { return skipped_packets_; }
+
+private:
+    QueuePacketSource queue_source_;
+    PlaybackStrategy strategy_;
+    int decimation_;
+    const MeasurementWindow* window_;
+    TemporalLayerFilter* layer_filter_;
+    int64_t media_frames_ = 0;
+    int64_t window_media_frames_ = 0;
+    int64_t skipped_packets_ = 0;
+};
+
+// Fast-forward pacing on the media clock: a shown frame is due when the
+// media pulled up to it has played at speed times the frame rate, however
+// many frames were skipped on the way
+class PlaybackPacer {
+public:
+    PlaybackPacer(double target_fps, int speed, const PlaybackPacketSource& source)
+        : pacer_(target_fps * speed), source_(source) {}
+
+    void start(LoopClock::time_point start_time) { pacer_.start(start_time); }
+
+    PaceResult pace() {
+        const int64_t media_frames = source_.getMediaFrames();
+        PaceResult result = pacer_.paceBy(media_frames - paced_media_frames_);
+        paced_media_frames_ = media_frames;
+        return result;
+    }
+
+    int64_t getLagCount() const { return pacer_.getLagCount(); }
+    double getMaxLagMs() const { return pacer_.getMaxLagMs(); }
+
+private:
+    RealTimePacer pacer_;
+    const PlaybackPacketSource& source_;
+    int64_t paced_media_frames_ = 0;
+};
+
+// No per-frame consumers
+class NullSink {
+public:
+    void start(LoopClock::time_point) {}
+    bool consume(const AVFrame*, std::string&) { return true; }
+    void onLoopRestart() {}
+};
+
+// Per-stream stages on each decoded frame: snapshots, hash verification,
+// motion detection, inference batching and the mosaic tile, each at its own rate
+struct StageSinkOptions {
+    double snapshot_interval = 0.0;  // Seconds (0 = off)
+    int snapshot_width = 320;
+    SnapshotWorkerPool* snapshot_pool = nullptr;  // nullptr = inline encoder
+    double motion_fps = 0.0;  // 0 = off
+    int motion_downsample = 4;
+    InferenceBatcher* batcher = nullptr;  // nullptr = off
+    double infer_fps = 0.0;
+    const std::vector<uint64_t>* reference_hashes = nullptr;  // nullptr = off
+    MosaicCompositor* mosaic = nullptr;  // nullptr = off; tile = thread_id
+};
+
+class StageSink {
+public:
+    // thread_id staggers the first snapshot and inference slot per stream
+    StageSink(int thread_id, const StageSinkOptions& options);
+    ~StageSink();
+
+    // Whether any stage is enabled (NullSink otherwise)
+    static bool anyEnabled(const StageSinkOptions& options);
+
+    void start(LoopClock::time_point start_time);
+    bool consume(const AVFrame* frame, std::string& error_message);
+    void onLoopRestart() { loop_frame_index_ = 0; }
+
+    const SnapshotCounters& getSnapshots() const { return snapshots_; }
+    const MotionCounters& getMotion() const { return motion_; }
+    const HashCheckCounters& getHashCheck() const { return hash_check_; }
+
+private:
+    int thread_id_;
+    StageSinkOptions options_;
+    std::chrono::nanoseconds snapshot_interval_{0};
+    std::chrono::nanoseconds motion_interval_{0};
+    std::chrono::nanoseconds infer_interval_{0};
+    LoopClock::time_point next_snapshot_time_;
+    LoopClock::time_point next_motion_time_;
+    LoopClock::time_point next_infer_time_;
+
+    std::unique_ptr<SnapshotEncoder> snapshot_encoder_;
+    std::unique_ptr<MotionDetector> motion_detector_;
+    FrameHasher frame_hasher_;
+    int64_t loop_frame_index_ = 0;
+
+    SnapshotCounters snapshots_;
+    MotionCounters motion_;
+    HashCheckCounters hash_check_;
+};
+
+// No instrumentation beyond the frame count
+class BareRecorder {
+public:
+    void start() {}
+    void beforeWait() {}
+    void afterWait() {}
+    void beforeDecode() {}
+    void afterDecode() {}
+    void onDecodeInput(bool) {}
+    void beforeSink() {}
+    void afterSink() {}
+    void onFrame(const AVFrame*) {}
+    void onPaced(const PaceResult&) {}
+};
+
+// Full per-frame instrumentation: measurement window count, lateness
+// distribution inside the window and late frame root causes (queue wait, decode time,
+// stage time, run-queue wait and oversleep per frame cycle, see LagClassifier).
+// Construct on the decoder thread (the classifier reads its schedstat).
+class InstrumentedRecorder {
+public:
+    // window: nullptr counts no window frames
+    InstrumentedRecorder(const MeasurementWindow* window,
+                         std::atomic<int64_t>& window_frames,
+                         LatencyHistogram& lateness)
+        : window_(window), window_frames_out_(window_frames), lateness_(lateness) {}
+
+    void start() { cycle_run_delay_base_ = lag_classifier_.runDelayMs(); }
+
+    void beforeWait() { wait_start_ = LoopClock::now(); }
+    void afterWait() {
+        cycle_.queue_wait_ms += std::chrono::duration<double, std::milli>(
+            LoopClock::now() - wait_start_).count();
+    }
+
+    void beforeDecode() { decode_start_ = LoopClock::now(); }
+    void afterDecode() {
+        cycle_.decode_ms += std::chrono::duration<double, std::milli>(
+            LoopClock::now() - decode_start_).count();
+    }
+
+    void beforeSink() { sink_start_ = LoopClock::now(); }
+    void afterSink() {
+        cycle_.stage_ms += std::chrono::duration<double, std::milli>(
+            LoopClock::now() - sink_start_).count();
+    }
+
+    // The input about to be timed: a frame's cycle can span several decode calls
+    void onDecodeInput(bool keyframe) { cycle_.keyframe = cycle_.keyframe || keyframe; }
+
+    void onFrame(const AVFrame*) {
+        if (window_ && window_->contains(MeasurementWindow::nowNs())) {
+            window_frames_out_.store(++window_frames_, std::memory_order_relaxed);
+        }
+    }
+
+    void onPaced(const PaceResult& result) {
+        if (window_ && window_->contains(MeasurementWindow::nowNs())) {
+            lateness_.add(result.lateness_ms);
+        }
+        if (result.late) {
+            cycle_.run_delay_ms = lag_classifier_.runDelayMs() - cycle_run_delay_base_;
+            lag_classifier_.classify(cycle_);
+        }
+        // The next frame's cycle starts after pacing
+        cycle_ = FrameCycle{};
+        cycle_.oversleep_ms = result.oversleep_ms;
+        cycle_run_delay_base_ = lag_classifier_.runDelayMs();
+    }
+
+    bool hasRunDelay() const { return lag_classifier_.hasRunDelay(); }
+    const LagCounters& getLagCauses() const { return lag_classifier_.getCounters(); }
+
+private:
+    const MeasurementWindow* window_;
+    std::atomic<int64_t>& window_frames_out_;
+    LatencyHistogram& lateness_;
+    int64_t window_frames_ = 0;
+
+    LagClassifier lag_classifier_;
+    FrameCycle cycle_;
+    double cycle_run_delay_base_ = 0.0;
+    LoopClock::time_point wait_start_;
+    LoopClock::time_point decode_start_;
+    LoopClock::time_point sink_start_;
+};
+
+// Decode until stop_flag is set or the source ends.
+// total_frames counts frames as they are decoded and is published to
+// frames_decoded every few frames. Returns false on a source, decode or
+// sink error.
+template <typename Pacer, typename Source, typename Sink, typename Recorder>
+bool runDecodeLoop(VideoDecoder& decoder, Pacer& pacer, Source& source, Sink& sink,
+                   Recorder& recorder, const std::atomic<bool>& stop_flag,
+                   std::atomic<int64_t>& frames_decoded, int64_t& total_frames,
+                   std::string& error_message);
+
+// Instantiated in decode_loop.cpp
+extern template bool runDecodeLoop<RealTimePacer, QueuePacketSource, StageSink, InstrumentedRecorder>(
+    VideoDecoder&, RealTimePacer&, QueuePacketSource&, StageSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+extern template bool runDecodeLoop<RealTimePacer, QueuePacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, RealTimePacer&, QueuePacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+extern template bool runDecodeLoop<PlaybackPacer, PlaybackPacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, PlaybackPacer&, PlaybackPacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+extern template bool runDecodeLoop<FreeRunPacer, MemoryPacketSource, NullSink, InstrumentedRecorder>(
+    VideoDecoder&, FreeRunPacer&, MemoryPacketSource&, NullSink&, InstrumentedRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+extern template bool runDecodeLoop<FreeRunPacer, MemoryPacketSource, NullSink, BareRecorder>(
+    VideoDecoder&, FreeRunPacer&, MemoryPacketSource&, NullSink&, BareRecorder&,
+    const std::atomic<bool>&, std::atomic<int64_t>&, int64_t&, std::string&);
+
+} // namespace video_bench
+
+#endif // DECODE_LOOP_HPP
@@ -1,4 +1,5 @@
 #include "decoder/decoder_thread.hpp"
+#include "decoder/decode_loop.hpp"
 #include "decoder/video_decoder.hpp"
 #include "decoder/packet_queue.hpp"
 #include "decoder/packet_reader.hpp"
@@ -13,7 +14,8 @@ DecoderThread::DecoderThread(int thread_id,
                              int decoder_thread_count,
                              bool is_live_stream,
                              std::barrier<>& start_barrier,
-                             std::atomic<bool>& stop_flag)
+                             std::atomic<bool>& stop_flag,
+                             const DecoderThreadOptions& options)
     : thread_id_(thread_id)
     , video_path_(video_path)
     , target_fps_(target_fps)
@@ -21,6 +23,7 @@ DecoderThread::DecoderThread(int thread_id,
     , is_live_stream_(is_live_stream)
     , start_barrier_(start_barrier)
     , stop_flag_(stop_flag)
+    , options_(options)
     , thread_([this] { run(); }) {
 }
 
@@ -34,6 +37,10 @@ int64_t DecoderThread::getFramesDecoded() const {
     return frames_decoded_.load(std::memory_order_relaxed);
 }
 
+int64_t DecoderThread::getWindowFrames() const {
+    return window_frames_.load(std::memory_order_relaxed);
+}
+
 DecoderThreadResult DecoderThread::getResult() const {
     return {
         thread_id_,
@@ -42,7 +49,19 @@ DecoderThreadResult DecoderThread::getResult() const {
         !has_error_.load(),
         error_message_,
         lag_count_,
-        max_lag_ms_
+        max_lag_ms_,
+        snapshots_,
+        motion_,
+        hash_check_,
+        reader_cpu_ms_,
+        reader_bytes_,
+        lag_causes_,
+        run_delay_available_,
+        window_frames_.load(),
+        lateness_,
+        window_media_frames_,
+        reverse_,
+        layer_filter_
     };
 }
 
@@ -58,26 +77,46 @@ void DecoderThread::join() {
 
 void DecoderThread::run() {
     using Clock = std::chrono::steady_clock;
-    using Nanoseconds = std::chrono::nanoseconds;
-    using namespace std::chrono_literals;
-
-    // Create packet queue for pipeline
-    PacketQueue queue(32);
-
-    // Create and initialize reader first (opens single connection)
-    PacketReader reader(video_path_, queue, stop_flag_, is_live_stream_);
 
     std::string error;
-    if (!reader.init(error)) {
+
+    // Before the decoder opens, so its FFmpeg worker threads inherit it
+    if (!applySchedPolicy(options_.sched, error)) {
         error_message_ = error;
         has_error_.store(true, std::memory_order_release);
         start_barrier_.arrive_and_wait();
         return;
     }
 
+    if (options_.reverse_keyframes) {
+        runReverse();
+        return;
+    }
+
+    // Use the shared reader's queue, or create a queue and reader of our own
+    PacketQueue* queue = options_.packet_queue;
+    const AVCodecParameters* codec_params = options_.codec_params;
+    std::unique_ptr<PacketQueue> own_queue;
+    std::unique_ptr<PacketReader> reader;
+    if (!queue) {
+        own_queue = std::make_unique<PacketQueue>(options_.queue_size);
+        queue = own_queue.get();
+
+        // Create and initialize reader first (opens single connection)
+        reader = std::make_unique<PacketReader>(video_path_, *queue, stop_flag_,
+                                                is_live_stream_, options_.rtsp_transport);
+        if (!reader->init(error)) {
+            error_message_ = error;
+            has_error_.store(true, std::memory_order_release);
+            start_barrier_.arrive_and_wait();
+            return;
+        }
+        codec_params = reader->getCodecParameters();
+    }
+
     // Create decoder from reader's codec parameters (no separate connection)
     VideoDecoder decoder;
-    if (!decoder.initFromParams(reader.getCodecParameters(), error,
+    if (!decoder.initFromParams(codec_params, error,
                                 decoder_thread_count_, is_live_stream_)) {
         error_message_ = error;
         has_error_.store(true, std::memory_order_release);
@@ -85,94 +124,119 @@ void DecoderThread::run() {
         return;
     }
 
-    // Start reader thread
-    std::thread reader_thread([&reader] { reader.run(); });
-
-    // Calculate frame interval
-    const auto frame_interval = std::chrono::duration_cast<Nanoseconds>(
-        std::chrono::duration<double>(1.0 / target_fps_));
-    const auto lag_tolerance = std::chrono::milliseconds(1);
-
-    // Wait for all threads to be ready
-    start_barrier_.arrive_and_wait();
-
-    auto start_time = Clock::now();
-    auto next_frame_time = start_time;
-    int64_t total_frames = 0;
-
-    constexpr int kBatchSize = 16;
-
-    // Decode at real-time pace until stop flag is set
-    while (true) {
-        if ((total_frames % kBatchSize) == 0) {
-            if (stop_flag_.load(std::memory_order_relaxed)) {
-                break;
-            }
-        }
-
-        // Get packet from queue
-        auto packet_opt = queue.pop(100ms);
-
-        if (!packet_opt) {
-            // Check for EOF or reader error
-            if (queue.isEof()) {
-                if (reader.hasError()) {
-                    error_message_ = reader.getError();
-                    has_error_.store(true, std::memory_order_release);
-                }
-                break;
-            }
-            // Timeout - check stop flag and continue
-            continue;
+    // Temporal layers are read from the packet headers of this codec
+    std::optional<TemporalLayerFilter> layer_filter;
+    if (options_.temporal_layer >= 0) {
+        layer_filter.emplace(options_.temporal_layer);
+        if (!layer_filter->init(codec_params, error)) {
+            error_message_ = error;
+            has_error_.store(true, std::memory_order_release);
+            start_barrier_.arrive_and_wait();
+            return;
         }
+    }
 
-        AVPacket* packet = *packet_opt;
-
-        // Check for flush marker (nullptr sentinel from reader on file loop)
-        if (!packet) {
-            decoder.flushBuffers();
-            continue;
+    // Feed the GOP ring with every packet read for this stream
+    // (a shared reader's owner or the batched receiver registers it itself)
+    if (options_.gop_cache && reader) {
+        options_.gop_cache->setCodecParameters(codec_params);
+        reader->addObserver(options_.gop_cache);
+    }
+    if (options_.recorder && reader) {
+        if (!options_.recorder->onStreamStart(codec_params, reader->getTimeBase(), error)) {
+            error_message_ = error;
+            has_error_.store(true, std::memory_order_release);
+            start_barrier_.arrive_and_wait();
+            return;
         }
+        reader->addObserver(options_.recorder);
+    }
 
-        // Decode from packet (may produce 0 or 1 frame due to B-frames)
-        SingleFrameResult result = decoder.decodeFromPacket(packet);
-        av_packet_free(&packet);
+    // Start reader thread
+    std::thread reader_thread;
+    if (reader) {
+        reader_thread = std::thread([&reader, this] {
+            // Permission was checked before the test; a failure keeps the default
+            std::string sched_error;
+            applySchedPolicy(options_.reader_sched, sched_error);
+            reader->run();
+        });
+    }
 
-        if (!result.error_message.empty()) {
-            error_message_ = result.error_message;
-            has_error_.store(true, std::memory_order_release);
-            break;
-        }
+    // Pick the loop instantiation once: streams without stages get the
+    // NullSink loop, with no per-frame checks for disabled stages
+    StageSinkOptions stage_options;
+    stage_options.snapshot_interval = options_.snapshot_interval;
+    stage_options.snapshot_width = options_.snapshot_width;
+    stage_options.snapshot_pool = options_.snapshot_pool;
+    stage_options.motion_fps = options_.motion_fps;
+    stage_options.motion_downsample = options_.motion_downsample;
+    stage_options.batcher = options_.batcher;
+    stage_options.infer_fps = options_.infer_fps;
+    stage_options.reference_hashes = options_.reference_hashes;
+    stage_options.mosaic = options_.mosaic;
+    std::optional<StageSink> stage_sink;
+    if (StageSink::anyEnabled(stage_options)) {
+        stage_sink.emplace(thread_id_, stage_options);
+    }
 
-        if (!result.success) {
-            // No frame yet (need more packets) - continue without timing
-            continue;
+    RealTimePacer pacer(target_fps_);
+    QueuePacketSource source(*queue, reader.get());
+    InstrumentedRecorder recorder(options_.window, window_frames_, lateness_);
+    run_delay_available_ = recorder.hasRunDelay();
+
+    // Fast-forward playback and temporal layer pruning replace the real-time
+    // pacer and queue source (no stages: the parser rejects them with either)
+    std::optional<PlaybackPacketSource> playback_source;
+    std::optional<PlaybackPacer> playback_pacer;
+    if (options_.playback_speed > 0 || layer_filter) {
+        const int speed = std::max(1, options_.playback_speed);
+        PlaybackStrategy strategy = playbackStrategyFor(speed, options_.intra_only);
+        if (strategy == PlaybackStrategy::DropNonRef) {
+            decoder.setSkipFrame(AVDISCARD_NONREF);
         }
+        playback_source.emplace(*queue, reader.get(), strategy, playbackDecimation(speed),
+                                options_.window, layer_filter ? &*layer_filter : nullptr);
+        playback_pacer.emplace(target_fps_, speed, *playback_source);
+    }
 
-        total_frames++;
+    // Wait for all threads to be ready
+    start_barrier_.arrive_and_wait();
 
-        if ((total_frames % kBatchSize) == 0) {
-            frames_decoded_.store(total_frames, std::memory_order_relaxed);
-        }
+    auto start_time = Clock::now();
+    int64_t total_frames = 0;
 
-        // Timing/pacing
-        next_frame_time += frame_interval;
-        auto now = Clock::now();
-
-        if (now > next_frame_time + lag_tolerance) {
-            lag_count_++;
-            double lag_ms = std::chrono::duration<double, std::milli>(
-                now - next_frame_time).count();
-            if (lag_ms > max_lag_ms_) {
-                max_lag_ms_ = lag_ms;
-            }
-            next_frame_time = now;
-        } else if (now < next_frame_time) {
-            std::this_thread::sleep_until(next_frame_time);
+    // Decode at real-time pace until stop flag is set
+    bool loop_ok;
+    if (playback_pacer) {
+        NullSink null_sink;
+        loop_ok = runDecodeLoop(decoder, *playback_pacer, *playback_source, null_sink, recorder,
+                                stop_flag_, frames_decoded_, total_frames, error);
+        window_media_frames_ = playback_source->getWindowMediaFrames();
+        if (layer_filter) {
+            layer_filter_ = layer_filter->getCounters();
         }
+    } else if (stage_sink) {
+        loop_ok = runDecodeLoop(decoder, pacer, source, *stage_sink, recorder,
+                                stop_flag_, frames_decoded_, total_frames, error);
+        snapshots_ = stage_sink->getSnapshots();
+        motion_ = stage_sink->getMotion();
+        hash_check_ = stage_sink->getHashCheck();
+    } else {
+        NullSink null_sink;
+        loop_ok = runDecodeLoop(decoder, pacer, source, null_sink, recorder,
+                                stop_flag_, frames_decoded_, total_frames, error);
     }
+    if (!loop_ok) {
+        error_message_ = error;
+        has_error_.store(true, std::memory_order_release);
+    }
+    lag_count_ = playback_pacer ? playback_pacer->getLagCount() : pacer.getLagCount();
+    max_lag_ms_ = playback_pacer ? playback_pacer->getMaxLagMs() : pacer.getMaxLagMs();
+    lag_causes_ = recorder.getLagCauses();
 
     // Flush decoder to get remaining buffered frames
+    // (they complete after the stop signal, so never inside the window)
     while (true) {
         SingleFrameResult result = decoder.flushDecoder();
         if (!result.success) {
@@ -190,7 +254,68 @@ void DecoderThread::run() {
         final_fps_ = static_cast<double>(total_frames) / elapsed;
     }
 
-    reader_thread.join();
+    if (reader_thread.joinable()) {
+        reader_thread.join();
+        reader_cpu_ms_ = reader->getCpuMs();
+        reader_bytes_ = reader->getBytesRead();
+    }
+}
+
+void DecoderThread::runReverse() {
+    std::string error;
+
+    // The player opens and seeks the file itself; no reader thread
+    ReversePlayerOptions reverse_options;
+    reverse_options.cache_frames = options_.reverse_cache_frames;
+    reverse_options.scale_width = options_.reverse_width;
+    ReversePlayer player(*options_.reverse_keyframes, reverse_options);
+    if (!player.open(video_path_, decoder_thread_count_, error)) {
+        error_message_ = error;
+        has_error_.store(true, std::memory_order_release);
+        start_barrier_.arrive_and_wait();
+        return;
+    }
+
+    RealTimePacer pacer(target_fps_);
+    InstrumentedRecorder recorder(options_.window, window_frames_, lateness_);
+    run_delay_available_ = recorder.hasRunDelay();
+
+    start_barrier_.arrive_and_wait();
+
+    auto start_time = LoopClock::now();
+    pacer.start(start_time);
+    recorder.start();
+    int64_t total_frames = 0;
+
+    // Chunk decodes count as decode time of the frame that needed them;
+    // every chunk starts from a keyframe
+    while (!stop_flag_.load(std::memory_order_relaxed)) {
+        const int64_t chunks = player.getCounters().chunks;
+        recorder.beforeDecode();
+        const AVFrame* frame = player.nextFrame(error);
+        recorder.afterDecode();
+        recorder.onDecodeInput(player.getCounters().chunks != chunks);
+        if (!frame) {
+            error_message_ = error;
+            has_error_.store(true, std::memory_order_release);
+            break;
+        }
+
+        total_frames++;
+        frames_decoded_.store(total_frames, std::memory_order_relaxed);
+        recorder.onFrame(frame);
+        recorder.onPaced(pacer.pace());
+    }
+
+    lag_count_ = pacer.getLagCount();
+    max_lag_ms_ = pacer.getMaxLagMs();
+    lag_causes_ = recorder.getLagCauses();
+    reverse_ = player.getCounters();
+
+    double elapsed = std::chrono::duration<double>(LoopClock::now() - start_time).count();
+    if (elapsed > 0) {
+        final_fps_ = static_cast<double>(total_frames) / elapsed;
+    }
 }
 
 } // namespace video_bench
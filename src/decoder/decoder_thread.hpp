@@ -8,6 +8,19 @@
 #include <barrier>
 #include <functional>
 #include <optional>
+#include "pipeline/snapshot_stage.hpp"
+#include "pipeline/motion_detector.hpp"
+#include "pipeline/frame_hasher.hpp"
+#include "pipeline/inference_batcher.hpp"
+#include "pipeline/mosaic_compositor.hpp"
+#include "decoder/gop_cache.hpp"
+#include "decoder/lag_classifier.hpp"
+#include "decoder/measurement_window.hpp"
+#include "decoder/packet_queue.hpp"
+#include "decoder/reverse_player.hpp"
+#include "decoder/temporal_layer_filter.hpp"
+#include "utils/latency_stats.hpp"
+#include "utils/thread_scheduling.hpp"
 
 namespace video_bench {
 
@@ -20,6 +33,84 @@ struct DecoderThreadResult {
     std::string error_message;
     int64_t lag_count;    // Number of frames that were late
     double max_lag_ms;    // Maximum lag in milliseconds
+    SnapshotCounters snapshots;  // Inline snapshot stage statistics
+    MotionCounters motion;       // Motion detection statistics
+    HashCheckCounters hash_check;  // Output hash verification statistics
+    double reader_cpu_ms;   // Own reader thread CPU time (0 with a shared reader)
+    int64_t reader_bytes;   // Video bytes read by the own reader
+    LagCounters lag_causes;     // Late frames by root cause
+    bool run_delay_available;   // Scheduler delay could be measured
+    int64_t window_frames;      // Frames completed inside the measurement window
+    LatencyHistogram lateness;  // Per frame in the window: ms past its deadline
+    int64_t window_media_frames;  // Playback and layer pruning: media frames inside the window
+    ReverseCounters reverse;      // Reverse playback statistics
+    LayerFilterCounters layer_filter;  // Temporal layer pruning statistics
+};
+
+// Optional per-stream stages attached to the decode loop
+struct DecoderThreadOptions {
+    // Common measurement window; frames are counted by completion time
+    // (nullptr = count only frames_decoded)
+    const MeasurementWindow* window = nullptr;
+
+    // Depth of the stream's own packet queue
+    size_t queue_size = 32;
+
+    // Packets from a shared reader instead of a per-stream one (nullptr = own)
+    // The reader owner keeps queue and codec parameters alive and runs the reader
+    PacketQueue* packet_queue = nullptr;
+    const AVCodecParameters* codec_params = nullptr;
+
+    // RTP transport the stream's own reader requests from an RTSP server
+    std::string rtsp_transport = "tcp";
+
+    // Scheduling of the decoder thread (and the FFmpeg workers it creates)
+    // and of the stream's own reader thread
+    SchedPolicy sched;
+    SchedPolicy reader_sched;
+
+    // Snapshot stage: JPEG thumbnail every snapshot_interval seconds (0 = off)
+    double snapshot_interval = 0.0;
+    int snapshot_width = 320;
+    // Shared encoder pool; nullptr encodes inline on the decoder thread
+    SnapshotWorkerPool* snapshot_pool = nullptr;
+
+    // Motion detection: analyze up to motion_fps frames per second (0 = off)
+    double motion_fps = 0.0;
+    int motion_downsample = 4;
+
+    // Shared inference batcher fed up to infer_fps frames per second (nullptr = off)
+    InferenceBatcher* batcher = nullptr;
+    double infer_fps = 0.0;
+
+    // Shared video wall canvas; the stream writes its frames into tile
+    // thread_id (nullptr = off)
+    MosaicCompositor* mosaic = nullptr;
+
+    // GOP ring fed by this stream's reader (nullptr = off)
+    GopCache* gop_cache = nullptr;
+
+    // Segment recorder fed by this stream's reader (nullptr = off)
+    PacketObserver* recorder = nullptr;
+
+    // Fast-forward playback at this multiple of target_fps (0 = off); the
+    // strategy follows from the speed (see playbackStrategyFor())
+    int playback_speed = 0;
+    bool intra_only = false;  // Every frame is a keyframe (MJPEG)
+
+    // Drop packets of temporal layers above this before decoding (-1 = off);
+    // paced on the media clock like playback at 1x
+    int temporal_layer = -1;
+
+    // Reverse playback of the file with this keyframe index instead of the
+    // packet pipeline (nullptr = off); each stream opens the file itself
+    const std::vector<int64_t>* reverse_keyframes = nullptr;
+    int reverse_cache_frames = 120;
+    int reverse_width = 0;  // 0 = cache frames at decoded size
+
+    // Reference frame hashes for one loop of the source (nullptr = off)
+    // Each decoded frame is hashed and compared by index within the loop
+    const std::vector<uint64_t>* reference_hashes = nullptr;
 };
 
 // A worker thread that continuously decodes video
@@ -31,7 +122,8 @@ public:
                   int decoder_thread_count,
                   bool is_live_stream,
                   std::barrier<>& start_barrier,
-                  std::atomic<bool>& stop_flag);
+                  std::atomic<bool>& stop_flag,
+                  const DecoderThreadOptions& options = {});
 
     ~DecoderThread();
 
@@ -44,6 +136,9 @@ public:
     // Get accumulated frames decoded so far
     int64_t getFramesDecoded() const;
 
+    // Get frames completed inside the measurement window so far
+    int64_t getWindowFrames() const;
+
     // Get result after thread has stopped
     DecoderThreadResult getResult() const;
 
@@ -55,6 +150,7 @@ public:
 
 private:
     void run();
+    void runReverse();
 
     int thread_id_;
     std::string video_path_;
@@ -63,13 +159,26 @@ private:
     bool is_live_stream_;
     std::barrier<>& start_barrier_;
     std::atomic<bool>& stop_flag_;
+    DecoderThreadOptions options_;
 
     std::atomic<int64_t> frames_decoded_{0};
+    std::atomic<int64_t> window_frames_{0};
     std::atomic<bool> has_error_{false};
     std::string error_message_;
     double final_fps_ = 0.0;
     int64_t lag_count_ = 0;
     double max_lag_ms_ = 0.0;
+    SnapshotCounters snapshots_;
+    MotionCounters motion_;
+    HashCheckCounters hash_check_;
+    double reader_cpu_ms_ = 0.0;
+    int64_t reader_bytes_ = 0;
+    LagCounters lag_causes_;
+    bool run_delay_available_ = false;
+    LatencyHistogram lateness_;
+    int64_t window_media_frames_ = 0;
+    ReverseCounters reverse_;
+    LayerFilterCounters layer_filter_;
 
     std::thread thread_;
 };
@@ -0,0 +1,79 @@
+#include "decoder/gop_cache.hpp"
+#include <algorithm>
+
+namespace video_bench {
+
+GopCache::GopCache()
+    : codec_params_(avcodec_parameters_alloc()) {
+}
+
+GopCache::~GopCache() {
+    std::lock_guard lock(mutex_);
+    clearLocked();
+    avcodec_parameters_free(&codec_params_);
+}
+
+bool GopCache::setCodecParameters(const AVCodecParameters* params) {
+    if (!codec_params_ || !params) {
+        return false;
+    }
+    return avcodec_parameters_copy(codec_params_, params) >= 0;
+}
+
+void GopCache::onPacket(const AVPacket* packet) {
+    const bool is_key = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+
+    std::lock_guard lock(mutex_);
+    if (is_key) {
+        clearLocked();
+    } else if (packets_.empty()) {
+        // No keyframe yet: nothing decodable to cache
+        return;
+    }
+
+    AVPacket* ref = av_packet_clone(packet);
+    if (!ref) {
+        return;
+    }
+    packets_.push_back(ref);
+    bytes_ += sizeof(AVPacket) + static_cast<size_t>(ref->size);
+    peak_bytes_ = std::max(peak_bytes_, bytes_);
+}
+
+void GopCache::onDiscontinuity() {
+    std::lock_guard lock(mutex_);
+    clearLocked();
+}
+
+std::vector<UniqueAVPacket> GopCache::snapshot() const {
+    std::vector<UniqueAVPacket> result;
+    std::lock_guard lock(mutex_);
+    result.reserve(packets_.size());
+    for (const AVPacket* packet : packets_) {
+        UniqueAVPacket ref(av_packet_clone(packet));
+        if (ref) {
+            result.push_back(std::move(ref));
+        }
+    }
+    return result;
+}
+
+size_t GopCache::getBytes() const {
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+size_t GopCache::getPeakBytes() const {
+    std::lock_guard lock(mutex_);
+    return peak_bytes_;
+}
+
+void GopCache::clearLocked() {
+    for (AVPacket* packet : packets_) {
+        av_packet_free(&packet);
+    }
+    packets_.clear();
+    bytes_ = 0;
+}
+
+} // namespace video_bench
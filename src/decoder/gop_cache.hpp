@@ -0,0 +1,54 @@
+#ifndef GOP_CACHE_HPP
+#define GOP_CACHE_HPP
+
+#include "decoder/packet_observer.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <vector>
+#include <mutex>
+#include <string>
+#include <cstddef>
+
+namespace video_bench {
+
+// Per-stream ring of refcounted packets since the last keyframe
+// Fed by the PacketReader; lets a viewer start decoding instantly on a
+// channel switch instead of waiting for the next IDR.
+class GopCache : public PacketObserver {
+public:
+    GopCache();
+    ~GopCache() override;
+
+    // Non-copyable, non-movable
+    GopCache(const GopCache&) = delete;
+    GopCache& operator=(const GopCache&) = delete;
+    GopCache(GopCache&&) = delete;
+    GopCache& operator=(GopCache&&) = delete;
+
+    // Store codec parameters needed to decode the cached packets
+    bool setCodecParameters(const AVCodecParameters* params);
+    const AVCodecParameters* getCodecParameters() const { return codec_params_; }
+
+    // PacketObserver: keyframes start a new GOP, other packets are appended
+    void onPacket(const AVPacket* packet) override;
+    void onDiscontinuity() override;
+
+    // Take new references to all packets from the last keyframe to now
+    std::vector<UniqueAVPacket> snapshot() const;
+
+    // Memory held by the ring (payload + packet structs) in bytes
+    size_t getBytes() const;
+    size_t getPeakBytes() const;
+
+private:
+    void clearLocked();
+
+    mutable std::mutex mutex_;
+    std::vector<AVPacket*> packets_;
+    size_t bytes_ = 0;
+    size_t peak_bytes_ = 0;
+    AVCodecParameters* codec_params_ = nullptr;
+};
+
+} // namespace video_bench
+
+#endif // GOP_CACHE_HPP
@@ -0,0 +1,97 @@
+#include "decoder/lag_classifier.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace video_bench {
+
+LagClassifier::LagClassifier() {
+#if defined(__linux__)
+    // Per-thread: cpu time (ns), run-queue wait (ns), timeslices
+    schedstat_fd_ = open("/proc/thread-self/schedstat", O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+LagClassifier::~LagClassifier() {
+#if defined(__linux__)
+    if (schedstat_fd_ >= 0) {
+        close(schedstat_fd_);
+    }
+#endif
+}
+
+double LagClassifier::runDelayMs() const {
+#if defined(__linux__)
+    if (schedstat_fd_ < 0) {
+        return 0.0;
+    }
+    char buf[96];
+    ssize_t n = pread(schedstat_fd_, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) {
+        return 0.0;
+    }
+    buf[n] = '\0';
+    char* end = nullptr;
+    std::strtoull(buf, &end, 10);  // Skip cpu time
+    unsigned long long run_delay_ns = std::strtoull(end, nullptr, 10);
+    return static_cast<double>(run_delay_ns) / 1e6;
+#else
+    return 0.0;
+#endif
+}
+
+LagCause LagClassifier::classify(const FrameCycle& cycle) {
+    // Run-queue waits inside the decode call or the stages are wall time
+    // there too; taken from the decode time first
+    const double decode_ms = std::max(0.0, cycle.decode_ms - cycle.run_delay_ms);
+    const double stage_ms = std::max(
+        0.0, cycle.stage_ms - std::max(0.0, cycle.run_delay_ms - cycle.decode_ms));
+
+    LagCause cause = LagCause::SlowDecode;
+    double largest = decode_ms;
+    if (stage_ms > largest) {
+        cause = LagCause::StageWork;
+        largest = stage_ms;
+    }
+    if (cycle.queue_wait_ms > largest) {
+        cause = LagCause::ReaderStarved;
+        largest = cycle.queue_wait_ms;
+    }
+    if (cycle.run_delay_ms > largest) {
+        cause = LagCause::SchedulerDelay;
+        largest = cycle.run_delay_ms;
+    }
+    if (cycle.oversleep_ms > largest) {
+        cause = LagCause::Oversleep;
+    }
+
+    switch (cause) {
+        case LagCause::SlowDecode:
+            counters_.slow_decode++;
+            if (cycle.keyframe) {
+                counters_.slow_decode_key++;
+            } else {
+                counters_.slow_decode_delta++;
+            }
+            break;
+        case LagCause::StageWork:
+            counters_.stage_work++;
+            break;
+        case LagCause::ReaderStarved:
+            counters_.reader_starved++;
+            break;
+        case LagCause::SchedulerDelay:
+            counters_.scheduler_delay++;
+            break;
+        case LagCause::Oversleep:
+            counters_.oversleep++;
+            break;
+    }
+    return cause;
+}
+
+} // namespace video_bench
@@ -0,0 +1,79 @@
+#ifndef LAG_CLASSIFIER_HPP
+#define LAG_CLASSIFIER_HPP
+
+#include "utils/ffmpeg_utils.hpp"
+#include <cstdint>
+
+namespace video_bench {
+
+// Where a late frame's time went
+enum class LagCause { SlowDecode, StageWork, ReaderStarved, SchedulerDelay, Oversleep };
+
+// Late frames per root cause (per stream or merged per test)
+struct LagCounters {
+    int64_t slow_decode = 0;
+    int64_t slow_decode_key = 0;    // Slow decode with a keyframe packet sent
+    int64_t slow_decode_delta = 0;  // ...with only non-key packets sent
+    int64_t stage_work = 0;         // Per-frame stages on the decoder thread
+    int64_t reader_starved = 0;
+    int64_t scheduler_delay = 0;
+    int64_t oversleep = 0;
+
+    void merge(const LagCounters& other) {
+        slow_decode += other.slow_decode;
+        slow_decode_key += other.slow_decode_key;
+        slow_decode_delta += other.slow_decode_delta;
+        stage_work += other.stage_work;
+        reader_starved += other.reader_starved;
+        scheduler_delay += other.scheduler_delay;
+        oversleep += other.oversleep;
+    }
+};
+
+// Time spent in one frame's pacing cycle, from the end of the previous
+// frame's pacing to this frame's deadline check (all in ms)
+struct FrameCycle {
+    double queue_wait_ms = 0.0;  // Blocked in PacketQueue::pop()
+    double decode_ms = 0.0;      // Inside the decode call(s) for this frame
+    double stage_ms = 0.0;       // Inside the frame sink (snapshot, hash, motion, tile)
+    double run_delay_ms = 0.0;   // Runnable but waiting for a CPU (schedstat)
+    double oversleep_ms = 0.0;   // Woke up late from the previous pacing sleep
+    // A keyframe packet was sent to the decoder in this cycle. Not the output
+    // frame's type: with frame threads or reordering that is an earlier frame
+    bool keyframe = false;
+};
+
+// Attributes each late frame to the largest contributor in its cycle.
+// Scheduler delay comes from the run-queue wait in the calling thread's
+// schedstat (Linux); elsewhere it is never reported.
+// Construct and use on the decoder thread being classified.
+class LagClassifier {
+public:
+    LagClassifier();
+    ~LagClassifier();
+
+    // Non-copyable, non-movable (owns a file descriptor)
+    LagClassifier(const LagClassifier&) = delete;
+    LagClassifier& operator=(const LagClassifier&) = delete;
+    LagClassifier(LagClassifier&&) = delete;
+    LagClassifier& operator=(LagClassifier&&) = delete;
+
+    // Whether scheduler delay can be measured on this system
+    bool hasRunDelay() const { return schedstat_fd_ >= 0; }
+
+    // Cumulative run-queue wait of the calling thread in ms (0 if unavailable)
+    double runDelayMs() const;
+
+    // Count a late frame under its dominant cause
+    LagCause classify(const FrameCycle& cycle);
+
+    const LagCounters& getCounters() const { return counters_; }
+
+private:
+    int schedstat_fd_ = -1;
+    LagCounters counters_;
+};
+
+} // namespace video_bench
+
+#endif // LAG_CLASSIFIER_HPP
@@ -0,0 +1,43 @@
+#ifndef MEASUREMENT_WINDOW_HPP
+#define MEASUREMENT_WINDOW_HPP
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+
+namespace video_bench {
+
+// Common [start, end) measurement window for all decoder threads of a test.
+// Threads count a frame only if its completion timestamp falls inside, so
+// frames finished before the start or drained after the stop signal are
+// excluded. Bounds are steady_clock nanoseconds; reads are lock-free.
+class MeasurementWindow {
+public:
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void open() { start_ns_.store(nowNs(), std::memory_order_release); }
+    void close() { end_ns_.store(nowNs(), std::memory_order_release); }
+
+    bool contains(int64_t t_ns) const {
+        return t_ns >= start_ns_.load(std::memory_order_acquire) &&
+               t_ns < end_ns_.load(std::memory_order_acquire);
+    }
+
+    // Window length in seconds (valid after close())
+    double seconds() const {
+        return static_cast<double>(end_ns_.load() - start_ns_.load()) / 1e9;
+    }
+
+private:
+    // Empty until opened: nothing is counted before open()
+    std::atomic<int64_t> start_ns_{std::numeric_limits<int64_t>::max()};
+    std::atomic<int64_t> end_ns_{std::numeric_limits<int64_t>::max()};
+};
+
+} // namespace video_bench
+
+#endif // MEASUREMENT_WINDOW_HPP
@@ -0,0 +1,38 @@
+#ifndef PACKET_OBSERVER_HPP
+#define PACKET_OBSERVER_HPP
+
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace video_bench {
+
+// Receives every video packet read by a PacketReader (on the reader thread)
+// Used by stages that need the compressed stream alongside decoding
+class PacketObserver {
+public:
+    virtual ~PacketObserver() = default;
+
+    // Called by the reader's owner before the first packet with the stream's
+    // codec parameters and timestamp time base; false fails the stream
+    virtual bool onStreamStart(const AVCodecParameters* codec_params, AVRational time_base,
+                               std::string& error_message) {
+        (void)codec_params;
+        (void)time_base;
+        (void)error_message;
+        return true;
+    }
+
+    // Called for each video packet before it is queued; must not keep the
+    // pointer (take a reference with av_packet_ref/clone if needed)
+    virtual void onPacket(const AVPacket* packet) = 0;
+
+    // Called when the stream restarts (file loop); decoder state is reset
+    virtual void onDiscontinuity() {}
+};
+
+} // namespace video_bench
+
+#endif // PACKET_OBSERVER_HPP
@@ -1,4 +1,5 @@
 #include "decoder/packet_reader.hpp"
+#include "utils/thread_cpu_time.hpp"
 #include <chrono>
 
 namespace video_bench {
@@ -6,16 +7,18 @@ namespace video_bench {
 PacketReader::PacketReader(const std::string& path,
                            PacketQueue& queue,
                            std::atomic<bool>& stop_flag,
-                           bool is_live_stream)
+                           bool is_live_stream,
+                           const std::string& rtsp_transport)
     : path_(path)
-    , queue_(queue)
+    , queues_{&queue}
     , stop_flag_(stop_flag)
     , is_live_stream_(is_live_stream)
+    , rtsp_transport_(rtsp_transport)
     , packet_(av_packet_alloc()) {
 }
 
 bool PacketReader::init(std::string& error_message) {
-    AVDictionary* options = is_live_stream_ ? createRtspOptions() : nullptr;
+    AVDictionary* options = is_live_stream_ ? createRtspOptions(rtsp_transport_) : nullptr;
 
     // Open input
     AVFormatContext* format_ctx_raw = nullptr;
@@ -61,6 +64,8 @@ bool PacketReader::init(std::string& error_message) {
 void PacketReader::run() {
     using namespace std::chrono_literals;
 
+    const double cpu_start = threadCpuTimeMs();
+
     while (!stop_flag_.load(std::memory_order_relaxed)) {
         int ret = av_read_frame(format_ctx_.get(), packet_.get());
 
@@ -74,8 +79,13 @@ void PacketReader::run() {
                 }
                 // File mode: seek to start and continue
                 avformat_seek_file(format_ctx_.get(), -1, INT64_MIN, 0, INT64_MAX, 0);
-                // Signal decoder to flush stale reference frames before new loop
-                queue_.pushFlushMarker(100ms);
+                for (PacketObserver* observer : observers_) {
+                    observer->onDiscontinuity();
+                }
+                // Signal decoders to flush stale reference frames before new loop
+                for (PacketQueue* queue : queues_) {
+                    pushFlushMarker(*queue);
+                }
                 continue;
             } else {
                 error_message_ = "Read error: " + ffmpegErrorString(ret);
@@ -86,23 +96,58 @@ void PacketReader::run() {
 
         // Only queue video packets
         if (packet_->stream_index == video_stream_index_) {
-            // Push with timeout to allow checking stop flag
-            if (!queue_.push(packet_.get(), 100ms)) {
-                av_packet_unref(packet_.get());
-                // Check if we should stop
-                if (stop_flag_.load(std::memory_order_relaxed)) {
+            bytes_read_ += packet_->size;
+            for (PacketObserver* observer : observers_) {
+                observer->onPacket(packet_.get());
+            }
+
+            // Every queue must get the packet; dropping one corrupts decoding
+            bool stopped = false;
+            for (PacketQueue* queue : queues_) {
+                if (!pushPacket(*queue)) {
+                    stopped = true;
                     break;
                 }
-                // Queue might be full, retry
-                continue;
+            }
+            if (stopped) {
+                av_packet_unref(packet_.get());
+                break;
             }
         }
 
         av_packet_unref(packet_.get());
     }
 
-    // Signal EOF to decoder
-    queue_.signalEof();
+    // Signal EOF to decoders
+    for (PacketQueue* queue : queues_) {
+        queue->signalEof();
+    }
+
+    cpu_ms_ = threadCpuTimeMs() - cpu_start;
+}
+
+bool PacketReader::pushPacket(PacketQueue& queue) {
+    using namespace std::chrono_literals;
+
+    // Push with timeout to allow checking stop flag; low-fps streams can
+    // keep a queue full for longer than one timeout
+    while (!queue.push(packet_.get(), 100ms)) {
+        if (stop_flag_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PacketReader::pushFlushMarker(PacketQueue& queue) {
+    using namespace std::chrono_literals;
+
+    while (!queue.pushFlushMarker(100ms)) {
+        if (stop_flag_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool PacketReader::hasError() const {
@@ -121,4 +166,16 @@ const AVCodecParameters* PacketReader::getCodecParameters() const {
     return codec_params_;
 }
 
+AVRational PacketReader::getTimeBase() const {
+    return format_ctx_->streams[video_stream_index_]->time_base;
+}
+
+void PacketReader::addObserver(PacketObserver* observer) {
+    observers_.push_back(observer);
+}
+
+void PacketReader::addQueue(PacketQueue& queue) {
+    queues_.push_back(&queue);
+}
+
 } // namespace video_bench
@@ -3,19 +3,23 @@
 
 #include "utils/ffmpeg_utils.hpp"
 #include "decoder/packet_queue.hpp"
+#include "decoder/packet_observer.hpp"
 #include <string>
 #include <atomic>
+#include <vector>
 
 namespace video_bench {
 
 // I/O-dedicated reader that reads packets from video source
 // Runs in a separate thread to decouple I/O from decoding
+// Can fan out to several queues so one demuxer feeds a group of decoders
 class PacketReader {
 public:
     PacketReader(const std::string& path,
                  PacketQueue& queue,
                  std::atomic<bool>& stop_flag,
-                 bool is_live_stream);
+                 bool is_live_stream,
+                 const std::string& rtsp_transport = "tcp");
 
     // Initialize the reader (open file/stream, find video stream)
     bool init(std::string& error_message);
@@ -35,16 +39,39 @@ public:
     // Get codec parameters for the video stream (valid after init())
     const AVCodecParameters* getCodecParameters() const;
 
+    // Time base of the video stream's packet timestamps (valid after init())
+    AVRational getTimeBase() const;
+
+    // CPU time of the reader thread and video bytes read (valid after run())
+    // Covers socket reads, TLS decryption and demuxing for live sources
+    double getCpuMs() const { return cpu_ms_; }
+    int64_t getBytesRead() const { return bytes_read_; }
+
+    // Attach an observer that sees every video packet (call before run())
+    void addObserver(PacketObserver* observer);
+
+    // Also deliver every packet to another decoder queue (call before run())
+    // Packets share the same refcounted buffer, so fan-out costs no copies
+    void addQueue(PacketQueue& queue);
+
 private:
+    // Push to one queue, retrying while it is full; false if stopped
+    bool pushPacket(PacketQueue& queue);
+    bool pushFlushMarker(PacketQueue& queue);
+
     std::string path_;
-    PacketQueue& queue_;
+    std::vector<PacketQueue*> queues_;
     std::atomic<bool>& stop_flag_;
     bool is_live_stream_;
+    std::string rtsp_transport_;
     int video_stream_index_ = -1;
 
     UniqueAVFormatContext format_ctx_;
     UniqueAVPacket packet_;
     const AVCodecParameters* codec_params_ = nullptr;
+    std::vector<PacketObserver*> observers_;
+    double cpu_ms_ = 0.0;
+    int64_t bytes_read_ = 0;
 
     std::atomic<bool> has_error_{false};
     std::string error_message_;
@@ -0,0 +1,237 @@
+#include "decoder/reverse_player.hpp"
+#include <algorithm>
+#include <limits>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/imgutils.h>
+}
+
+namespace video_bench {
+
+namespace {
+int64_t frameBytes(const AVFrame* frame) {
+    int size = av_image_get_buffer_size(static_cast<AVPixelFormat>(frame->format),
+                                        frame->width, frame->height, 1);
+    return size > 0 ? size : 0;
+}
+} // namespace
+
+ReversePlayer::ReversePlayer(const std::vector<int64_t>& keyframes,
+                             const ReversePlayerOptions& options)
+    : keyframes_(keyframes)
+    , options_(options) {
+}
+
+bool ReversePlayer::open(const std::string& video_path, int thread_count,
+                         std::string& error_message) {
+    if (keyframes_.empty()) {
+        error_message = "Reverse: no keyframe index";
+        return false;
+    }
+    return decoder_.open(video_path, error_message, thread_count, false);
+}
+
+const AVFrame* ReversePlayer::nextFrame(std::string& error_message) {
+    if (current_) {
+        recycle(std::move(current_));
+    }
+    if (cache_.empty() && !decodeChunk(error_message)) {
+        return nullptr;
+    }
+
+    current_ = std::move(cache_.back());
+    cache_.pop_back();
+    cache_bytes_ -= frameBytes(current_.get());
+    counters_.frames_shown++;
+    return current_.get();
+}
+
+bool ReversePlayer::decodeChunk(std::string& error_message) {
+    if (at_end_) {
+        gop_ = keyframes_.size() - 1;
+        chunk_end_ = std::numeric_limits<int64_t>::max();
+        at_end_ = false;
+    }
+
+    // Back to the GOP holding the frames just before the ones shown
+    while (gop_ > 0 && keyframes_[gop_] >= chunk_end_) {
+        gop_--;
+    }
+    const int64_t gop_start = keyframes_[gop_];
+    if (!decoder_.seekToKeyframe(gop_start)) {
+        error_message = "Reverse: seek to keyframe at " + std::to_string(gop_start) + " failed";
+        return false;
+    }
+    counters_.chunks++;
+
+    while (true) {
+        SingleFrameResult result = decoder_.decodeNextFrame();
+        if (!result.error_message.empty()) {
+            error_message = "Reverse: " + result.error_message;
+            return false;
+        }
+        if (!result.success) {
+            break;  // End of file
+        }
+        counters_.frames_decoded++;
+
+        // Frames come out in presentation order
+        const AVFrame* frame = decoder_.getFrame();
+        int64_t pts = frame->best_effort_timestamp;
+        if (pts == AV_NOPTS_VALUE || pts < gop_start) {
+            continue;  // Leading pictures of an open GOP
+        }
+        if (pts >= chunk_end_) {
+            break;
+        }
+        if (!cacheFrame(frame, error_message)) {
+            return false;
+        }
+    }
+
+    if (cache_.empty()) {
+        error_message = "Reverse: no frames decoded from keyframe at " + std::to_string(gop_start);
+        return false;
+    }
+
+    // Frames before the oldest cached one come from the next chunk
+    chunk_end_ = cache_.front()->best_effort_timestamp;
+    if (gop_ == 0 && chunk_end_ <= keyframes_.front()) {
+        at_end_ = true;
+    }
+    return true;
+}
+
+bool ReversePlayer::cacheFrame(const AVFrame* frame, std::string& error_message) {
+    UniqueAVFrame cached;
+    if (options_.scale_width > 0 && options_.scale_width < frame->width) {
+        if (frame->width != src_width_ || frame->height != src_height_ ||
+            frame->format != src_format_) {
+            // Keep aspect ratio and pixel format; even size for chroma subsampling
+            dst_width_ = options_.scale_width & ~1;
+            dst_height_ = static_cast<int>(static_cast<int64_t>(frame->height) * dst_width_
+                                           / frame->width) & ~1;
+            if (dst_width_ <= 0 || dst_height_ <= 0) {
+                error_message = "Reverse: invalid cache frame size";
+                return false;
+            }
+            sws_ctx_.reset(sws_getContext(frame->width, frame->height,
+                                          static_cast<AVPixelFormat>(frame->format),
+                                          dst_width_, dst_height_,
+                                          static_cast<AVPixelFormat>(frame->format),
+                                          SWS_BILINEAR, nullptr, nullptr, nullptr));
+            if (!sws_ctx_) {
+                error_message = "Reverse: failed to create scaler";
+                return false;
+            }
+            src_width_ = frame->width;
+            src_height_ = frame->height;
+            src_format_ = frame->format;
+            spare_.clear();
+        }
+
+        if (!spare_.empty()) {
+            cached = std::move(spare_.back());
+            spare_.pop_back();
+        } else {
+            cached.reset(av_frame_alloc());
+            if (!cached) {
+                error_message = "Reverse: failed to allocate frame";
+                return false;
+            }
+            cached->format = frame->format;
+            cached->width = dst_width_;
+            cached->height = dst_height_;
+            int ret = av_frame_get_buffer(cached.get(), 0);
+            if (ret < 0) {
+                error_message = "Reverse: failed to allocate cache frame: " + ffmpegErrorString(ret);
+                return false;
+            }
+        }
+        sws_scale(sws_ctx_.get(), frame->data, frame->linesize, 0, frame->height,
+                  cached->data, cached->linesize);
+        cached->best_effort_timestamp = frame->best_effort_timestamp;
+    } else {
+        // Full size: a new reference to the decoder's buffer
+        cached.reset(av_frame_clone(frame));
+        if (!cached) {
+            error_message = "Reverse: failed to reference frame";
+            return false;
+        }
+    }
+
+    cache_bytes_ += frameBytes(cached.get());
+    cache_.push_back(std::move(cached));
+
+    // Over the bound: the oldest frame is decoded again by a later chunk
+    if (cache_.size() > static_cast<size_t>(options_.cache_frames)) {
+        cache_bytes_ -= frameBytes(cache_.front().get());
+        recycle(std::move(cache_.front()));
+        cache_.pop_front();
+    }
+    counters_.peak_cache_bytes = std::max(counters_.peak_cache_bytes, cache_bytes_);
+    return true;
+}
+
+void ReversePlayer::recycle(UniqueAVFrame frame) {
+    // Scaled frames own their buffers and are reused; references are dropped
+    if (sws_ctx_ && frame && frame->width == dst_width_ && frame->height == dst_height_ &&
+        frame->format == src_format_) {
+        spare_.push_back(std::move(frame));
+    }
+}
+
+bool ReversePlayer::indexKeyframes(const std::string& video_path, std::vector<int64_t>& keyframes,
+                                   std::string& error_message) {
+    AVFormatContext* format_ctx_raw = nullptr;
+    int ret = avformat_open_input(&format_ctx_raw, video_path.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Reverse: failed to open source: " + ffmpegErrorString(ret);
+        return false;
+    }
+    UniqueAVFormatContext format_ctx(format_ctx_raw);
+
+    ret = avformat_find_stream_info(format_ctx.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Reverse: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    int video_stream_index = -1;
+    for (unsigned int i = 0; i < format_ctx->nb_streams; i++) {
+        if (format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+            video_stream_index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (video_stream_index < 0) {
+        error_message = "Reverse: no video stream found";
+        return false;
+    }
+
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        error_message = "Reverse: failed to allocate packet";
+        return false;
+    }
+
+    keyframes.clear();
+    while (av_read_frame(format_ctx.get(), packet.get()) >= 0) {
+        if (packet->stream_index == video_stream_index && (packet->flags & AV_PKT_FLAG_KEY) &&
+            packet->pts != AV_NOPTS_VALUE) {
+            keyframes.push_back(packet->pts);
+        }
+        av_packet_unref(packet.get());
+    }
+    std::sort(keyframes.begin(), keyframes.end());
+    keyframes.erase(std::unique(keyframes.begin(), keyframes.end()), keyframes.end());
+
+    if (keyframes.empty()) {
+        error_message = "Reverse: source has no timestamped keyframes";
+        return false;
+    }
+    return true;
+}
+
+} // namespace video_bench
@@ -0,0 +1,93 @@
+#ifndef REVERSE_PLAYER_HPP
+#define REVERSE_PLAYER_HPP
+
+#include "decoder/video_decoder.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <string>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+namespace video_bench {
+
+// Reverse playback statistics (per stream, merged per test)
+struct ReverseCounters {
+    int64_t frames_shown = 0;
+    int64_t frames_decoded = 0;    // Including frames decoded again for long GOPs
+    int64_t chunks = 0;            // Seek + forward decode passes
+    int64_t peak_cache_bytes = 0;  // Largest frame cache (summed when merged)
+
+    void merge(const ReverseCounters& other) {
+        frames_shown += other.frames_shown;
+        frames_decoded += other.frames_decoded;
+        chunks += other.chunks;
+        peak_cache_bytes += other.peak_cache_bytes;
+    }
+};
+
+struct ReversePlayerOptions {
+    int cache_frames = 120;  // Frame cache bound
+    int scale_width = 0;     // Cache frames at this width (0 = decoded size)
+};
+
+// Reverse playback of a local file: decodes forward from a keyframe into a
+// bounded frame cache, then hands the cached frames out newest first. A
+// GOP longer than the cache is decoded in several passes from the same
+// keyframe, each keeping the newest frames not yet shown, so memory stays
+// bounded at the cost of decoding the start of the GOP again. At the
+// start of the file playback continues from the end.
+class ReversePlayer {
+public:
+    // keyframes: sorted keyframe timestamps of the video stream (see indexKeyframes())
+    ReversePlayer(const std::vector<int64_t>& keyframes, const ReversePlayerOptions& options);
+
+    // Non-copyable, non-movable (owns decoder and cache)
+    ReversePlayer(const ReversePlayer&) = delete;
+    ReversePlayer& operator=(const ReversePlayer&) = delete;
+    ReversePlayer(ReversePlayer&&) = delete;
+    ReversePlayer& operator=(ReversePlayer&&) = delete;
+
+    bool open(const std::string& video_path, int thread_count, std::string& error_message);
+
+    // Next frame in reverse order, decoding the previous chunk when the
+    // cache runs empty; valid until the next call (nullptr on error)
+    const AVFrame* nextFrame(std::string& error_message);
+
+    const ReverseCounters& getCounters() const { return counters_; }
+
+    // Scan a local file once for the keyframe timestamps of its video stream
+    static bool indexKeyframes(const std::string& video_path, std::vector<int64_t>& keyframes,
+                               std::string& error_message);
+
+private:
+    bool decodeChunk(std::string& error_message);
+    bool cacheFrame(const AVFrame* frame, std::string& error_message);
+    void recycle(UniqueAVFrame frame);
+
+    const std::vector<int64_t>& keyframes_;
+    ReversePlayerOptions options_;
+    VideoDecoder decoder_;
+
+    // Cached frames in presentation order; shown from the back
+    std::deque<UniqueAVFrame> cache_;
+    std::vector<UniqueAVFrame> spare_;  // Scaled frames for reuse
+    UniqueAVFrame current_;             // Frame handed out last
+    int64_t cache_bytes_ = 0;
+
+    size_t gop_ = 0;            // Keyframe the next chunk decodes from
+    int64_t chunk_end_ = 0;     // Frames at or past this were shown already
+    bool at_end_ = true;        // Next chunk starts from the end of the file
+
+    UniqueSwsContext sws_ctx_;
+    int src_width_ = 0;
+    int src_height_ = 0;
+    int src_format_ = -1;
+    int dst_width_ = 0;
+    int dst_height_ = 0;
+
+    ReverseCounters counters_;
+};
+
+} // namespace video_bench
+
+#endif // REVERSE_PLAYER_HPP
@@ -0,0 +1,188 @@
+#include "decoder/temporal_layer_filter.hpp"
+#include <chrono>
+
+namespace video_bench {
+
+namespace {
+// H.264 NAL unit types
+constexpr int kH264SliceFirst = 1;
+constexpr int kH264SliceLast = 5;   // IDR slice
+constexpr int kH264Prefix = 14;
+constexpr int kH264SliceExtension = 20;
+
+// HEVC NAL unit types 0..31 are VCL
+constexpr int kHevcFirstNonVcl = 32;
+
+// AV1 OBU types that carry a frame
+constexpr int kAv1FrameHeader = 3;
+constexpr int kAv1TileGroup = 4;
+constexpr int kAv1Frame = 6;
+
+// Offset of the NAL length size field in avcC/hvcC extradata
+constexpr int kAvccLengthSizeOffset = 4;
+constexpr int kHvccLengthSizeOffset = 21;
+
+// Start of the next Annex B NAL unit at or after pos (size if none)
+size_t nextStartCode(const uint8_t* data, size_t size, size_t pos) {
+    for (size_t i = pos; i + 3 <= size; i++) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            return i + 3;
+        }
+    }
+    return size;
+}
+
+// Layer of an H.264 or HEVC NAL unit: -1 until the first VCL unit
+int nalLayer(AVCodecID codec_id, const uint8_t* nal, size_t size, int& prefix_layer) {
+    if (size < 2) {
+        return -1;
+    }
+    if (codec_id == AV_CODEC_ID_HEVC) {
+        int type = (nal[0] >> 1) & 0x3f;
+        if (type >= kHevcFirstNonVcl) {
+            return -1;
+        }
+        return std::max(0, (nal[1] & 0x07) - 1);
+    }
+
+    int type = nal[0] & 0x1f;
+    if ((type == kH264Prefix || type == kH264SliceExtension) && size >= 4 && (nal[1] & 0x80)) {
+        // SVC header extension: temporal_id in the top bits of the third byte
+        prefix_layer = nal[3] >> 5;
+        if (type == kH264SliceExtension) {
+            return prefix_layer;
+        }
+        return -1;
+    }
+    if (type < kH264SliceFirst || type > kH264SliceLast) {
+        return -1;
+    }
+    if (prefix_layer >= 0) {
+        return prefix_layer;
+    }
+    return (nal[0] & 0x60) == 0 ? 1 : 0;
+}
+} // namespace
+
+bool TemporalLayerFilter::isSupported(AVCodecID codec_id) {
+    return codec_id == AV_CODEC_ID_H264 || codec_id == AV_CODEC_ID_HEVC ||
+           codec_id == AV_CODEC_ID_AV1;
+}
+
+bool TemporalLayerFilter::init(const AVCodecParameters* codec_params,
+                               std::string& error_message) {
+    if (!isSupported(codec_params->codec_id)) {
+        error_message = "Temporal layers: codec has no temporal layer headers "
+                        "(H.264, HEVC and AV1 only)";
+        return false;
+    }
+    codec_id_ = codec_params->codec_id;
+
+    // avcC/hvcC extradata (version 1) means length-prefixed NAL units
+    const uint8_t* extradata = codec_params->extradata;
+    const int offset = codec_id_ == AV_CODEC_ID_HEVC ? kHvccLengthSizeOffset
+                                                      : kAvccLengthSizeOffset;
+    length_size_ = 0;
+    if (codec_id_ != AV_CODEC_ID_AV1 && extradata &&
+        codec_params->extradata_size > offset && extradata[0] == 1) {
+        length_size_ = (extradata[offset] & 0x03) + 1;
+    }
+    return true;
+}
+
+bool TemporalLayerFilter::keep(const AVPacket* packet) {
+    auto parse_start = std::chrono::steady_clock::now();
+    int layer = packetLayer(packet->data, static_cast<size_t>(packet->size));
+    counters_.parse_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - parse_start).count();
+
+    counters_.packets++;
+    counters_.highest_layer = std::max(counters_.highest_layer, layer);
+    if (layer <= max_layer_ || (packet->flags & AV_PKT_FLAG_KEY)) {
+        return true;
+    }
+    counters_.dropped++;
+    return false;
+}
+
+int TemporalLayerFilter::packetLayer(const uint8_t* data, size_t size) const {
+    if (!data || size == 0) {
+        return 0;
+    }
+    return codec_id_ == AV_CODEC_ID_AV1 ? av1Layer(data, size) : nalStreamLayer(data, size);
+}
+
+int TemporalLayerFilter::nalStreamLayer(const uint8_t* data, size_t size) const {
+    // All VCL units of an access unit share the layer: stop at the first
+    int prefix_layer = -1;
+    if (length_size_ > 0) {
+        size_t pos = 0;
+        while (pos + length_size_ <= size) {
+            size_t length = 0;
+            for (int i = 0; i < length_size_; i++) {
+                length = (length << 8) | data[pos + i];
+            }
+            pos += length_size_;
+            length = std::min(length, size - pos);
+            int layer = nalLayer(codec_id_, data + pos, length, prefix_layer);
+            if (layer >= 0) {
+                return layer;
+            }
+            pos += length;
+        }
+        return 0;
+    }
+
+    // Annex B: only the header bytes are read, so a unit runs to the end
+    // of the packet until the next start code is found
+    size_t pos = nextStartCode(data, size, 0);
+    while (pos < size) {
+        int layer = nalLayer(codec_id_, data + pos, size - pos, prefix_layer);
+        if (layer >= 0) {
+            return layer;
+        }
+        pos = nextStartCode(data, size, pos + 1);
+    }
+    return 0;
+}
+
+int TemporalLayerFilter::av1Layer(const uint8_t* data, size_t size) const {
+    size_t pos = 0;
+    while (pos < size) {
+        const uint8_t header = data[pos++];
+        const int type = (header >> 3) & 0x0f;
+        const bool has_extension = header & 0x04;
+        const bool has_size = header & 0x02;
+
+        int temporal_id = 0;
+        if (has_extension) {
+            if (pos >= size) {
+                break;
+            }
+            temporal_id = data[pos++] >> 5;
+        }
+        if (type == kAv1FrameHeader || type == kAv1TileGroup || type == kAv1Frame) {
+            return temporal_id;
+        }
+
+        // leb128 obu_size; without it the OBU runs to the end of the packet
+        if (!has_size) {
+            break;
+        }
+        uint64_t obu_size = 0;
+        for (int i = 0; i < 8 && pos < size; i++) {
+            const uint8_t byte = data[pos++];
+            obu_size |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        if (obu_size > size - pos) {
+            break;
+        }
+        pos += obu_size;
+    }
+    return 0;
+}
+
+} // namespace video_bench
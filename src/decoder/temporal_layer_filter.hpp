@@ -0,0 +1,69 @@
+#ifndef TEMPORAL_LAYER_FILTER_HPP
+#define TEMPORAL_LAYER_FILTER_HPP
+
+#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace video_bench {
+
+// Temporal layer pruning statistics (per stream, merged per test)
+struct LayerFilterCounters {
+    int64_t packets = 0;
+    int64_t dropped = 0;
+    int highest_layer = 0;  // Highest temporal layer seen in the stream
+    int64_t parse_ns = 0;   // Header parsing, including the clock reads
+
+    void merge(const LayerFilterCounters& other) {
+        packets += other.packets;
+        dropped += other.dropped;
+        highest_layer = std::max(highest_layer, other.highest_layer);
+        parse_ns += other.parse_ns;
+    }
+};
+
+// Drops packets of temporal layers above max_layer before they reach the
+// decoder, from the NAL/OBU headers alone:
+//   HEVC   TemporalId of the first VCL NAL unit
+//   H.264  temporal_id of an SVC prefix NAL unit; without one, layer 0 for
+//          reference pictures and 1 for non-reference (nal_ref_idc == 0)
+//   AV1    temporal_id in the OBU extension of the first frame OBU; keeping
+//          layers 0..max_layer is the operating point that decodes them
+// Higher layers are never referenced by lower ones, so the remaining
+// packets decode as a valid stream at a lower frame rate. Keyframes are
+// always kept. Handles both Annex B and length-prefixed (avcC/hvcC) NAL units.
+class TemporalLayerFilter {
+public:
+    explicit TemporalLayerFilter(int max_layer) : max_layer_(max_layer) {}
+
+    // Pick the codec and NAL framing; false for codecs without layer headers
+    bool init(const AVCodecParameters* codec_params, std::string& error_message);
+
+    // False if the packet is above max_layer (counted as dropped)
+    bool keep(const AVPacket* packet);
+
+    // Temporal layer of one packet (0 = base layer)
+    int packetLayer(const uint8_t* data, size_t size) const;
+
+    const LayerFilterCounters& getCounters() const { return counters_; }
+
+    static bool isSupported(AVCodecID codec_id);
+
+private:
+    int nalStreamLayer(const uint8_t* data, size_t size) const;
+    int av1Layer(const uint8_t* data, size_t size) const;
+
+    int max_layer_;
+    AVCodecID codec_id_ = AV_CODEC_ID_NONE;
+    int length_size_ = 0;  // NAL length field bytes (0 = Annex B start codes)
+    LayerFilterCounters counters_;
+};
+
+} // namespace video_bench
+
+#endif // TEMPORAL_LAYER_FILTER_HPP
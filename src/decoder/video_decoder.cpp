@@ -3,6 +3,23 @@
 
 namespace video_bench {
 
+namespace {
+// Thread type for a multi-threaded decoder. Frame threading decodes
+// several pictures at once and delays output by a frame per thread; slice
+// threading splits one picture. Intra-only pictures (MJPEG) are
+// independent, so slices split them without the delay, and MPEG-2 only
+// has slice threads. Decoders with their own pool (VVC) ignore the type.
+int threadTypeFor(const AVCodec* codec) {
+    const AVCodecDescriptor* descriptor = avcodec_descriptor_get(codec->id);
+    const bool intra_only = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+    const bool frame_threads = codec->capabilities & AV_CODEC_CAP_FRAME_THREADS;
+    if ((codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) && (intra_only || !frame_threads)) {
+        return FF_THREAD_SLICE;
+    }
+    return FF_THREAD_FRAME;
+}
+} // namespace
+
 VideoDecoder::VideoDecoder()
     : frame_(av_frame_alloc(), AVFrameDeleter{})
     , packet_(av_packet_alloc(), AVPacketDeleter{}) {
@@ -74,7 +91,7 @@ bool VideoDecoder::open(const std::string& file_path, std::string& error_message
     // Configure decoder threading based on expected concurrent streams
     // thread_count=1 for many streams, higher for fewer streams
     codec_ctx_->thread_count = thread_count;
-    codec_ctx_->thread_type = (thread_count == 1) ? 0 : FF_THREAD_FRAME;
+    codec_ctx_->thread_type = (thread_count == 1) ? 0 : threadTypeFor(codec);
 
     // Open codec
     ret = avcodec_open2(codec_ctx_.get(), codec, nullptr);
@@ -127,7 +144,7 @@ bool VideoDecoder::initFromParams(const AVCodecParameters* codec_params,
 
     // Configure decoder threading
     codec_ctx_->thread_count = thread_count;
-    codec_ctx_->thread_type = (thread_count == 1) ? 0 : FF_THREAD_FRAME;
+    codec_ctx_->thread_type = (thread_count == 1) ? 0 : threadTypeFor(codec);
 
     // Open codec
     ret = avcodec_open2(codec_ctx_.get(), codec, nullptr);
@@ -375,6 +392,67 @@ bool VideoDecoder::seekToStart() {
     return true;
 }
 
+bool VideoDecoder::seekToKeyframe(int64_t timestamp) {
+    if (!is_open_ || !format_ctx_) {
+        return false;
+    }
+
+    avcodec_flush_buffers(codec_ctx_.get());
+    int ret = av_seek_frame(format_ctx_.get(), video_stream_index_, timestamp, AVSEEK_FLAG_BACKWARD);
+    return ret >= 0;
+}
+
+SingleFrameResult VideoDecoder::decodeNextFrame() {
+    SingleFrameResult result{false, false, ""};
+
+    if (!is_open_ || !format_ctx_) {
+        result.error_message = "Decoder not open";
+        return result;
+    }
+
+    while (true) {
+        // Buffered frames first (B-frame reordering, draining)
+        int ret = avcodec_receive_frame(codec_ctx_.get(), frame_.get());
+        if (ret == 0) {
+            result.success = true;
+            return result;
+        } else if (ret == AVERROR_EOF) {
+            result.reached_eof = true;
+            return result;
+        } else if (ret != AVERROR(EAGAIN) && ret != AVERROR_INVALIDDATA) {
+            result.error_message = "Receive frame error: " + ffmpegErrorString(ret);
+            return result;
+        }
+
+        ret = av_read_frame(format_ctx_.get(), packet_.get());
+        if (ret == AVERROR_EOF) {
+            // Drain: the next receives return the buffered frames, then EOF
+            ret = avcodec_send_packet(codec_ctx_.get(), nullptr);
+            if (ret < 0 && ret != AVERROR_EOF) {
+                result.error_message = "Drain error: " + ffmpegErrorString(ret);
+                return result;
+            }
+            continue;
+        } else if (ret < 0) {
+            result.error_message = "Read error: " + ffmpegErrorString(ret);
+            return result;
+        }
+
+        if (packet_->stream_index != video_stream_index_) {
+            av_packet_unref(packet_.get());
+            continue;
+        }
+
+        ret = avcodec_send_packet(codec_ctx_.get(), packet_.get());
+        av_packet_unref(packet_.get());
+        // Skip invalid packets (common after seek in VP9/AV1)
+        if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_INVALIDDATA) {
+            result.error_message = "Send packet error: " + ffmpegErrorString(ret);
+            return result;
+        }
+    }
+}
+
 SingleFrameResult VideoDecoder::decodeFromPacket(AVPacket* packet) {
     SingleFrameResult result{false, false, ""};
 
@@ -395,10 +473,10 @@ SingleFrameResult VideoDecoder::decodeFromPacket(AVPacket* packet) {
         return result;
     }
 
-    // Try to receive a frame
+    // Try to receive a frame (receive_frame drops the previous reference)
+    // Keep the frame referenced so per-stream stages can consume it
     ret = avcodec_receive_frame(codec_ctx_.get(), frame_.get());
     if (ret == 0) {
-        av_frame_unref(frame_.get());
         result.success = true;
         return result;
     } else if (ret == AVERROR(EAGAIN) || ret == AVERROR_INVALIDDATA) {
@@ -429,10 +507,9 @@ SingleFrameResult VideoDecoder::flushDecoder() {
         return result;
     }
 
-    // Try to receive a buffered frame
+    // Try to receive a buffered frame (kept for getFrame() like decodeFromPacket)
     ret = avcodec_receive_frame(codec_ctx_.get(), frame_.get());
     if (ret == 0) {
-        av_frame_unref(frame_.get());
         result.success = true;
         return result;
     } else if (ret == AVERROR_EOF || ret == AVERROR(EAGAIN)) {
@@ -446,8 +523,15 @@ SingleFrameResult VideoDecoder::flushDecoder() {
 
 void VideoDecoder::flushBuffers() {
     if (is_open_ && codec_ctx_) {
+        av_frame_unref(frame_.get());
         avcodec_flush_buffers(codec_ctx_.get());
     }
 }
 
+void VideoDecoder::setSkipFrame(AVDiscard discard) {
+    if (codec_ctx_) {
+        codec_ctx_->skip_frame = discard;
+    }
+}
+
 } // namespace video_bench
@@ -60,19 +60,37 @@ public:
 
     // Decode one frame from an external packet (for pipeline mode)
     // Caller retains ownership of packet
+    // On success the decoded frame stays available via getFrame()
     SingleFrameResult decodeFromPacket(AVPacket* packet);
 
+    // Last frame produced by decodeFromPacket() or flushDecoder()
+    // Valid until the next decode call or flushBuffers()
+    const AVFrame* getFrame() const { return frame_.get(); }
+
     // Flush decoder to get remaining buffered frames (call at EOF)
-    // Returns true if a frame was decoded
+    // Returns true if a frame was decoded (available via getFrame())
     SingleFrameResult flushDecoder();
 
     // Reset decoder state (flush internal buffers without draining)
     // Used on file loop boundary to discard stale reference frames
     void flushBuffers();
 
+    // Frames the decoder skips (AVDISCARD_NONREF: non-reference frames are
+    // parsed but never decoded or output); call after init
+    void setSkipFrame(AVDiscard discard);
+
     // Seek to the beginning of the video
     bool seekToStart();
 
+    // Seek to the keyframe at or before timestamp (video stream time base)
+    // and reset the decoder; for files opened with open()
+    bool seekToKeyframe(int64_t timestamp);
+
+    // Read and decode the next frame from the opened file, kept for
+    // getFrame(); at the end of the file the decoder is drained, then
+    // reached_eof is set without a frame (no loop to the start)
+    SingleFrameResult decodeNextFrame();
+
     // Get video stream index
     int getVideoStreamIndex() const { return video_stream_index_; }
 
@@ -3,13 +3,39 @@
 #include "utils/csv_exporter.hpp"
 #include "utils/logger.hpp"
 #include "benchmark/benchmark_runner.hpp"
+#include "benchmark/loop_microbench.hpp"
+#include "benchmark/canary_check.hpp"
 #include "video/video_info.hpp"
 #include "monitor/system_info.hpp"
 #include "monitor/memory_monitor.hpp"
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+#include "network/rtsp_stand_in.hpp"
+#include "network/segment_server.hpp"
+#include "network/fleet_agent.hpp"
+#include "network/fleet_coordinator.hpp"
+#endif
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <chrono>
 
 using namespace video_bench;
 
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+// results.csv -> results-host_port.csv, one file per fleet agent
+static std::string agentCsvPath(const std::string& csv_path, std::string agent) {
+    for (char& c : agent) {
+        if (c == ':' || c == '/') {
+            c = '_';
+        }
+    }
+    std::filesystem::path path(csv_path);
+    path.replace_filename(path.stem().string() + "-" + agent + path.extension().string());
+    return path.string();
+}
+#endif
+
 int main(int argc, char* argv[]) {
     // Parse command line arguments first to get log file path
     auto parse_result = CliParser::parse(argc, argv);
@@ -56,8 +82,127 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    // Analyze video first to print header before benchmark starts
     std::string error;
+
+    // Decode loop microbenchmark instead of the stream ladder
+    if (parse_result.config.loop_bench_frames > 0) {
+        LoopMicrobench microbench(parse_result.config.video_path,
+                                  parse_result.config.loop_bench_frames);
+        LoopMicrobenchResult microbench_result;
+        if (!microbench.run(microbench_result, error)) {
+            OutputFormatter::printError(error);
+            return 1;
+        }
+        OutputFormatter::printLoopMicrobench(microbench_result);
+        return 0;
+    }
+
+    // Production canary: exit status 2 when slower than the baseline
+    if (parse_result.config.canary_baseline) {
+        const BenchmarkConfig& config = parse_result.config;
+        CanaryCheck canary(config.video_path, *config.canary_baseline,
+                           config.canary_budget, config.canary_tolerance);
+        while (true) {
+            CanaryResult canary_result;
+            if (!canary.run(canary_result, error)) {
+                OutputFormatter::printError(error);
+                return 1;
+            }
+            OutputFormatter::printCanary(canary_result);
+            if (config.canary_metrics &&
+                !CanaryCheck::writeMetrics(canary_result, *config.canary_metrics, error)) {
+                OutputFormatter::printError(error);
+                return 1;
+            }
+            if (config.canary_interval <= 0) {
+                return canary_result.degraded ? 2 : 0;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double>(config.canary_interval));
+        }
+    }
+
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    // Fleet agent: run tests for a coordinator until killed
+    if (!parse_result.config.agent_listen.empty()) {
+        FleetAgent agent(parse_result.config.agent_listen);
+        if (!agent.start(error)) {
+            OutputFormatter::printError(error);
+            return 1;
+        }
+        std::cout << "Fleet agent listening on port " << agent.getPort() << "\n";
+        Logger::info("Fleet agent listening on port " + std::to_string(agent.getPort()));
+        agent.serve();
+        return 0;
+    }
+
+    // Fleet coordinator: same ladder on every agent, steps started together
+    if (!parse_result.config.coordinator_agents.empty()) {
+        OutputFormatter::printTestingStart();
+        FleetCoordinator coordinator(parse_result.config.coordinator_agents,
+                                     parse_result.config.agent_args,
+                                     parse_result.config.max_streams,
+                                     parse_result.config.substream_mode);
+        auto fleet = coordinator.run([](const std::string& agent, const StreamTestResult& test_result) {
+            OutputFormatter::printTestResult(test_result, "[" + agent + "] ");
+        });
+        if (!fleet.success) {
+            OutputFormatter::printError(fleet.error_message);
+            return 1;
+        }
+        OutputFormatter::printFleetSummary(fleet);
+
+        if (parse_result.config.csv_file) {
+            for (const FleetHostResult& host : fleet.hosts) {
+                std::string csv_path = agentCsvPath(*parse_result.config.csv_file, host.agent);
+                std::string csv_error;
+                if (!CsvExporter::exportToFile(host.result, csv_path, csv_error)) {
+                    OutputFormatter::printError(csv_error);
+                    return 1;
+                }
+                Logger::info("CSV results exported to: " + csv_path);
+            }
+        }
+        return 0;
+    }
+#endif
+
+    // Serve the file from the loopback RTSP stand-in and benchmark it as live
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    std::unique_ptr<RtspStandIn> stand_in;
+    if (parse_result.config.stand_in) {
+        stand_in = std::make_unique<RtspStandIn>(parse_result.config.video_path);
+        if (parse_result.config.tls) {
+            stand_in->enableTls(parse_result.config.tls_cipher);
+        }
+        if (!stand_in->start(error)) {
+            OutputFormatter::printError(error);
+            return 1;
+        }
+        Logger::info("RTSP stand-in serving " + parse_result.config.video_path +
+                     " at " + stand_in->getUrl());
+        parse_result.config.video_path = stand_in->getUrl();
+    }
+
+    // Serve the file as HLS/DASH over loopback HTTP, one variant per duration
+    std::unique_ptr<SegmentServer> segment_server;
+    if (!parse_result.config.segment_format.empty()) {
+        auto format = parse_result.config.segment_format == "hls"
+            ? SegmentServer::Format::Hls : SegmentServer::Format::Dash;
+        segment_server = std::make_unique<SegmentServer>(
+            parse_result.config.video_path, format, parse_result.config.segment_durations);
+        if (!segment_server->start(error)) {
+            OutputFormatter::printError(error);
+            return 1;
+        }
+        for (size_t i = 0; i < segment_server->getVariantCount(); i++) {
+            Logger::info("Segment server serving " + parse_result.config.video_path +
+                         " at " + segment_server->getUrl(i));
+        }
+        parse_result.config.video_path = segment_server->getUrl(0);
+    }
+#endif
+
+    // Analyze video first to print header before benchmark starts
     auto video_info = VideoAnalyzer::analyze(parse_result.config.video_path, error);
     if (!video_info) {
         OutputFormatter::printError(error);
@@ -69,6 +214,11 @@ int main(int argc, char* argv[]) {
         OutputFormatter::printError("Unsupported codec: " + video_info->codec_name);
         return 1;
     }
+    if (!video_info->has_decoder) {
+        OutputFormatter::printError("No " + video_info->codec_name +
+                                    " decoder in this FFmpeg build");
+        return 1;
+    }
 
     // Build a partial result for header printing
     BenchmarkResult header_info;
@@ -88,6 +238,10 @@ int main(int argc, char* argv[]) {
 
     // Run benchmark
     BenchmarkRunner runner(parse_result.config, *video_info);
+#ifdef VIDEO_BENCH_NETWORK_INGEST
+    runner.setStandIn(stand_in.get());
+    runner.setSegmentServer(segment_server.get());
+#endif
 
     auto result = runner.run([](const StreamTestResult& test_result) {
         OutputFormatter::printTestResult(test_result);
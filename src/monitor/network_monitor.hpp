@@ -0,0 +1,49 @@
+#ifndef NETWORK_MONITOR_HPP
+#define NETWORK_MONITOR_HPP
+
+#include <memory>
+#include <cstdint>
+
+namespace video_bench {
+
+// Network stack activity and CPU cost over a measurement period
+struct NetworkUsage {
+    double elapsed_seconds = 0.0;
+    double irq_seconds = 0.0;       // Hard IRQ time attributed to NIC interrupts
+    double softirq_seconds = 0.0;   // Softirq time attributed to NET_RX/NET_TX
+    double cpu_usage = 0.0;         // Network share of total CPU (same scale as CpuMonitor)
+    uint64_t rx_bytes = 0;          // All interfaces, including loopback
+    uint64_t net_rx_softirqs = 0;
+    uint64_t net_tx_softirqs = 0;
+    uint64_t nic_interrupts = 0;
+    uint64_t udp_in_datagrams = 0;
+    uint64_t udp_rcvbuf_errors = 0;  // Datagrams dropped on a full socket buffer
+    uint64_t tcp_in_segs = 0;
+};
+
+// Abstract interface for network stack CPU accounting
+// /proc/stat folds IRQ and softirq time into the total; this attributes the
+// network part of it so ingest cost can be sized apart from decode
+class NetworkMonitor {
+public:
+    virtual ~NetworkMonitor() = default;
+
+    // Factory method - creates platform-specific implementation
+    static std::unique_ptr<NetworkMonitor> create();
+
+    // False if the platform exposes no softirq/interrupt accounting
+    virtual bool isSupported() const = 0;
+
+    // Start a new measurement period
+    virtual void startMeasurement() = 0;
+
+    // Get network activity since last startMeasurement()
+    virtual NetworkUsage getUsage() = 0;
+
+protected:
+    NetworkMonitor() = default;
+};
+
+} // namespace video_bench
+
+#endif // NETWORK_MONITOR_HPP
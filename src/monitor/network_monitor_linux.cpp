@@ -0,0 +1,245 @@
+#include "monitor/network_monitor.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+
+// Interrupt names of common NIC drivers (besides interface names)
+constexpr const char* kNicIrqTags[] = {
+    "virtio", "mlx", "iwlwifi", "TxRx", "-rx-", "-tx-", "rx-", "tx-"
+};
+
+struct NetworkSnapshot {
+    std::chrono::steady_clock::time_point time;
+    uint64_t cpu_total = 0;        // All /proc/stat jiffies
+    uint64_t cpu_irq = 0;
+    uint64_t cpu_softirq = 0;
+    uint64_t softirqs_total = 0;
+    uint64_t net_rx_softirqs = 0;
+    uint64_t net_tx_softirqs = 0;
+    uint64_t interrupts_total = 0;
+    uint64_t nic_interrupts = 0;
+    uint64_t rx_bytes = 0;
+    uint64_t udp_in_datagrams = 0;
+    uint64_t udp_rcvbuf_errors = 0;
+    uint64_t tcp_in_segs = 0;
+};
+
+// Sum the per-CPU counters that follow the row label
+uint64_t sumCounters(std::istringstream& iss, std::string* rest = nullptr) {
+    uint64_t sum = 0;
+    std::string token;
+    while (iss >> token) {
+        if (token.find_first_not_of("0123456789") != std::string::npos) {
+            if (rest) {
+                std::getline(iss, *rest);
+                *rest = token + *rest;
+            }
+            break;
+        }
+        sum += std::stoull(token);
+    }
+    return sum;
+}
+
+// Find the value of a named column in a /proc/net/snmp header/value pair
+uint64_t snmpField(const std::string& header, const std::string& values,
+                   const std::string& field) {
+    std::istringstream names(header);
+    std::istringstream nums(values);
+    std::string name;
+    std::string num;
+    while (names >> name && nums >> num) {
+        if (name == field) {
+            return std::stoull(num);
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+class LinuxNetworkMonitor : public NetworkMonitor {
+public:
+    LinuxNetworkMonitor() = default;
+
+    bool isSupported() const override {
+        return std::ifstream("/proc/softirqs").is_open();
+    }
+
+    void startMeasurement() override {
+        start_ = readSnapshot();
+    }
+
+    NetworkUsage getUsage() override {
+        NetworkSnapshot end = readSnapshot();
+        NetworkUsage usage;
+
+        usage.elapsed_seconds = std::chrono::duration<double>(end.time - start_.time).count();
+        usage.rx_bytes = end.rx_bytes - start_.rx_bytes;
+        usage.net_rx_softirqs = end.net_rx_softirqs - start_.net_rx_softirqs;
+        usage.net_tx_softirqs = end.net_tx_softirqs - start_.net_tx_softirqs;
+        usage.nic_interrupts = end.nic_interrupts - start_.nic_interrupts;
+        usage.udp_in_datagrams = end.udp_in_datagrams - start_.udp_in_datagrams;
+        usage.udp_rcvbuf_errors = end.udp_rcvbuf_errors - start_.udp_rcvbuf_errors;
+        usage.tcp_in_segs = end.tcp_in_segs - start_.tcp_in_segs;
+
+        // Softirq and IRQ time is only available in aggregate; attribute the
+        // network share by event counts
+        uint64_t softirqs = end.softirqs_total - start_.softirqs_total;
+        uint64_t interrupts = end.interrupts_total - start_.interrupts_total;
+        double softirq_share = softirqs > 0
+            ? static_cast<double>(usage.net_rx_softirqs + usage.net_tx_softirqs) / softirqs
+            : 0.0;
+        double irq_share = interrupts > 0
+            ? static_cast<double>(usage.nic_interrupts) / interrupts
+            : 0.0;
+
+        double softirq_jiffies = static_cast<double>(end.cpu_softirq - start_.cpu_softirq)
+                                 * softirq_share;
+        double irq_jiffies = static_cast<double>(end.cpu_irq - start_.cpu_irq) * irq_share;
+
+        long ticks_per_second = sysconf(_SC_CLK_TCK);
+        if (ticks_per_second > 0) {
+            usage.softirq_seconds = softirq_jiffies / static_cast<double>(ticks_per_second);
+            usage.irq_seconds = irq_jiffies / static_cast<double>(ticks_per_second);
+        }
+
+        uint64_t total = end.cpu_total - start_.cpu_total;
+        if (total > 0) {
+            usage.cpu_usage = 100.0 * (softirq_jiffies + irq_jiffies)
+                              / static_cast<double>(total);
+        }
+        return usage;
+    }
+
+private:
+    NetworkSnapshot readSnapshot() {
+        NetworkSnapshot snap;
+        snap.time = std::chrono::steady_clock::now();
+        std::vector<std::string> interfaces = readNetDev(snap);
+        readProcStat(snap);
+        readSoftirqs(snap);
+        readInterrupts(snap, interfaces);
+        readSnmp(snap);
+        return snap;
+    }
+
+    static void readProcStat(NetworkSnapshot& snap) {
+        std::ifstream file("/proc/stat");
+        std::string line;
+        if (!std::getline(file, line)) {
+            return;
+        }
+        std::istringstream iss(line);
+        std::string label;
+        iss >> label;  // "cpu"
+
+        // user nice system idle iowait irq softirq steal ...
+        uint64_t value = 0;
+        for (int column = 0; iss >> value; column++) {
+            snap.cpu_total += value;
+            if (column == 5) snap.cpu_irq = value;
+            if (column == 6) snap.cpu_softirq = value;
+            if (column == 7) break;  // guest time is already in user
+        }
+    }
+
+    static void readSoftirqs(NetworkSnapshot& snap) {
+        std::ifstream file("/proc/softirqs");
+        std::string line;
+        std::getline(file, line);  // CPU header
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::string label;
+            iss >> label;
+            uint64_t count = sumCounters(iss);
+            snap.softirqs_total += count;
+            if (label == "NET_RX:") snap.net_rx_softirqs = count;
+            if (label == "NET_TX:") snap.net_tx_softirqs = count;
+        }
+    }
+
+    static void readInterrupts(NetworkSnapshot& snap,
+                               const std::vector<std::string>& interfaces) {
+        std::ifstream file("/proc/interrupts");
+        std::string line;
+        std::getline(file, line);  // CPU header
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::string label;
+            iss >> label;
+            std::string description;
+            uint64_t count = sumCounters(iss, &description);
+            snap.interrupts_total += count;
+
+            bool is_nic = false;
+            for (const auto& name : interfaces) {
+                is_nic = is_nic || description.find(name) != std::string::npos;
+            }
+            for (const char* tag : kNicIrqTags) {
+                is_nic = is_nic || description.find(tag) != std::string::npos;
+            }
+            // virtio devices also cover block and console; only count queues
+            if (is_nic && description.find("virtio") != std::string::npos) {
+                is_nic = description.find("input") != std::string::npos ||
+                         description.find("output") != std::string::npos;
+            }
+            if (is_nic) {
+                snap.nic_interrupts += count;
+            }
+        }
+    }
+
+    static std::vector<std::string> readNetDev(NetworkSnapshot& snap) {
+        std::vector<std::string> interfaces;
+        std::ifstream file("/proc/net/dev");
+        std::string line;
+        std::getline(file, line);  // Two header lines
+        std::getline(file, line);
+        while (std::getline(file, line)) {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string name = line.substr(0, colon);
+            name.erase(0, name.find_first_not_of(' '));
+            std::istringstream iss(line.substr(colon + 1));
+            uint64_t rx_bytes = 0;
+            iss >> rx_bytes;
+            snap.rx_bytes += rx_bytes;
+            if (name != "lo") {
+                interfaces.push_back(name);
+            }
+        }
+        return interfaces;
+    }
+
+    static void readSnmp(NetworkSnapshot& snap) {
+        std::ifstream file("/proc/net/snmp");
+        std::string header;
+        std::string values;
+        while (std::getline(file, header) && std::getline(file, values)) {
+            if (header.rfind("Udp:", 0) == 0) {
+                snap.udp_in_datagrams = snmpField(header, values, "InDatagrams");
+                snap.udp_rcvbuf_errors = snmpField(header, values, "RcvbufErrors");
+            } else if (header.rfind("Tcp:", 0) == 0) {
+                snap.tcp_in_segs = snmpField(header, values, "InSegs");
+            }
+        }
+    }
+
+    NetworkSnapshot start_;
+};
+
+std::unique_ptr<NetworkMonitor> NetworkMonitor::create() {
+    return std::make_unique<LinuxNetworkMonitor>();
+}
+
+} // namespace video_bench
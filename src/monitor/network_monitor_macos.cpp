@@ -0,0 +1,26 @@
+#include "monitor/network_monitor.hpp"
+
+namespace video_bench {
+
+// No per-context IRQ/softirq accounting is exposed; network CPU stays
+// folded into the total CPU figure
+class MacOSNetworkMonitor : public NetworkMonitor {
+public:
+    MacOSNetworkMonitor() = default;
+
+    bool isSupported() const override {
+        return false;
+    }
+
+    void startMeasurement() override {}
+
+    NetworkUsage getUsage() override {
+        return {};
+    }
+};
+
+std::unique_ptr<NetworkMonitor> NetworkMonitor::create() {
+    return std::make_unique<MacOSNetworkMonitor>();
+}
+
+} // namespace video_bench
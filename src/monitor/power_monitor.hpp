@@ -0,0 +1,73 @@
+#ifndef POWER_MONITOR_HPP
+#define POWER_MONITOR_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace video_bench {
+
+// Time spent in one idle state over a measurement period
+struct CStateResidency {
+    std::string name;              // e.g. "C6"
+    int exit_latency_us = 0;       // Worst case across cores
+    double residency_pct = 0.0;    // Average over cores
+    double entries_per_sec = 0.0;  // Summed over cores
+};
+
+// Package power and idle states over a measurement period
+struct PowerUsage {
+    double elapsed_seconds = 0.0;
+    bool has_energy = false;        // RAPL counters were readable
+    double package_watts = 0.0;     // All package domains
+    int cores = 0;                  // Cores with cpuidle states
+    std::vector<CStateResidency> cstates;  // Shallowest first
+};
+
+// Abstract interface for package energy (RAPL) and per-core C-state
+// residency, so pacing sleeps can be related to wakeup latency and power
+class PowerMonitor {
+public:
+    virtual ~PowerMonitor() = default;
+
+    // Factory method - creates platform-specific implementation
+    static std::unique_ptr<PowerMonitor> create();
+
+    // False if the platform exposes neither energy counters nor idle states
+    virtual bool isSupported() const = 0;
+
+    // Start a new measurement period
+    virtual void startMeasurement() = 0;
+
+    // Get power and idle states since last startMeasurement()
+    virtual PowerUsage getUsage() = 0;
+
+protected:
+    PowerMonitor() = default;
+};
+
+// PM QoS request (Linux): while held, no core enters an idle state whose
+// exit latency exceeds latency_us (0 keeps the cores polling). The request
+// lasts as long as /dev/cpu_dma_latency stays open; writing it needs root.
+class CpuLatencyRequest {
+public:
+    CpuLatencyRequest() = default;
+    ~CpuLatencyRequest();
+
+    // Non-copyable, non-movable (owns a file descriptor)
+    CpuLatencyRequest(const CpuLatencyRequest&) = delete;
+    CpuLatencyRequest& operator=(const CpuLatencyRequest&) = delete;
+    CpuLatencyRequest(CpuLatencyRequest&&) = delete;
+    CpuLatencyRequest& operator=(CpuLatencyRequest&&) = delete;
+
+    bool acquire(int latency_us, std::string& error_message);
+    void release();
+
+private:
+    int fd_ = -1;
+};
+
+} // namespace video_bench
+
+#endif // POWER_MONITOR_HPP
@@ -0,0 +1,217 @@
+#include "monitor/power_monitor.hpp"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+
+constexpr const char* kPowercapPath = "/sys/class/powercap";
+constexpr const char* kCpuPath = "/sys/devices/system/cpu";
+constexpr const char* kCpuLatencyDevice = "/dev/cpu_dma_latency";
+
+// Idle state totals over all cores, by state index
+struct CStateTotals {
+    std::string name;
+    int exit_latency_us = 0;
+    uint64_t time_us = 0;
+    uint64_t usage = 0;
+};
+
+struct PowerSnapshot {
+    std::chrono::steady_clock::time_point time;
+    std::vector<uint64_t> energy_uj;  // Per package domain
+    std::vector<CStateTotals> cstates;
+    int cores = 0;
+};
+
+bool readValue(const std::filesystem::path& path, uint64_t& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+std::string readLine(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// Package domains are "intel-rapl:N" (AMD uses the same driver name);
+// "intel-rapl:N:M" subdomains are part of their package
+std::vector<std::filesystem::path> packageDomains() {
+    std::vector<std::filesystem::path> domains;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(kPowercapPath, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("intel-rapl:", 0) == 0 &&
+            std::count(name.begin(), name.end(), ':') == 1) {
+            domains.push_back(entry.path());
+        }
+    }
+    std::sort(domains.begin(), domains.end());
+    return domains;
+}
+
+} // namespace
+
+class LinuxPowerMonitor : public PowerMonitor {
+public:
+    LinuxPowerMonitor() : domains_(packageDomains()) {
+        // Wraparound range per domain; a domain without readable energy is dropped
+        for (auto it = domains_.begin(); it != domains_.end();) {
+            uint64_t energy = 0;
+            uint64_t range = 0;
+            if (readValue(*it / "energy_uj", energy) &&
+                readValue(*it / "max_energy_range_uj", range)) {
+                energy_ranges_.push_back(range);
+                ++it;
+            } else {
+                it = domains_.erase(it);
+            }
+        }
+    }
+
+    bool isSupported() const override {
+        return !domains_.empty() ||
+               std::filesystem::exists(std::filesystem::path(kCpuPath) / "cpu0" / "cpuidle");
+    }
+
+    void startMeasurement() override {
+        start_ = readSnapshot();
+    }
+
+    PowerUsage getUsage() override {
+        PowerSnapshot end = readSnapshot();
+        PowerUsage usage;
+        usage.elapsed_seconds = std::chrono::duration<double>(end.time - start_.time).count();
+        if (usage.elapsed_seconds <= 0) {
+            return usage;
+        }
+
+        if (!domains_.empty() && end.energy_uj.size() == start_.energy_uj.size()) {
+            double joules = 0.0;
+            for (size_t i = 0; i < end.energy_uj.size(); i++) {
+                uint64_t delta = end.energy_uj[i] >= start_.energy_uj[i]
+                    ? end.energy_uj[i] - start_.energy_uj[i]
+                    : end.energy_uj[i] + energy_ranges_[i] - start_.energy_uj[i];
+                joules += static_cast<double>(delta) / 1e6;
+            }
+            usage.has_energy = true;
+            usage.package_watts = joules / usage.elapsed_seconds;
+        }
+
+        usage.cores = end.cores;
+        if (end.cores > 0 && end.cstates.size() == start_.cstates.size()) {
+            const double core_us = usage.elapsed_seconds * 1e6 * end.cores;
+            for (size_t i = 0; i < end.cstates.size(); i++) {
+                CStateResidency state;
+                state.name = end.cstates[i].name;
+                state.exit_latency_us = end.cstates[i].exit_latency_us;
+                state.residency_pct = 100.0 * static_cast<double>(
+                    end.cstates[i].time_us - start_.cstates[i].time_us) / core_us;
+                state.entries_per_sec = static_cast<double>(
+                    end.cstates[i].usage - start_.cstates[i].usage) / usage.elapsed_seconds;
+                usage.cstates.push_back(state);
+            }
+        }
+        return usage;
+    }
+
+private:
+    PowerSnapshot readSnapshot() const {
+        PowerSnapshot snap;
+        snap.time = std::chrono::steady_clock::now();
+        for (const auto& domain : domains_) {
+            uint64_t energy = 0;
+            readValue(domain / "energy_uj", energy);
+            snap.energy_uj.push_back(energy);
+        }
+        readCStates(snap);
+        return snap;
+    }
+
+    static void readCStates(PowerSnapshot& snap) {
+        std::error_code ec;
+        for (const auto& cpu : std::filesystem::directory_iterator(kCpuPath, ec)) {
+            const std::string name = cpu.path().filename().string();
+            if (name.size() < 4 || name.rfind("cpu", 0) != 0 ||
+                name.find_first_not_of("0123456789", 3) != std::string::npos) {
+                continue;
+            }
+            const auto idle = cpu.path() / "cpuidle";
+            bool counted = false;
+            for (size_t index = 0;; index++) {
+                const auto state = idle / ("state" + std::to_string(index));
+                uint64_t time_us = 0;
+                if (!readValue(state / "time", time_us)) {
+                    break;
+                }
+                uint64_t usage = 0;
+                uint64_t latency = 0;
+                readValue(state / "usage", usage);
+                readValue(state / "latency", latency);
+
+                if (index == snap.cstates.size()) {
+                    snap.cstates.push_back({readLine(state / "name"), 0, 0, 0});
+                }
+                CStateTotals& totals = snap.cstates[index];
+                totals.exit_latency_us = std::max(totals.exit_latency_us,
+                                                  static_cast<int>(latency));
+                totals.time_us += time_us;
+                totals.usage += usage;
+                counted = true;
+            }
+            if (counted) {
+                snap.cores++;
+            }
+        }
+    }
+
+    std::vector<std::filesystem::path> domains_;
+    std::vector<uint64_t> energy_ranges_;
+    PowerSnapshot start_;
+};
+
+std::unique_ptr<PowerMonitor> PowerMonitor::create() {
+    return std::make_unique<LinuxPowerMonitor>();
+}
+
+CpuLatencyRequest::~CpuLatencyRequest() {
+    release();
+}
+
+bool CpuLatencyRequest::acquire(int latency_us, std::string& error_message) {
+    release();
+    fd_ = open(kCpuLatencyDevice, O_WRONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        error_message = std::string("PM QoS: failed to open ") + kCpuLatencyDevice + ": " +
+                        std::strerror(errno);
+        return false;
+    }
+
+    // The device takes a binary 32-bit value in microseconds
+    const int32_t value = latency_us;
+    if (write(fd_, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+        error_message = std::string("PM QoS: failed to write ") + kCpuLatencyDevice + ": " +
+                        std::strerror(errno);
+        release();
+        return false;
+    }
+    return true;
+}
+
+void CpuLatencyRequest::release() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace video_bench
@@ -0,0 +1,35 @@
+#include "monitor/power_monitor.hpp"
+
+namespace video_bench {
+
+// No unprivileged package energy or idle state counters are exposed
+class MacOSPowerMonitor : public PowerMonitor {
+public:
+    MacOSPowerMonitor() = default;
+
+    bool isSupported() const override {
+        return false;
+    }
+
+    void startMeasurement() override {}
+
+    PowerUsage getUsage() override {
+        return {};
+    }
+};
+
+std::unique_ptr<PowerMonitor> PowerMonitor::create() {
+    return std::make_unique<MacOSPowerMonitor>();
+}
+
+CpuLatencyRequest::~CpuLatencyRequest() = default;
+
+bool CpuLatencyRequest::acquire(int latency_us, std::string& error_message) {
+    (void)latency_us;
+    error_message = "PM QoS requests are only supported on Linux";
+    return false;
+}
+
+void CpuLatencyRequest::release() {}
+
+} // namespace video_bench
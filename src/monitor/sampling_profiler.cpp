@@ -0,0 +1,357 @@
+#include "monitor/sampling_profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <cerrno>
+#include <cstdio>
+#include <csignal>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// Older glibc headers only expose the raw union member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace video_bench {
+
+namespace {
+// Deepest stack recorded per sample (leaf first)
+constexpr int kMaxDepth = 32;
+// Samples per session; later samples are counted as dropped
+constexpr size_t kSampleCapacity = size_t{1} << 16;
+// A caller's frame further than this from its callee ends the walk
+constexpr uintptr_t kMaxFrameSize = 1 << 20;
+// How often new threads are looked for
+constexpr auto kScanInterval = std::chrono::milliseconds(100);
+
+struct Sample {
+    std::atomic<bool> committed{false};
+    int depth = 0;
+    uintptr_t pcs[kMaxDepth];
+};
+
+// Shared with the signal handler: allocated once, never freed
+Sample* g_samples = nullptr;
+std::atomic<size_t> g_next_sample{0};
+std::atomic<int64_t> g_dropped{0};
+std::atomic<bool> g_active{false};
+std::once_flag g_handler_once;
+
+// Read memory without faulting: a bad frame pointer makes the syscall fail
+bool readWords(uintptr_t address, uintptr_t* out, size_t count) {
+    const size_t bytes = count * sizeof(uintptr_t);
+    iovec local{out, bytes};
+    iovec remote{reinterpret_cast<void*>(address), bytes};
+    return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == static_cast<ssize_t>(bytes);
+}
+
+void onSigprof(int, siginfo_t*, void* context) {
+    // Async-signal-safe only: atomics, a syscall, plain stores
+    const int saved_errno = errno;
+    if (!g_active.load(std::memory_order_acquire)) {
+        errno = saved_errno;
+        return;
+    }
+    size_t index = g_next_sample.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kSampleCapacity) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        errno = saved_errno;
+        return;
+    }
+
+    const auto* uc = static_cast<const ucontext_t*>(context);
+    uintptr_t pc = 0;
+    uintptr_t fp = 0;
+#if defined(__x86_64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+#elif defined(__aarch64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.pc);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.regs[29]);
+#else
+    (void)uc;
+#endif
+
+    Sample& sample = g_samples[index];
+    int depth = 0;
+    sample.pcs[depth++] = pc;
+    // Each frame record is {caller's frame pointer, return address}
+    while (depth < kMaxDepth && fp != 0 && fp % sizeof(uintptr_t) == 0) {
+        uintptr_t record[2];
+        if (!readWords(fp, record, 2) || record[1] == 0) {
+            break;
+        }
+        // Minus one lands inside the call instruction, not after it
+        sample.pcs[depth++] = record[1] - 1;
+        if (record[0] <= fp || record[0] - fp > kMaxFrameSize) {
+            break;  // Stacks grow down: the caller's frame must be above
+        }
+        fp = record[0];
+    }
+    sample.depth = depth;
+    sample.committed.store(true, std::memory_order_release);
+    errno = saved_errno;
+}
+
+// Function name (demangled) or module+offset for one address
+std::string symbolize(uintptr_t pc) {
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void*>(pc), &info) == 0) {
+        std::ostringstream out;
+        out << "0x" << std::hex << pc;
+        return out.str();
+    }
+    std::string name;
+    if (info.dli_sname) {
+        int status = 0;
+        std::unique_ptr<char, decltype(&std::free)> demangled(
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free);
+        name = (status == 0 && demangled) ? demangled.get() : info.dli_sname;
+    } else {
+        // Not exported: the module and offset still locate it (addr2line)
+        std::ostringstream out;
+        out << std::filesystem::path(info.dli_fname ? info.dli_fname : "?").filename().string()
+            << "+0x" << std::hex << (pc - reinterpret_cast<uintptr_t>(info.dli_fbase));
+        name = out.str();
+    }
+    // ';' separates frames in folded stacks
+    std::replace(name.begin(), name.end(), ';', ':');
+    return name;
+}
+} // namespace
+
+std::string ProfileReport::formatFlat() const {
+    std::ostringstream out;
+    out << "# samples: " << samples << ", dropped: " << dropped
+        << ", threads: " << threads << "\n";
+    out << "#   self%   total%     self    total  function\n";
+    for (const auto& entry : flat) {
+        double self_pct = samples > 0 ? 100.0 * entry.self_samples / samples : 0.0;
+        double total_pct = samples > 0 ? 100.0 * entry.total_samples / samples : 0.0;
+        char line[64];
+        std::snprintf(line, sizeof(line), "%8.2f %8.2f %8lld %8lld  ",
+                      self_pct, total_pct,
+                      static_cast<long long>(entry.self_samples),
+                      static_cast<long long>(entry.total_samples));
+        out << line << entry.symbol << "\n";
+    }
+    return out.str();
+}
+
+std::string ProfileReport::formatFolded() const {
+    std::ostringstream out;
+    for (const auto& [stack, count] : folded) {
+        out << stack << " " << count << "\n";
+    }
+    return out.str();
+}
+
+SamplingProfiler::SamplingProfiler(int hz)
+    : hz_(hz) {
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+}
+
+bool SamplingProfiler::start(std::string& error_message) {
+    if (running_) {
+        return true;
+    }
+
+    // Seccomp or the ptrace scope can deny reading our own memory; every
+    // stack would then silently stop at the leaf frame
+    uintptr_t probe[2] = {1, 2};
+    uintptr_t probe_out[2] = {};
+    if (!readWords(reinterpret_cast<uintptr_t>(probe), probe_out, 2)) {
+        error_message = "Profiler: process_vm_readv() is denied, stacks cannot be walked: " +
+                        std::string(std::strerror(errno));
+        return false;
+    }
+
+    bool handler_ok = true;
+    std::call_once(g_handler_once, [&handler_ok] {
+        g_samples = new Sample[kSampleCapacity];
+        // Installed for the life of the process: a late SIGPROF after
+        // stop() must not hit the default action (terminate)
+        struct sigaction action{};
+        action.sa_sigaction = onSigprof;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        handler_ok = sigaction(SIGPROF, &action, nullptr) == 0;
+    });
+    if (!handler_ok) {
+        error_message = "Profiler: failed to install SIGPROF handler: " +
+                        std::string(std::strerror(errno));
+        return false;
+    }
+
+    // The previous session's handlers are long finished
+    for (size_t i = 0; i < kSampleCapacity; i++) {
+        g_samples[i].committed.store(false, std::memory_order_relaxed);
+    }
+    g_next_sample.store(0, std::memory_order_relaxed);
+    g_dropped.store(0, std::memory_order_relaxed);
+    sampled_threads_.clear();
+    stopping_ = false;
+    g_active.store(true, std::memory_order_release);
+
+    scanner_ = std::thread([this] { scanLoop(); });
+    running_ = true;
+    return true;
+}
+
+void SamplingProfiler::stop() {
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    scanner_.join();
+
+    g_active.store(false, std::memory_order_release);
+    for (const auto& [tid, timer] : timers_) {
+        timer_delete(timer);
+    }
+    timers_.clear();
+    running_ = false;
+}
+
+void SamplingProfiler::armNewThreads() {
+    std::error_code ec;
+    std::set<pid_t> alive;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        pid_t tid = static_cast<pid_t>(std::strtol(entry.path().filename().c_str(), nullptr, 10));
+        if (tid <= 0 || tid == scanner_tid_) {
+            continue;
+        }
+        alive.insert(tid);
+        if (timers_.count(tid) > 0) {
+            continue;
+        }
+
+        // CPU clock of another thread: MAKE_THREAD_CPUCLOCK(tid, CPUCLOCK_SCHED)
+        clockid_t clock = static_cast<clockid_t>((~static_cast<clockid_t>(tid) << 3) | 6);
+        sigevent event{};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = tid;
+        timer_t timer;
+        if (timer_create(clock, &event, &timer) != 0) {
+            continue;  // Thread exited in between
+        }
+        long interval_ns = 1000000000L / hz_;
+        itimerspec spec{};
+        spec.it_interval.tv_sec = interval_ns / 1000000000L;
+        spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+        spec.it_value = spec.it_interval;
+        if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+            timer_delete(timer);
+            continue;
+        }
+        timers_[tid] = timer;
+        sampled_threads_.insert(tid);
+    }
+
+    // Drop timers of threads that exited (tids can be reused)
+    for (auto it = timers_.begin(); it != timers_.end();) {
+        if (alive.count(it->first) == 0) {
+            timer_delete(it->second);
+            it = timers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SamplingProfiler::scanLoop() {
+    scanner_tid_ = static_cast<pid_t>(syscall(SYS_gettid));
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        armNewThreads();
+        lock.lock();
+        cv_.wait_for(lock, kScanInterval, [this] { return stopping_; });
+    }
+}
+
+ProfileReport SamplingProfiler::report() const {
+    ProfileReport report;
+    report.dropped = g_dropped.load(std::memory_order_relaxed);
+    report.threads = static_cast<int>(sampled_threads_.size());
+    if (!g_samples) {
+        return report;
+    }
+
+    std::unordered_map<uintptr_t, std::string> symbols;
+    auto lookup = [&symbols](uintptr_t pc) -> const std::string& {
+        auto it = symbols.find(pc);
+        if (it == symbols.end()) {
+            it = symbols.emplace(pc, symbolize(pc)).first;
+        }
+        return it->second;
+    };
+
+    std::map<std::string, ProfileEntry> entries;
+    const size_t count = std::min(g_next_sample.load(std::memory_order_relaxed), kSampleCapacity);
+    for (size_t i = 0; i < count; i++) {
+        const Sample& sample = g_samples[i];
+        if (!sample.committed.load(std::memory_order_acquire) || sample.depth == 0) {
+            continue;
+        }
+        report.samples++;
+
+        std::vector<const std::string*> frames;
+        frames.reserve(sample.depth);
+        for (int d = 0; d < sample.depth; d++) {
+            frames.push_back(&lookup(sample.pcs[d]));
+        }
+
+        entries[*frames[0]].self_samples++;
+        // Recursion counts once toward total
+        std::set<std::string_view> seen;
+        for (const std::string* name : frames) {
+            if (seen.insert(*name).second) {
+                entries[*name].total_samples++;
+            }
+        }
+
+        std::string stack;
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (!stack.empty()) {
+                stack += ';';
+            }
+            stack += **it;
+        }
+        report.folded[stack]++;
+    }
+
+    for (auto& [name, entry] : entries) {
+        entry.symbol = name;
+        report.flat.push_back(std::move(entry));
+    }
+    std::sort(report.flat.begin(), report.flat.end(),
+              [](const ProfileEntry& a, const ProfileEntry& b) {
+                  return a.self_samples != b.self_samples
+                      ? a.self_samples > b.self_samples
+                      : a.total_samples > b.total_samples;
+              });
+    return report;
+}
+
+} // namespace video_bench
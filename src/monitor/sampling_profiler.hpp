@@ -0,0 +1,87 @@
+#ifndef SAMPLING_PROFILER_HPP
+#define SAMPLING_PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <sys/types.h>
+
+namespace video_bench {
+
+// One function in the flat profile
+struct ProfileEntry {
+    std::string symbol;
+    int64_t self_samples = 0;   // Samples with this function on top
+    int64_t total_samples = 0;  // Samples with this function anywhere on the stack
+};
+
+// Profile of one sampling session
+struct ProfileReport {
+    int64_t samples = 0;
+    int64_t dropped = 0;  // Samples lost because the buffer was full
+    int threads = 0;      // Threads that had a timer during the session
+    std::vector<ProfileEntry> flat;  // Sorted by self samples, descending
+    std::map<std::string, int64_t> folded;  // "root;...;leaf" -> samples
+
+    // Flat profile as text, ordered by self samples
+    std::string formatFlat() const;
+
+    // Folded stacks, one "stack count" line each (flamegraph.pl input)
+    std::string formatFolded() const;
+};
+
+// In-process sampling profiler (Linux).
+// Every thread of the process gets a timer on its own CPU clock that
+// delivers SIGPROF every 1/hz seconds of CPU time, so samples are spread by
+// CPU consumed, FFmpeg's internal worker threads included. The signal
+// handler walks frame pointers from the interrupted context into a
+// preallocated buffer; addresses are symbolized with dladdr() afterwards.
+// Frames compiled without frame pointers end the walk early.
+// Only one profiler may be running at a time.
+class SamplingProfiler {
+public:
+    explicit SamplingProfiler(int hz);
+    ~SamplingProfiler();
+
+    // Non-copyable, non-movable (owns a thread and the SIGPROF handler)
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+    SamplingProfiler(SamplingProfiler&&) = delete;
+    SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+
+    // Install the handler and start sampling all threads
+    bool start(std::string& error_message);
+
+    // Stop sampling and remove every timer
+    void stop();
+
+    // Aggregate and symbolize the samples of the last session (after stop())
+    ProfileReport report() const;
+
+private:
+    // Give every thread without one a CPU-time timer
+    void armNewThreads();
+
+    void scanLoop();
+
+    int hz_;
+    bool running_ = false;
+    pid_t scanner_tid_ = 0;
+    std::map<pid_t, timer_t> timers_;  // Scanner thread, then stop()
+    std::set<pid_t> sampled_threads_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread scanner_;
+};
+
+} // namespace video_bench
+
+#endif // SAMPLING_PROFILER_HPP
@@ -6,6 +6,12 @@
 #include <array>
 #include <cstdio>
 
+#if !defined(_WIN32)
+#include <sys/utsname.h>
+#include <sys/resource.h>
+#include <climits>
+#endif
+
 #if defined(__APPLE__)
 #include <sys/sysctl.h>
 #elif defined(_WIN32)
@@ -231,4 +237,62 @@ unsigned int SystemInfo::getThreadCount() {
     return count > 0 ? count : 1;
 }
 
+std::string SystemInfo::getMicrocodeVersion() {
+#if defined(__linux__)
+    return parseCpuinfoField("microcode");
+#else
+    return "";
+#endif
+}
+
+std::string SystemInfo::getKernelVersion() {
+#if !defined(_WIN32)
+    struct utsname info{};
+    if (uname(&info) == 0) {
+        return std::string(info.sysname) + " " + info.release + " " + info.version;
+    }
+#endif
+    return "";
+}
+
+std::string SystemInfo::getCpuGovernor() {
+#if defined(__linux__)
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    std::string governor;
+    if (file.is_open()) {
+        std::getline(file, governor);
+    }
+    return governor;
+#else
+    return "";
+#endif
+}
+
+uint64_t SystemInfo::raiseFileDescriptorLimit() {
+#if !defined(_WIN32)
+    struct rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 0;
+    }
+
+    rlim_t target = limit.rlim_max;
+#if defined(__APPLE__)
+    // macOS rejects soft limits above OPEN_MAX even when the hard limit is unlimited
+    if (target == RLIM_INFINITY || target > OPEN_MAX) {
+        target = OPEN_MAX;
+    }
+#endif
+    if (limit.rlim_cur < target) {
+        struct rlimit raised = limit;
+        raised.rlim_cur = target;
+        if (setrlimit(RLIMIT_NOFILE, &raised) == 0) {
+            limit = raised;
+        }
+    }
+    return static_cast<uint64_t>(limit.rlim_cur);
+#else
+    return 0;
+#endif
+}
+
 } // namespace video_bench
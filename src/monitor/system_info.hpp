@@ -2,6 +2,7 @@
 #define SYSTEM_INFO_HPP
 
 #include <string>
+#include <cstdint>
 
 namespace video_bench {
 
@@ -12,6 +13,19 @@ public:
 
     // Get number of hardware threads
     static unsigned int getThreadCount();
+
+    // Get CPU microcode revision (empty if unavailable)
+    static std::string getMicrocodeVersion();
+
+    // Get kernel release and build string (empty if unavailable)
+    static std::string getKernelVersion();
+
+    // Get CPU frequency scaling governor of cpu0 (empty if unavailable)
+    static std::string getCpuGovernor();
+
+    // Raise the open file descriptor soft limit to the hard limit
+    // Returns the resulting soft limit (0 if unsupported)
+    static uint64_t raiseFileDescriptorLimit();
 };
 
 } // namespace video_bench
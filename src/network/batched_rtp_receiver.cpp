@@ -0,0 +1,234 @@
+#include "network/batched_rtp_receiver.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <cstring>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+constexpr int kBatchSize = 64;
+constexpr size_t kMaxDatagram = 2048;
+constexpr int kReceiveBufferBytes = 8 * 1024 * 1024;
+constexpr int kReceiveTimeoutMs = 100;
+
+uint32_t readSsrc(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[8]) << 24) | (data[9] << 16) |
+           (data[10] << 8) | data[11];
+}
+} // namespace
+
+BatchedRtpReceiver::BatchedRtpReceiver(const std::string& url, int receiver_threads,
+                                       std::atomic<bool>& stop_flag,
+                                       const MeasurementWindow* window)
+    : url_(url)
+    , receiver_threads_(receiver_threads)
+    , stop_flag_(stop_flag)
+    , window_(window) {
+}
+
+BatchedRtpReceiver::~BatchedRtpReceiver() {
+    stop();
+    avcodec_parameters_free(&codec_params_);
+}
+
+bool BatchedRtpReceiver::open(const std::vector<PacketQueue*>& queues,
+                              std::string& error_message) {
+    // All receiver sockets share one port; the kernel hashes each session's
+    // flow to a single socket, so a depacketizer is only fed by one thread
+    int port = 0;
+    for (int i = 0; i < receiver_threads_; i++) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) {
+            error_message = "Batched UDP: cannot create socket";
+            return false;
+        }
+        sockets_.push_back(fd);
+
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &kReceiveBufferBytes, sizeof(kReceiveBufferBytes));
+        timeval timeout{0, kReceiveTimeoutMs * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            error_message = "Batched UDP: cannot bind receive port";
+            return false;
+        }
+        if (port == 0) {
+            socklen_t len = sizeof(addr);
+            getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+            port = ntohs(addr.sin_port);
+        }
+    }
+
+    // One RTSP session per stream, all delivering to the shared port
+    SdpVideoTrack track;
+    sessions_.reserve(queues.size());
+    streams_.reserve(queues.size());
+    for (size_t i = 0; i < queues.size(); i++) {
+        RtspClient session;
+        std::string sdp;
+        if (!session.connect(url_, error_message) ||
+            !session.describe(sdp, error_message)) {
+            return false;
+        }
+        if (i == 0 && !parseSdpVideoTrack(sdp, track, error_message)) {
+            return false;
+        }
+
+        uint32_t ssrc = 0;
+        if (!session.setupUdp(track.control, port, ssrc, error_message)) {
+            return false;
+        }
+        if (!stream_by_ssrc_.emplace(ssrc, i).second) {
+            error_message = "Batched UDP: server reused an SSRC across sessions";
+            return false;
+        }
+
+        sessions_.push_back(std::move(session));
+        streams_.push_back(Stream{queues[i], std::make_unique<RtpDepacketizer>(track.codec_id), {}});
+    }
+
+    codec_params_ = avcodec_parameters_alloc();
+    if (!codec_params_) {
+        error_message = "Batched UDP: failed to allocate codec parameters";
+        return false;
+    }
+    codec_params_->codec_type = AVMEDIA_TYPE_VIDEO;
+    codec_params_->codec_id = track.codec_id;
+    if (!track.extradata.empty()) {
+        codec_params_->extradata = static_cast<uint8_t*>(
+            av_mallocz(track.extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+        if (!codec_params_->extradata) {
+            error_message = "Batched UDP: failed to allocate extradata";
+            return false;
+        }
+        std::memcpy(codec_params_->extradata, track.extradata.data(), track.extradata.size());
+        codec_params_->extradata_size = static_cast<int>(track.extradata.size());
+    }
+    return true;
+}
+
+void BatchedRtpReceiver::addObserver(size_t stream, PacketObserver* observer) {
+    streams_[stream].observers.push_back(observer);
+}
+
+bool BatchedRtpReceiver::start(std::string& error_message) {
+    for (int fd : sockets_) {
+        threads_.emplace_back([this, fd] { receiveLoop(fd); });
+    }
+    for (auto& session : sessions_) {
+        if (!session.play(error_message)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BatchedRtpReceiver::stop() {
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    for (auto& session : sessions_) {
+        session.teardown();
+    }
+    sessions_.clear();
+
+    for (int fd : sockets_) {
+        close(fd);
+    }
+    sockets_.clear();
+
+    std::lock_guard lock(counters_mutex_);
+    for (const auto& stream : streams_) {
+        counters_.lost_packets += stream.depacketizer->getLostPackets();
+        stream.queue->signalEof();
+    }
+    streams_.clear();
+}
+
+RtpReceiveCounters BatchedRtpReceiver::getCounters() const {
+    std::lock_guard lock(counters_mutex_);
+    return counters_;
+}
+
+void BatchedRtpReceiver::receiveLoop(int fd) {
+    std::vector<uint8_t> buffers(kBatchSize * kMaxDatagram);
+    mmsghdr messages[kBatchSize];
+    iovec iovecs[kBatchSize];
+    UniqueAVPacket packet(av_packet_alloc());
+
+    int64_t recv_calls = 0;
+    int64_t datagrams = 0;
+    int64_t window_recv_calls = 0;
+    int64_t window_datagrams = 0;
+    int64_t dropped_units = 0;
+
+    while (!stop_flag_.load(std::memory_order_acquire)) {
+        std::memset(messages, 0, sizeof(messages));
+        for (int i = 0; i < kBatchSize; i++) {
+            iovecs[i].iov_base = buffers.data() + i * kMaxDatagram;
+            iovecs[i].iov_len = kMaxDatagram;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Block for the first datagram (up to the socket timeout), then take
+        // whatever else is already queued without waiting
+        int count = recvmmsg(fd, messages, kBatchSize, MSG_WAITFORONE, nullptr);
+        recv_calls++;
+        const bool in_window = window_ && window_->contains(MeasurementWindow::nowNs());
+        if (in_window) {
+            window_recv_calls++;
+        }
+        if (count <= 0) {
+            continue;
+        }
+        datagrams += count;
+        if (in_window) {
+            window_datagrams += count;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const auto* data = static_cast<const uint8_t*>(iovecs[i].iov_base);
+            size_t size = messages[i].msg_len;
+            if (size < 12) continue;
+
+            auto it = stream_by_ssrc_.find(readSsrc(data));
+            if (it == stream_by_ssrc_.end()) continue;
+
+            Stream& stream = streams_[it->second];
+            stream.depacketizer->push(data, size);
+            while (stream.depacketizer->pop(packet.get())) {
+                for (PacketObserver* observer : stream.observers) {
+                    observer->onPacket(packet.get());
+                }
+                // Never stall the socket on a slow decoder: drop the unit instead
+                if (!stream.queue->push(packet.get(), std::chrono::milliseconds(0))) {
+                    dropped_units++;
+                }
+                av_packet_unref(packet.get());
+            }
+        }
+    }
+
+    std::lock_guard lock(counters_mutex_);
+    counters_.recv_calls += recv_calls;
+    counters_.datagrams += datagrams;
+    counters_.window_recv_calls += window_recv_calls;
+    counters_.window_datagrams += window_datagrams;
+    counters_.dropped_units += dropped_units;
+}
+
+} // namespace video_bench
@@ -0,0 +1,95 @@
+#ifndef BATCHED_RTP_RECEIVER_HPP
+#define BATCHED_RTP_RECEIVER_HPP
+
+#include "decoder/measurement_window.hpp"
+#include "decoder/packet_queue.hpp"
+#include "decoder/packet_observer.hpp"
+#include "network/rtsp_client.hpp"
+#include "network/rtp_depacketizer.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+namespace video_bench {
+
+// Receive-side counters (all receiver threads combined)
+struct RtpReceiveCounters {
+    int64_t recv_calls = 0;       // recvmmsg() syscalls, including timeouts
+    int64_t datagrams = 0;
+    int64_t window_recv_calls = 0;  // Inside the measurement window
+    int64_t window_datagrams = 0;
+    int64_t lost_packets = 0;     // Sequence gaps seen by the depacketizers
+    int64_t dropped_units = 0;    // Access units dropped on a full decoder queue
+};
+
+// RTP-over-UDP ingest for many RTSP sessions without FFmpeg's per-packet
+// recvfrom: all sessions share one UDP port served by a few SO_REUSEPORT
+// sockets, each drained with recvmmsg() batches. Packets are demultiplexed
+// by SSRC and depacketized into access units for the decoder queues.
+class BatchedRtpReceiver {
+public:
+    // window: recvmmsg() calls inside it are counted separately (nullptr = none)
+    BatchedRtpReceiver(const std::string& url, int receiver_threads,
+                       std::atomic<bool>& stop_flag,
+                       const MeasurementWindow* window = nullptr);
+    ~BatchedRtpReceiver();
+
+    // Non-copyable, non-movable (owns threads)
+    BatchedRtpReceiver(const BatchedRtpReceiver&) = delete;
+    BatchedRtpReceiver& operator=(const BatchedRtpReceiver&) = delete;
+    BatchedRtpReceiver(BatchedRtpReceiver&&) = delete;
+    BatchedRtpReceiver& operator=(BatchedRtpReceiver&&) = delete;
+
+    // Bind the shared port and set up one RTSP session per queue
+    bool open(const std::vector<PacketQueue*>& queues, std::string& error_message);
+
+    // Codec parameters from the SDP (valid after open())
+    const AVCodecParameters* getCodecParameters() const { return codec_params_; }
+
+    // Also pass the stream's access units to observer before they are queued,
+    // on the receiver thread (call after open(), before start())
+    void addObserver(size_t stream, PacketObserver* observer);
+
+    // PLAY all sessions and start the receiver threads
+    bool start(std::string& error_message);
+
+    // Stop threads, tear down sessions and signal EOF to the queues
+    void stop();
+
+    // Get accumulated counters (call after stop())
+    RtpReceiveCounters getCounters() const;
+
+private:
+    struct Stream {
+        PacketQueue* queue;
+        std::unique_ptr<RtpDepacketizer> depacketizer;
+        std::vector<PacketObserver*> observers;
+    };
+
+    void receiveLoop(int fd);
+
+    std::string url_;
+    int receiver_threads_;
+    std::atomic<bool>& stop_flag_;
+    const MeasurementWindow* window_;
+
+    std::vector<int> sockets_;
+    std::vector<RtspClient> sessions_;
+    std::vector<Stream> streams_;
+    std::unordered_map<uint32_t, size_t> stream_by_ssrc_;  // Read-only once started
+    AVCodecParameters* codec_params_ = nullptr;
+
+    mutable std::mutex counters_mutex_;
+    RtpReceiveCounters counters_;
+
+    std::vector<std::thread> threads_;
+};
+
+} // namespace video_bench
+
+#endif // BATCHED_RTP_RECEIVER_HPP
@@ -0,0 +1,215 @@
+#include "network/fleet_agent.hpp"
+#include "network/fleet_protocol.hpp"
+#include "benchmark/benchmark_runner.hpp"
+#include "benchmark/result_serializer.hpp"
+#include "monitor/memory_monitor.hpp"
+#include "monitor/system_info.hpp"
+#include "utils/cli_parser.hpp"
+#include "utils/logger.hpp"
+#include "video/video_info.hpp"
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+// Parse a STEP payload ("stream_count=N\nstart_at_ms=T")
+bool parseStep(const std::string& payload, int& stream_count, int64_t& start_at_ms) {
+    std::istringstream in(payload);
+    std::string line;
+    bool has_count = false;
+    bool has_start = false;
+    while (std::getline(in, line)) {
+        size_t pos = line.find('=');
+        if (pos == std::string::npos) continue;
+        std::istringstream value(line.substr(pos + 1));
+        const std::string key = line.substr(0, pos);
+        if (key == "stream_count") {
+            has_count = static_cast<bool>(value >> stream_count);
+        } else if (key == "start_at_ms") {
+            has_start = static_cast<bool>(value >> start_at_ms);
+        }
+    }
+    return has_count && has_start && stream_count > 0;
+}
+} // namespace
+
+FleetAgent::FleetAgent(std::string listen)
+    : listen_(std::move(listen)) {
+}
+
+FleetAgent::~FleetAgent() {
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+    }
+}
+
+bool FleetAgent::start(std::string& error_message) {
+    std::string address = "0.0.0.0";
+    std::string port = listen_;
+    size_t colon = listen_.rfind(':');
+    if (colon != std::string::npos) {
+        address = listen_.substr(0, colon);
+        port = listen_.substr(colon + 1);
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(std::atoi(port.c_str())));
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+        error_message = "Fleet agent: invalid listen address " + address;
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        error_message = "Fleet agent: socket() failed: " + std::string(std::strerror(errno));
+        return false;
+    }
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listen_fd_, 4) != 0) {
+        error_message = "Fleet agent: cannot listen on " + listen_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    return true;
+}
+
+void FleetAgent::serve() {
+    while (true) {
+        sockaddr_in peer{};
+        socklen_t len = sizeof(peer);
+        int fd = accept4(listen_fd_, reinterpret_cast<sockaddr*>(&peer), &len, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EINTR) {
+                Logger::error("Fleet agent: accept() failed: " + std::string(std::strerror(errno)));
+            }
+            continue;
+        }
+        char host[INET_ADDRSTRLEN] = "?";
+        inet_ntop(AF_INET, &peer.sin_addr, host, sizeof(host));
+        FleetConnection connection(fd, std::string(host) + ":" + std::to_string(ntohs(peer.sin_port)));
+        Logger::info("Fleet agent: coordinator " + connection.getPeer() + " connected");
+        runSession(connection);
+        Logger::info("Fleet agent: session with " + connection.getPeer() + " ended");
+    }
+}
+
+void FleetAgent::runSession(FleetConnection& connection) {
+    std::string type;
+    std::string payload;
+    std::string error;
+
+    // Report to the coordinator and end the session
+    auto fail = [&connection](const std::string& message) {
+        std::string send_error;
+        connection.send(fleet::kError, message, send_error);
+        Logger::error("Fleet agent: " + message);
+    };
+
+    if (!connection.receive(type, payload, error) || type != fleet::kConfig) {
+        Logger::error(error.empty() ? "Fleet agent: expected " + std::string(fleet::kConfig) : error);
+        return;
+    }
+
+    // The coordinator's command line, parsed as if given here
+    std::vector<std::string> args = {"video-benchmark"};
+    std::istringstream in(payload);
+    std::string arg;
+    while (std::getline(in, arg)) {
+        args.push_back(arg);
+    }
+    std::vector<char*> argv;
+    for (auto& a : args) {
+        argv.push_back(a.data());
+    }
+    auto parse_result = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    const BenchmarkConfig& config = parse_result.config;
+    if (!parse_result.success) {
+        fail(parse_result.error_message);
+        return;
+    }
+    if (config.stand_in || !config.segment_format.empty() || !config.sched_compare.empty() ||
+        config.cache_dir || !config.agent_listen.empty() || !config.coordinator_agents.empty()) {
+        fail("--stand-in, --segmented, --sched-compare, --cache-dir and fleet options "
+             "are not supported on agents");
+        return;
+    }
+    // Steps only measure the base ladder; the comparison ladders would be lost
+    if (config.record_dir || config.cpu_latency_us || !config.playback_speeds.empty() ||
+        !config.temporal_layers.empty() || config.mosaic_canvases.size() > 1) {
+        fail("--record, --cpu-latency, --playback, --temporal-layers and more than one "
+             "--mosaic canvas are not supported on agents");
+        return;
+    }
+
+    auto video_info = VideoAnalyzer::analyze(config.video_path, error);
+    if (!video_info || !video_info->isCodecSupported()) {
+        fail(video_info ? "Unsupported codec: " + video_info->codec_name : error);
+        return;
+    }
+
+    BenchmarkRunner runner(config, *video_info);
+    if (!runner.prepare(error)) {
+        fail(error);
+        return;
+    }
+
+    BenchmarkResult host;
+    host.cpu_name = SystemInfo::getCpuName();
+    host.thread_count = SystemInfo::getThreadCount();
+    host.total_system_memory_mb = MemoryMonitor::create()->getTotalSystemMemoryMB();
+    host.video_path = config.video_path;
+    host.video_resolution = video_info->getResolutionString();
+    host.codec_name = video_info->codec_name;
+    host.video_fps = video_info->fps;
+    host.is_live_stream = video_info->is_live_stream;
+    host.target_fps = runner.getTargetFps();
+    if (!connection.send(fleet::kReady, ResultSerializer::serializeHost(host), error)) {
+        Logger::error(error);
+        return;
+    }
+
+    while (connection.receive(type, payload, error)) {
+        if (type == fleet::kBye) {
+            return;
+        }
+        int stream_count = 0;
+        int64_t start_at_ms = 0;
+        if (type != fleet::kStep || !parseStep(payload, stream_count, start_at_ms)) {
+            fail("Unexpected message " + type);
+            return;
+        }
+
+        // Every agent starts the step at the same wall-clock time
+        std::this_thread::sleep_until(std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(start_at_ms)));
+        Logger::info("Fleet agent: " + std::to_string(stream_count) + " streams");
+
+        StreamTestResult result;
+        if (!runner.runStep(stream_count, result, error)) {
+            fail(error);
+            return;
+        }
+        if (!connection.send(fleet::kResult, ResultSerializer::serialize(result), error)) {
+            Logger::error(error);
+            return;
+        }
+    }
+    Logger::error(error);
+}
+
+} // namespace video_bench
@@ -0,0 +1,47 @@
+#ifndef FLEET_AGENT_HPP
+#define FLEET_AGENT_HPP
+
+#include <string>
+
+namespace video_bench {
+
+class FleetConnection;
+
+// Fleet agent (--agent): waits for a coordinator on a TCP port and runs the
+// tests it asks for on this host. Per session the coordinator sends a
+// command line, the agent analyzes the source and answers with its host
+// info, then runs one stream count per STEP at the requested wall-clock
+// time and returns the serialized result. Sessions are served one at a
+// time, forever. There is no authentication: listen on a trusted network.
+class FleetAgent {
+public:
+    // listen: "PORT" (all interfaces) or "ADDR:PORT"; port 0 picks one
+    explicit FleetAgent(std::string listen);
+    ~FleetAgent();
+
+    // Non-copyable, non-movable (owns a socket)
+    FleetAgent(const FleetAgent&) = delete;
+    FleetAgent& operator=(const FleetAgent&) = delete;
+    FleetAgent(FleetAgent&&) = delete;
+    FleetAgent& operator=(FleetAgent&&) = delete;
+
+    // Bind and listen
+    bool start(std::string& error_message);
+
+    // Port listened on (valid after start())
+    int getPort() const { return port_; }
+
+    // Accept and serve coordinator sessions until the process exits
+    void serve();
+
+private:
+    void runSession(FleetConnection& connection);
+
+    std::string listen_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+};
+
+} // namespace video_bench
+
+#endif // FLEET_AGENT_HPP
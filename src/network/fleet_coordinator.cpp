@@ -0,0 +1,133 @@
+#include "network/fleet_coordinator.hpp"
+#include "network/fleet_protocol.hpp"
+#include "benchmark/benchmark_runner.hpp"
+#include "benchmark/result_serializer.hpp"
+#include <chrono>
+#include <memory>
+#include <algorithm>
+
+namespace video_bench {
+
+namespace {
+// Lead time between sending a step and its start, covering network latency
+constexpr int64_t kStepStartDelayMs = 1000;
+} // namespace
+
+FleetCoordinator::FleetCoordinator(std::vector<std::string> agents,
+                                   std::vector<std::string> agent_args,
+                                   std::optional<int> max_streams, bool substream_mode)
+    : agents_(std::move(agents))
+    , agent_args_(std::move(agent_args))
+    , max_streams_(max_streams)
+    , substream_mode_(substream_mode) {
+}
+
+FleetResult FleetCoordinator::run(FleetProgressCallback progress_callback) {
+    FleetResult fleet_result;
+    std::string error;
+    auto agentError = [&fleet_result](const std::string& agent, const std::string& message) {
+        fleet_result.error_message = "Agent " + agent + ": " + message;
+        return fleet_result;
+    };
+
+    std::string config;
+    for (const auto& arg : agent_args_) {
+        config += arg + "\n";
+    }
+
+    // Connect and configure every agent before the first step
+    std::vector<std::unique_ptr<FleetConnection>> connections;
+    for (const auto& agent : agents_) {
+        auto connection = FleetConnection::connect(agent, error);
+        if (!connection || !connection->send(fleet::kConfig, config, error)) {
+            fleet_result.error_message = error;
+            return fleet_result;
+        }
+        connections.push_back(std::move(connection));
+    }
+
+    std::vector<int> max_streams;
+    int ladder_max = 0;
+    for (size_t i = 0; i < connections.size(); i++) {
+        std::string type;
+        std::string payload;
+        if (!connections[i]->receive(type, payload, error)) {
+            fleet_result.error_message = error;
+            return fleet_result;
+        }
+        FleetHostResult host;
+        host.agent = agents_[i];
+        if (type != fleet::kReady || !ResultSerializer::deserializeHost(payload, host.result)) {
+            return agentError(agents_[i], type == fleet::kError ? payload : "unexpected reply " + type);
+        }
+        host.result.max_streams = 0;
+        fleet_result.hosts.push_back(std::move(host));
+
+        int agent_max = max_streams_.value_or(BenchmarkRunner::getDefaultMaxStreams(
+            substream_mode_, fleet_result.hosts.back().result.thread_count));
+        max_streams.push_back(agent_max);
+        ladder_max = std::max(ladder_max, agent_max);
+    }
+
+    std::vector<bool> done(connections.size(), false);
+    for (int count : BenchmarkRunner::getStreamCountsToTest(ladder_max, substream_mode_)) {
+        std::vector<size_t> active;
+        for (size_t i = 0; i < connections.size(); i++) {
+            if (!done[i] && count <= max_streams[i]) {
+                active.push_back(i);
+            }
+        }
+        if (active.empty()) {
+            break;
+        }
+
+        // Same start time for all, taken from the coordinator's clock
+        int64_t start_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() + kStepStartDelayMs;
+        std::string step = "stream_count=" + std::to_string(count) +
+                           "\nstart_at_ms=" + std::to_string(start_at_ms) + "\n";
+        for (size_t i : active) {
+            if (!connections[i]->send(fleet::kStep, step, error)) {
+                fleet_result.error_message = error;
+                return fleet_result;
+            }
+        }
+
+        for (size_t i : active) {
+            std::string type;
+            std::string payload;
+            if (!connections[i]->receive(type, payload, error)) {
+                fleet_result.error_message = error;
+                return fleet_result;
+            }
+            std::optional<StreamTestResult> result;
+            if (type == fleet::kResult) {
+                result = ResultSerializer::deserialize(payload);
+            }
+            if (!result) {
+                return agentError(agents_[i], type == fleet::kError ? payload : "malformed result");
+            }
+
+            BenchmarkResult& host = fleet_result.hosts[i].result;
+            host.test_results.push_back(*result);
+            if (progress_callback) {
+                progress_callback(agents_[i], *result);
+            }
+            if (result->passed) {
+                host.max_streams = count;
+            } else {
+                done[i] = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < connections.size(); i++) {
+        connections[i]->send(fleet::kBye, "", error);
+        fleet_result.hosts[i].result.success = true;
+        fleet_result.total_max_streams += fleet_result.hosts[i].result.max_streams;
+    }
+    fleet_result.success = true;
+    return fleet_result;
+}
+
+} // namespace video_bench
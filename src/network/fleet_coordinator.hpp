@@ -0,0 +1,36 @@
+#ifndef FLEET_COORDINATOR_HPP
+#define FLEET_COORDINATOR_HPP
+
+#include "benchmark/benchmark_result.hpp"
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+
+namespace video_bench {
+
+// Progress callback: agent address and its result for the step
+using FleetProgressCallback = std::function<void(const std::string&, const StreamTestResult&)>;
+
+// Fleet coordinator (--coordinator): sends one command line to every agent,
+// then walks the stream count ladder with all agents in lockstep. Each step
+// starts on every agent at the same wall-clock time, so shared resources
+// (storage, network) see the combined load. An agent drops out after its
+// first failing step; the run ends when none is left. No bisection.
+class FleetCoordinator {
+public:
+    FleetCoordinator(std::vector<std::string> agents, std::vector<std::string> agent_args,
+                     std::optional<int> max_streams, bool substream_mode);
+
+    FleetResult run(FleetProgressCallback progress_callback = nullptr);
+
+private:
+    std::vector<std::string> agents_;
+    std::vector<std::string> agent_args_;
+    std::optional<int> max_streams_;
+    bool substream_mode_;
+};
+
+} // namespace video_bench
+
+#endif // FLEET_COORDINATOR_HPP
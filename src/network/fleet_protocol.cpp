@@ -0,0 +1,131 @@
+#include "network/fleet_protocol.hpp"
+#include <cstring>
+#include <cstdlib>
+#include <utility>
+#include <cerrno>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+// Largest payload accepted (a result with thousands of streams is ~100 KB)
+constexpr size_t kMaxPayloadBytes = 16 << 20;
+// A header longer than this is not a header
+constexpr size_t kMaxHeaderBytes = 64;
+} // namespace
+
+FleetConnection::FleetConnection(int fd, std::string peer)
+    : fd_(fd), peer_(std::move(peer)) {
+    // Small request/response messages: do not wait to coalesce
+    int one = 1;
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+FleetConnection::~FleetConnection() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+std::unique_ptr<FleetConnection> FleetConnection::connect(const std::string& address,
+                                                          std::string& error_message) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+        error_message = "Fleet: agent address must be host:port: " + address;
+        return nullptr;
+    }
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        error_message = "Fleet: cannot resolve " + host;
+        return nullptr;
+    }
+
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0) {
+        error_message = "Fleet: cannot connect to agent " + address;
+        return nullptr;
+    }
+    return std::make_unique<FleetConnection>(fd, address);
+}
+
+bool FleetConnection::send(const std::string& type, const std::string& payload,
+                           std::string& error_message) {
+    std::string frame = type + " " + std::to_string(payload.size()) + "\n" + payload;
+    size_t offset = 0;
+    while (offset < frame.size()) {
+        ssize_t sent = ::send(fd_, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            error_message = "Fleet: send to " + peer_ + " failed: " + std::strerror(errno);
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool FleetConnection::receive(std::string& type, std::string& payload,
+                              std::string& error_message) {
+    // Read until the header and its full payload are buffered
+    size_t header_end = std::string::npos;
+    size_t payload_size = 0;
+    while (true) {
+        if (header_end == std::string::npos) {
+            header_end = buffer_.find('\n');
+            if (header_end != std::string::npos) {
+                std::string header = buffer_.substr(0, header_end);
+                size_t space = header.find(' ');
+                char* end = nullptr;
+                unsigned long long size = space == std::string::npos ? 0
+                    : std::strtoull(header.c_str() + space + 1, &end, 10);
+                if (space == std::string::npos || space == 0 || *end != '\0' ||
+                    size > kMaxPayloadBytes) {
+                    error_message = "Fleet: malformed message from " + peer_;
+                    return false;
+                }
+                type = header.substr(0, space);
+                payload_size = static_cast<size_t>(size);
+            } else if (buffer_.size() > kMaxHeaderBytes) {
+                error_message = "Fleet: malformed message from " + peer_;
+                return false;
+            }
+        }
+        if (header_end != std::string::npos && buffer_.size() >= header_end + 1 + payload_size) {
+            payload = buffer_.substr(header_end + 1, payload_size);
+            buffer_.erase(0, header_end + 1 + payload_size);
+            return true;
+        }
+
+        char chunk[16384];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            error_message = "Fleet: connection to " + peer_ + " closed";
+            return false;
+        }
+        buffer_.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+} // namespace video_bench
@@ -0,0 +1,55 @@
+#ifndef FLEET_PROTOCOL_HPP
+#define FLEET_PROTOCOL_HPP
+
+#include <string>
+#include <memory>
+
+namespace video_bench {
+
+// Message types between a fleet coordinator and its agents
+//   coordinator -> agent: CONFIG (command line, one argument per line),
+//                         STEP (stream_count, start_at_ms), BYE
+//   agent -> coordinator: READY (ResultSerializer host fields),
+//                         RESULT (ResultSerializer test result), ERROR (text)
+namespace fleet {
+inline constexpr const char* kConfig = "CONFIG";
+inline constexpr const char* kReady = "READY";
+inline constexpr const char* kStep = "STEP";
+inline constexpr const char* kResult = "RESULT";
+inline constexpr const char* kError = "ERROR";
+inline constexpr const char* kBye = "BYE";
+} // namespace fleet
+
+// One TCP connection carrying framed messages: "<TYPE> <length>\n" followed
+// by <length> bytes of payload. Blocking; one message in flight per side.
+class FleetConnection {
+public:
+    explicit FleetConnection(int fd, std::string peer);
+    ~FleetConnection();
+
+    // Non-copyable, non-movable (owns a socket)
+    FleetConnection(const FleetConnection&) = delete;
+    FleetConnection& operator=(const FleetConnection&) = delete;
+    FleetConnection(FleetConnection&&) = delete;
+    FleetConnection& operator=(FleetConnection&&) = delete;
+
+    // Connect to "host:port"; nullptr with error_message on failure
+    static std::unique_ptr<FleetConnection> connect(const std::string& address,
+                                                    std::string& error_message);
+
+    bool send(const std::string& type, const std::string& payload, std::string& error_message);
+
+    // Wait for the next message; false on disconnect or a malformed frame
+    bool receive(std::string& type, std::string& payload, std::string& error_message);
+
+    const std::string& getPeer() const { return peer_; }
+
+private:
+    int fd_;
+    std::string peer_;
+    std::string buffer_;  // Bytes received past the last message
+};
+
+} // namespace video_bench
+
+#endif // FLEET_PROTOCOL_HPP
@@ -0,0 +1,190 @@
+#include "network/rtp_depacketizer.hpp"
+#include <cstring>
+
+namespace video_bench {
+
+namespace {
+constexpr uint8_t kStartCode[] = {0, 0, 0, 1};
+
+// H.264 aggregation/fragmentation NAL types
+constexpr int kH264StapA = 24;
+constexpr int kH264FuA = 28;
+// H.265 aggregation/fragmentation NAL types
+constexpr int kH265Ap = 48;
+constexpr int kH265Fu = 49;
+
+// Random access points
+constexpr int kH264Idr = 5;
+constexpr int kH265IrapFirst = 16;
+constexpr int kH265IrapLast = 23;
+} // namespace
+
+RtpDepacketizer::RtpDepacketizer(AVCodecID codec_id)
+    : codec_id_(codec_id) {
+}
+
+void RtpDepacketizer::push(const uint8_t* data, size_t size) {
+    if (size < 12 || (data[0] >> 6) != 2) {
+        return;
+    }
+
+    bool padding = (data[0] & 0x20) != 0;
+    bool extension = (data[0] & 0x10) != 0;
+    size_t csrc_count = data[0] & 0x0f;
+    bool marker = (data[1] & 0x80) != 0;
+    uint16_t seq = static_cast<uint16_t>((data[2] << 8) | data[3]);
+    uint32_t timestamp = (static_cast<uint32_t>(data[4]) << 24) | (data[5] << 16) |
+                         (data[6] << 8) | data[7];
+
+    size_t offset = 12 + csrc_count * 4;
+    if (extension) {
+        if (size < offset + 4) return;
+        offset += 4 + 4 * static_cast<size_t>((data[offset + 2] << 8) | data[offset + 3]);
+    }
+    if (size <= offset) {
+        return;
+    }
+    if (padding) {
+        // The last byte counts the padding, itself included
+        size_t pad = data[size - 1];
+        if (pad == 0 || pad >= size - offset) {
+            return;
+        }
+        size -= pad;
+    }
+
+    if (started_) {
+        auto gap = static_cast<uint16_t>(seq - next_seq_);
+        if (gap != 0) {
+            if (gap > 0x8000) {
+                return;  // Late or duplicate packet
+            }
+            lost_packets_ += gap;
+            current_corrupt_ = true;
+        }
+        if (timestamp < last_timestamp_ && last_timestamp_ - timestamp > 0x80000000u) {
+            timestamp_base_ += int64_t{1} << 32;
+        }
+    }
+    started_ = true;
+    next_seq_ = static_cast<uint16_t>(seq + 1);
+    last_timestamp_ = timestamp;
+
+    int64_t extended = timestamp_base_ + timestamp;
+    if (!current_.empty() && extended != current_timestamp_) {
+        finishAccessUnit();  // Previous AU ended without a marker
+    }
+    current_timestamp_ = extended;
+
+    if (codec_id_ == AV_CODEC_ID_HEVC) {
+        appendH265(data + offset, size - offset);
+    } else {
+        appendH264(data + offset, size - offset);
+    }
+
+    if (marker) {
+        finishAccessUnit();
+    }
+}
+
+bool RtpDepacketizer::pop(AVPacket* packet) {
+    if (ready_.empty()) {
+        return false;
+    }
+
+    AccessUnit& au = ready_.front();
+    if (av_new_packet(packet, static_cast<int>(au.data.size())) < 0) {
+        ready_.pop_front();
+        return false;
+    }
+    std::memcpy(packet->data, au.data.data(), au.data.size());
+    packet->pts = au.timestamp;
+    packet->dts = au.timestamp;
+    packet->flags = au.key ? AV_PKT_FLAG_KEY : 0;
+    ready_.pop_front();
+    return true;
+}
+
+void RtpDepacketizer::noteNalHeader(uint8_t header) {
+    if (codec_id_ == AV_CODEC_ID_HEVC) {
+        int type = (header >> 1) & 0x3f;
+        current_key_ |= type >= kH265IrapFirst && type <= kH265IrapLast;
+    } else {
+        current_key_ |= (header & 0x1f) == kH264Idr;
+    }
+}
+
+void RtpDepacketizer::appendNal(const uint8_t* nal, size_t size) {
+    if (size > 0) {
+        noteNalHeader(nal[0]);
+    }
+    current_.insert(current_.end(), std::begin(kStartCode), std::end(kStartCode));
+    current_.insert(current_.end(), nal, nal + size);
+}
+
+void RtpDepacketizer::appendH264(const uint8_t* payload, size_t size) {
+    int type = payload[0] & 0x1f;
+
+    if (type == kH264StapA) {
+        size_t pos = 1;
+        while (pos + 2 <= size) {
+            size_t nal_size = (payload[pos] << 8) | payload[pos + 1];
+            pos += 2;
+            if (pos + nal_size > size) break;
+            appendNal(payload + pos, nal_size);
+            pos += nal_size;
+        }
+    } else if (type == kH264FuA) {
+        if (size < 2) return;
+        bool start = (payload[1] & 0x80) != 0;
+        if (start) {
+            uint8_t header = static_cast<uint8_t>((payload[0] & 0xe0) | (payload[1] & 0x1f));
+            noteNalHeader(header);
+            current_.insert(current_.end(), std::begin(kStartCode), std::end(kStartCode));
+            current_.push_back(header);
+        }
+        current_.insert(current_.end(), payload + 2, payload + size);
+    } else if (type >= 1 && type <= 23) {
+        appendNal(payload, size);
+    }
+}
+
+void RtpDepacketizer::appendH265(const uint8_t* payload, size_t size) {
+    if (size < 2) return;
+    int type = (payload[0] >> 1) & 0x3f;
+
+    if (type == kH265Ap) {
+        size_t pos = 2;
+        while (pos + 2 <= size) {
+            size_t nal_size = (payload[pos] << 8) | payload[pos + 1];
+            pos += 2;
+            if (pos + nal_size > size) break;
+            appendNal(payload + pos, nal_size);
+            pos += nal_size;
+        }
+    } else if (type == kH265Fu) {
+        if (size < 3) return;
+        bool start = (payload[2] & 0x80) != 0;
+        if (start) {
+            int nal_type = payload[2] & 0x3f;
+            current_.insert(current_.end(), std::begin(kStartCode), std::end(kStartCode));
+            current_.push_back(static_cast<uint8_t>((payload[0] & 0x81) | (nal_type << 1)));
+            noteNalHeader(current_.back());
+            current_.push_back(payload[1]);
+        }
+        current_.insert(current_.end(), payload + 3, payload + size);
+    } else if (type < kH265Ap) {
+        appendNal(payload, size);
+    }
+}
+
+void RtpDepacketizer::finishAccessUnit() {
+    if (!current_.empty() && !current_corrupt_) {
+        ready_.push_back(AccessUnit{std::move(current_), current_timestamp_, current_key_});
+    }
+    current_.clear();
+    current_corrupt_ = false;
+    current_key_ = false;
+}
+
+} // namespace video_bench
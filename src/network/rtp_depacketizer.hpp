@@ -0,0 +1,61 @@
+#ifndef RTP_DEPACKETIZER_HPP
+#define RTP_DEPACKETIZER_HPP
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace video_bench {
+
+// Reassembles H.264 (RFC 6184) or H.265 (RFC 7798) RTP payloads into
+// Annex B access units. One instance per stream; not thread-safe.
+class RtpDepacketizer {
+public:
+    explicit RtpDepacketizer(AVCodecID codec_id);
+
+    // Feed one RTP packet (header included)
+    void push(const uint8_t* data, size_t size);
+
+    // Take the next complete access unit; false if none is ready
+    // The packet gets the AU data and the extended RTP timestamp as pts/dts,
+    // and AV_PKT_FLAG_KEY if it holds an IDR (H.264) or IRAP (H.265) picture
+    bool pop(AVPacket* packet);
+
+    // Packets missing from the sequence (access units spanning a gap are dropped)
+    int64_t getLostPackets() const { return lost_packets_; }
+
+private:
+    struct AccessUnit {
+        std::vector<uint8_t> data;
+        int64_t timestamp;
+        bool key;
+    };
+
+    void appendNal(const uint8_t* nal, size_t size);
+    void noteNalHeader(uint8_t header);
+    void appendH264(const uint8_t* payload, size_t size);
+    void appendH265(const uint8_t* payload, size_t size);
+    void finishAccessUnit();
+
+    AVCodecID codec_id_;
+    bool started_ = false;
+    uint16_t next_seq_ = 0;
+    uint32_t last_timestamp_ = 0;
+    int64_t timestamp_base_ = 0;  // Extends 32-bit RTP timestamps across wraps
+
+    std::vector<uint8_t> current_;
+    int64_t current_timestamp_ = 0;
+    bool current_corrupt_ = false;
+    bool current_key_ = false;
+    std::deque<AccessUnit> ready_;
+    int64_t lost_packets_ = 0;
+};
+
+} // namespace video_bench
+
+#endif // RTP_DEPACKETIZER_HPP
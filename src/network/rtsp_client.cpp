@@ -0,0 +1,313 @@
+#include "network/rtsp_client.hpp"
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+
+extern "C" {
+#include <libavutil/base64.h>
+}
+
+namespace video_bench {
+
+namespace {
+constexpr uint8_t kStartCode[] = {0, 0, 0, 1};
+constexpr int kControlTimeoutSec = 5;
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Header value from a response, empty if missing
+std::string headerValue(const std::string& response, const std::string& name) {
+    std::string lower = toLower(response);
+    size_t pos = lower.find("\n" + toLower(name) + ":");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += name.size() + 2;
+    size_t end = response.find("\r\n", pos);
+    std::string value = response.substr(pos, end - pos);
+    value.erase(0, value.find_first_not_of(' '));
+    return value;
+}
+
+// Value of "key=..." inside an fmtp or Transport parameter list
+std::string paramValue(const std::string& params, const std::string& key) {
+    size_t pos = params.find(key + "=");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += key.size() + 1;
+    size_t end = params.find(';', pos);
+    std::string value = params.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+    value.erase(value.find_last_not_of(" \r\n") + 1);
+    return value;
+}
+
+// Append comma-separated base64 parameter sets as Annex B NAL units
+void appendParameterSets(const std::string& sets, std::vector<uint8_t>& out) {
+    std::istringstream in(sets);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        std::vector<uint8_t> nal(item.size());
+        int size = av_base64_decode(nal.data(), item.c_str(), static_cast<int>(nal.size()));
+        if (size > 0) {
+            out.insert(out.end(), std::begin(kStartCode), std::end(kStartCode));
+            out.insert(out.end(), nal.begin(), nal.begin() + size);
+        }
+    }
+}
+
+} // namespace
+
+bool parseSdpVideoTrack(const std::string& sdp, SdpVideoTrack& track,
+                        std::string& error_message) {
+    std::istringstream in(sdp);
+    std::string line;
+    bool in_video = false;
+    std::string fmtp;
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.rfind("m=", 0) == 0) {
+            if (in_video) break;  // First video track only
+            in_video = line.rfind("m=video", 0) == 0;
+            if (in_video) {
+                // m=video <port> RTP/AVP <pt>
+                std::istringstream media(line);
+                std::string skip;
+                media >> skip >> skip >> skip >> track.payload_type;
+            }
+            continue;
+        }
+        if (!in_video) {
+            continue;
+        }
+        if (line.rfind("a=rtpmap:", 0) == 0) {
+            std::string upper = line;
+            std::transform(upper.begin(), upper.end(), upper.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+            if (upper.find(" H264/") != std::string::npos) {
+                track.codec_id = AV_CODEC_ID_H264;
+            } else if (upper.find(" H265/") != std::string::npos ||
+                       upper.find(" HEVC/") != std::string::npos) {
+                track.codec_id = AV_CODEC_ID_HEVC;
+            }
+        } else if (line.rfind("a=fmtp:", 0) == 0) {
+            fmtp = line + ";";
+        } else if (line.rfind("a=control:", 0) == 0) {
+            track.control = line.substr(10);
+        }
+    }
+
+    if (track.codec_id == AV_CODEC_ID_NONE) {
+        error_message = "SDP: no H.264/H.265 video track";
+        return false;
+    }
+
+    track.extradata.clear();
+    if (track.codec_id == AV_CODEC_ID_H264) {
+        appendParameterSets(paramValue(fmtp, "sprop-parameter-sets"), track.extradata);
+    } else {
+        appendParameterSets(paramValue(fmtp, "sprop-vps"), track.extradata);
+        appendParameterSets(paramValue(fmtp, "sprop-sps"), track.extradata);
+        appendParameterSets(paramValue(fmtp, "sprop-pps"), track.extradata);
+    }
+    return true;
+}
+
+RtspClient::~RtspClient() {
+    teardown();
+}
+
+RtspClient::RtspClient(RtspClient&& other) noexcept {
+    *this = std::move(other);
+}
+
+RtspClient& RtspClient::operator=(RtspClient&& other) noexcept {
+    if (this != &other) {
+        teardown();
+        fd_ = other.fd_;
+        url_ = std::move(other.url_);
+        content_base_ = std::move(other.content_base_);
+        session_ = std::move(other.session_);
+        cseq_ = other.cseq_;
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+bool RtspClient::connect(const std::string& url, std::string& error_message) {
+    const std::string scheme = "rtsp://";
+    if (url.rfind(scheme, 0) != 0) {
+        error_message = "RTSP client: only rtsp:// URLs are supported";
+        return false;
+    }
+
+    // rtsp://[user:pass@]host[:port]/path
+    std::string rest = url.substr(scheme.size());
+    std::string authority = rest.substr(0, rest.find('/'));
+    authority = authority.substr(authority.find('@') + 1);
+    std::string host = authority;
+    std::string port = "554";
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        host = authority.substr(0, colon);
+        port = authority.substr(colon + 1);
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        error_message = "RTSP client: cannot resolve " + host;
+        return false;
+    }
+
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd_ = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd_ < 0) continue;
+        if (::connect(fd_, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(fd_);
+        fd_ = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd_ < 0) {
+        error_message = "RTSP client: cannot connect to " + authority;
+        return false;
+    }
+
+    timeval timeout{kControlTimeoutSec, 0};
+    setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    url_ = url;
+    content_base_ = url;
+    return true;
+}
+
+bool RtspClient::describe(std::string& sdp, std::string& error_message) {
+    std::string response;
+    if (!request("DESCRIBE", url_, "Accept: application/sdp\r\n", response, error_message)) {
+        return false;
+    }
+
+    std::string base = headerValue(response, "Content-Base");
+    if (!base.empty()) {
+        content_base_ = base;
+    }
+    size_t body = response.find("\r\n\r\n");
+    sdp = response.substr(body + 4);
+    return true;
+}
+
+bool RtspClient::setupUdp(const std::string& control, int client_port,
+                          uint32_t& ssrc, std::string& error_message) {
+    std::string track_url = control;
+    if (control.empty() || control == "*") {
+        track_url = content_base_;
+    } else if (control.find("://") == std::string::npos) {
+        track_url = content_base_;
+        if (track_url.empty() || track_url.back() != '/') track_url += "/";
+        track_url += control;
+    }
+
+    std::ostringstream headers;
+    headers << "Transport: RTP/AVP/UDP;unicast;client_port="
+            << client_port << "-" << client_port + 1 << "\r\n";
+
+    std::string response;
+    if (!request("SETUP", track_url, headers.str(), response, error_message)) {
+        return false;
+    }
+
+    session_ = headerValue(response, "Session");
+    session_ = session_.substr(0, session_.find(';'));
+
+    // The batched receiver demultiplexes sessions sharing a port by SSRC
+    std::string ssrc_hex = paramValue(headerValue(response, "Transport") + ";", "ssrc");
+    if (ssrc_hex.empty()) {
+        error_message = "RTSP client: server did not announce an SSRC";
+        return false;
+    }
+    ssrc = static_cast<uint32_t>(std::stoul(ssrc_hex, nullptr, 16));
+    return true;
+}
+
+bool RtspClient::play(std::string& error_message) {
+    std::string response;
+    return request("PLAY", content_base_, "Session: " + session_ + "\r\nRange: npt=0.000-\r\n",
+                   response, error_message);
+}
+
+void RtspClient::teardown() {
+    if (fd_ < 0) {
+        return;
+    }
+    if (!session_.empty()) {
+        std::string response;
+        std::string error;
+        request("TEARDOWN", content_base_, "Session: " + session_ + "\r\n", response, error);
+        session_.clear();
+    }
+    close(fd_);
+    fd_ = -1;
+}
+
+bool RtspClient::request(const std::string& method, const std::string& url,
+                         const std::string& headers, std::string& response,
+                         std::string& error_message) {
+    std::ostringstream out;
+    out << method << " " << url << " RTSP/1.0\r\n"
+        << "CSeq: " << ++cseq_ << "\r\n"
+        << "User-Agent: video-benchmark\r\n"
+        << headers << "\r\n";
+    const std::string text = out.str();
+
+    if (send(fd_, text.data(), text.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(text.size())) {
+        error_message = "RTSP client: " + method + " send failed";
+        return false;
+    }
+
+    // Read headers, then Content-Length bytes of body
+    response.clear();
+    size_t header_end = std::string::npos;
+    size_t content_length = 0;
+    char buf[4096];
+    while (header_end == std::string::npos ||
+           response.size() < header_end + 4 + content_length) {
+        ssize_t n = recv(fd_, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            error_message = "RTSP client: " + method + " got no response";
+            return false;
+        }
+        response.append(buf, static_cast<size_t>(n));
+        if (header_end == std::string::npos) {
+            header_end = response.find("\r\n\r\n");
+            if (header_end != std::string::npos) {
+                std::string length = headerValue(response.substr(0, header_end + 2),
+                                                 "Content-Length");
+                content_length = length.empty() ? 0 : std::stoul(length);
+            }
+        }
+    }
+
+    if (response.rfind("RTSP/1.0 200", 0) != 0) {
+        error_message = "RTSP client: " + method + " failed: " +
+                        response.substr(0, response.find("\r\n"));
+        return false;
+    }
+    return true;
+}
+
+} // namespace video_bench
@@ -0,0 +1,69 @@
+#ifndef RTSP_CLIENT_HPP
+#define RTSP_CLIENT_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace video_bench {
+
+// Video track description parsed from an SDP
+struct SdpVideoTrack {
+    AVCodecID codec_id = AV_CODEC_ID_NONE;
+    int payload_type = -1;
+    std::string control;             // Track control URL (absolute or relative)
+    std::vector<uint8_t> extradata;  // Annex B parameter sets from sprop-*
+};
+
+// Parse the first H.264/H.265 video track of an SDP
+bool parseSdpVideoTrack(const std::string& sdp, SdpVideoTrack& track,
+                        std::string& error_message);
+
+// Minimal blocking RTSP client for one session with UDP transport
+// Used by the batched receiver, which owns the RTP sockets itself
+class RtspClient {
+public:
+    RtspClient() = default;
+    ~RtspClient();
+
+    // Non-copyable, movable
+    RtspClient(const RtspClient&) = delete;
+    RtspClient& operator=(const RtspClient&) = delete;
+    RtspClient(RtspClient&& other) noexcept;
+    RtspClient& operator=(RtspClient&& other) noexcept;
+
+    // Connect the control channel (rtsp://host[:port]/path)
+    bool connect(const std::string& url, std::string& error_message);
+
+    // DESCRIBE: fetch the SDP
+    bool describe(std::string& sdp, std::string& error_message);
+
+    // SETUP the track for UDP delivery to client_port; returns the server SSRC
+    bool setupUdp(const std::string& control, int client_port,
+                  uint32_t& ssrc, std::string& error_message);
+
+    bool play(std::string& error_message);
+
+    // Best-effort TEARDOWN and close
+    void teardown();
+
+private:
+    // Send a request and read the response; false on I/O error or non-200
+    bool request(const std::string& method, const std::string& url,
+                 const std::string& headers, std::string& response,
+                 std::string& error_message);
+
+    int fd_ = -1;
+    std::string url_;
+    std::string content_base_;
+    std::string session_;
+    int cseq_ = 0;
+};
+
+} // namespace video_bench
+
+#endif // RTSP_CLIENT_HPP
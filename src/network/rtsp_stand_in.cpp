@@ -0,0 +1,854 @@
+#include "network/rtsp_stand_in.hpp"
+#include "utils/thread_cpu_time.hpp"
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <openssl/evp.h>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+namespace video_bench {
+
+namespace {
+// RTP payload size limit (fits a 1500-byte MTU with IP/UDP headers)
+constexpr int kRtpPacketSize = 1400;
+constexpr size_t kRtpHeaderSize = 12;
+// Per-session send buffer so frame bursts of high-bitrate streams fit
+constexpr int kSendBufferBytes = 4 * 1024 * 1024;
+// A TCP session that cannot take data for this long is dropped
+constexpr int kSendTimeoutMs = 2000;
+constexpr int kPollTimeoutMs = 100;
+// Packets per sendmmsg/sendmsg batch
+constexpr size_t kSendBatch = 256;
+// Self-signed certificate lifetime
+constexpr long kCertValiditySeconds = 7 * 24 * 3600;
+
+bool isRtcp(const uint8_t* data, size_t size) {
+    return size >= 2 && data[1] >= 200 && data[1] <= 204;
+}
+
+// sendmsg() the whole iovec list, resuming after partial writes
+bool writeAll(int fd, iovec* iov, size_t iovcnt) {
+    while (iovcnt > 0) {
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovcnt;
+        ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        auto remaining = static_cast<size_t>(sent);
+        while (iovcnt > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Value of "key=..." inside a Transport header, up to ';'
+std::string transportParam(const std::string& transport, const std::string& key) {
+    size_t pos = transport.find(key + "=");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += key.size() + 1;
+    size_t end = transport.find(';', pos);
+    return transport.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+}
+
+} // namespace
+
+struct RtspStandIn::Connection {
+    int fd = -1;
+    SSL* ssl = nullptr;  // RTSPS session, nullptr for plain RTSP
+    std::string input;
+
+    // Serializes control responses and interleaved RTP on the same socket
+    // (and all TLS reads and writes: an SSL object is not thread-safe)
+    std::mutex write_mutex;
+    bool closed = false;  // Guarded by write_mutex
+
+    std::string session_id;
+    uint32_t ssrc = 0;
+    bool interleaved = false;
+    uint8_t rtp_channel = 0;
+    int udp_fd = -1;
+    sockaddr_in udp_dest{};
+    std::atomic<bool> playing{false};
+    bool waiting_keyframe = true;  // Sender thread only
+};
+
+RtspStandIn::RtspStandIn(const std::string& file_path)
+    : file_path_(file_path) {
+}
+
+RtspStandIn::~RtspStandIn() {
+    stop();
+}
+
+void RtspStandIn::enableTls(const std::string& cipher_list) {
+    tls_enabled_ = true;
+    tls_cipher_list_ = cipher_list;
+}
+
+bool RtspStandIn::start(std::string& error_message) {
+    if (!openSource(error_message)) {
+        return false;
+    }
+
+    int port = 0;
+    listen_fd_ = openListener(port, error_message);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    url_ = "rtsp://127.0.0.1:" + std::to_string(port) + "/stream";
+
+    if (tls_enabled_ && !openTls(error_message)) {
+        return false;
+    }
+
+    std::random_device rd;
+    ssrc_base_ = rd();
+
+    control_thread_ = std::thread([this] { controlLoop(); });
+    sender_thread_ = std::thread([this] { senderLoop(); });
+    return true;
+}
+
+void RtspStandIn::stop() {
+    stopping_.store(true, std::memory_order_release);
+    if (sender_thread_.joinable()) {
+        sender_thread_.join();
+    }
+    if (control_thread_.joinable()) {
+        control_thread_.join();
+    }
+
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    if (tls_listen_fd_ >= 0) {
+        close(tls_listen_fd_);
+        tls_listen_fd_ = -1;
+    }
+    if (tls_ctx_) {
+        SSL_CTX_free(tls_ctx_);
+        tls_ctx_ = nullptr;
+    }
+    if (rtp_ctx_) {
+        if (rtp_ctx_->pb) {
+            av_freep(&rtp_ctx_->pb->buffer);
+            avio_context_free(&rtp_ctx_->pb);
+        }
+        avformat_free_context(rtp_ctx_);
+        rtp_ctx_ = nullptr;
+    }
+}
+
+std::string RtspStandIn::getUrl() const {
+    return url_;
+}
+
+std::string RtspStandIn::getTlsUrl() const {
+    return tls_url_;
+}
+
+std::string RtspStandIn::getTlsCipher() const {
+    std::lock_guard lock(error_mutex_);
+    return tls_cipher_;
+}
+
+double RtspStandIn::getCpuMs() const {
+    return control_cpu_ms_.load(std::memory_order_relaxed) +
+           sender_cpu_ms_.load(std::memory_order_relaxed);
+}
+
+int64_t RtspStandIn::getPacketsSent() const {
+    return packets_sent_.load(std::memory_order_relaxed);
+}
+
+std::string RtspStandIn::getError() const {
+    std::lock_guard lock(error_mutex_);
+    return error_message_;
+}
+
+void RtspStandIn::setError(const std::string& message) {
+    std::lock_guard lock(error_mutex_);
+    if (error_message_.empty()) {
+        error_message_ = message;
+    }
+}
+
+bool RtspStandIn::openSource(std::string& error_message) {
+    AVFormatContext* input_raw = nullptr;
+    int ret = avformat_open_input(&input_raw, file_path_.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Stand-in: failed to open source: " + ffmpegErrorString(ret);
+        return false;
+    }
+    input_ctx_.reset(input_raw);
+
+    ret = avformat_find_stream_info(input_ctx_.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Stand-in: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    video_stream_index_ = av_find_best_stream(input_ctx_.get(), AVMEDIA_TYPE_VIDEO,
+                                              -1, -1, nullptr, 0);
+    if (video_stream_index_ < 0) {
+        error_message = "Stand-in: no video stream found";
+        return false;
+    }
+
+    ret = avformat_alloc_output_context2(&rtp_ctx_, nullptr, "rtp", nullptr);
+    if (ret < 0 || !rtp_ctx_) {
+        error_message = "Stand-in: RTP muxer not available";
+        return false;
+    }
+
+    AVStream* out_stream = avformat_new_stream(rtp_ctx_, nullptr);
+    if (!out_stream) {
+        error_message = "Stand-in: failed to create RTP stream";
+        return false;
+    }
+    const AVStream* in_stream = input_ctx_->streams[video_stream_index_];
+    avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar);
+    out_stream->codecpar->codec_tag = 0;
+    out_stream->time_base = in_stream->time_base;
+
+    // Custom I/O: the muxer flushes once per RTP packet into rtp_packets_
+    auto* buffer = static_cast<unsigned char*>(av_malloc(kRtpPacketSize));
+    rtp_ctx_->pb = avio_alloc_context(buffer, kRtpPacketSize, 1, this,
+                                      nullptr, &RtspStandIn::writeRtpPacket, nullptr);
+    if (!buffer || !rtp_ctx_->pb) {
+        av_free(buffer);
+        error_message = "Stand-in: failed to allocate RTP I/O";
+        return false;
+    }
+    rtp_ctx_->pb->max_packet_size = kRtpPacketSize;
+
+    ret = avformat_write_header(rtp_ctx_, nullptr);
+    if (ret < 0) {
+        error_message = "Stand-in: RTP packetizer rejected the stream: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    // No destination URL: SDP gets port 0 and a=control:streamid=0
+    char sdp[16384];
+    ret = av_sdp_create(&rtp_ctx_, 1, sdp, sizeof(sdp));
+    if (ret < 0) {
+        error_message = "Stand-in: failed to create SDP: " + ffmpegErrorString(ret);
+        return false;
+    }
+    sdp_ = sdp;
+    return true;
+}
+
+int RtspStandIn::openListener(int& port, std::string& error_message) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error_message = "Stand-in: socket() failed: " + std::string(std::strerror(errno));
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(fd, SOMAXCONN) < 0) {
+        error_message = "Stand-in: failed to listen: " + std::string(std::strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+bool RtspStandIn::openTls(std::string& error_message) {
+    tls_ctx_ = SSL_CTX_new(TLS_server_method());
+    if (!tls_ctx_) {
+        error_message = "Stand-in: failed to create TLS context";
+        return false;
+    }
+    SSL_CTX_set_min_proto_version(tls_ctx_, TLS1_2_VERSION);
+
+    // "TLS_..." names are TLS 1.3 suites; anything else is a TLS 1.2 cipher
+    // list, which only takes effect if 1.3 is not negotiated
+    if (!tls_cipher_list_.empty()) {
+        bool ok;
+        if (tls_cipher_list_.rfind("TLS_", 0) == 0) {
+            ok = SSL_CTX_set_ciphersuites(tls_ctx_, tls_cipher_list_.c_str()) == 1;
+        } else {
+            ok = SSL_CTX_set_cipher_list(tls_ctx_, tls_cipher_list_.c_str()) == 1;
+            SSL_CTX_set_max_proto_version(tls_ctx_, TLS1_2_VERSION);
+        }
+        if (!ok) {
+            error_message = "Stand-in: no usable cipher in '" + tls_cipher_list_ + "'";
+            return false;
+        }
+    }
+
+    // Self-signed P-256 certificate for 127.0.0.1 (clients do not verify)
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    bool ok = key && cert;
+    if (ok) {
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert), kCertValiditySeconds);
+        X509_set_pubkey(cert, key);
+        X509_NAME* name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("127.0.0.1"), -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+        ok = X509_sign(cert, key, EVP_sha256()) > 0 &&
+             SSL_CTX_use_certificate(tls_ctx_, cert) == 1 &&
+             SSL_CTX_use_PrivateKey(tls_ctx_, key) == 1;
+    }
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    if (!ok) {
+        error_message = "Stand-in: failed to create self-signed certificate";
+        return false;
+    }
+
+    int port = 0;
+    tls_listen_fd_ = openListener(port, error_message);
+    if (tls_listen_fd_ < 0) {
+        return false;
+    }
+    tls_url_ = "rtsps://127.0.0.1:" + std::to_string(port) + "/stream";
+    return true;
+}
+
+#if LIBAVFORMAT_VERSION_MAJOR >= 62
+int RtspStandIn::writeRtpPacket(void* opaque, const uint8_t* data, int size) {
+#else
+int RtspStandIn::writeRtpPacket(void* opaque, uint8_t* data, int size) {
+#endif
+    auto* self = static_cast<RtspStandIn*>(opaque);
+    auto len = static_cast<size_t>(size);
+
+    // Sender reports are not forwarded; clients sync from RTP timestamps
+    if (len < kRtpHeaderSize || isRtcp(data, len)) {
+        return size;
+    }
+
+    if (self->rtp_packet_count_ == self->rtp_packets_.size()) {
+        self->rtp_packets_.emplace_back();
+    }
+    self->rtp_packets_[self->rtp_packet_count_++].assign(data, data + len);
+    return size;
+}
+
+void RtspStandIn::controlLoop() {
+    const double cpu_start = threadCpuTimeMs();
+    std::vector<pollfd> fds;
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // poll() ignores the negative TLS listener fd when TLS is off
+        fds.clear();
+        fds.push_back({listen_fd_, POLLIN, 0});
+        fds.push_back({tls_listen_fd_, POLLIN, 0});
+        for (const auto& conn : connections_) {
+            fds.push_back({conn->fd, POLLIN, 0});
+        }
+
+        int ready = poll(fds.data(), fds.size(), kPollTimeoutMs);
+        if (ready > 0) {
+            // Existing connections first; indices shift once we accept
+            std::vector<std::shared_ptr<Connection>> to_close;
+            for (size_t i = 2; i < fds.size(); i++) {
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    continue;
+                }
+                const auto& conn = connections_[i - 2];
+                if (!readInput(*conn) || !processInput(*conn)) {
+                    to_close.push_back(conn);
+                }
+            }
+            for (const auto& conn : to_close) {
+                closeConnection(conn);
+            }
+
+            if (fds[0].revents & POLLIN) {
+                acceptConnection(listen_fd_, false);
+            }
+            if (fds[1].revents & POLLIN) {
+                acceptConnection(tls_listen_fd_, true);
+            }
+        }
+
+        control_cpu_ms_.store(threadCpuTimeMs() - cpu_start, std::memory_order_relaxed);
+    }
+
+    while (!connections_.empty()) {
+        closeConnection(connections_.back());
+    }
+}
+
+void RtspStandIn::acceptConnection(int listen_fd, bool tls) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+        return;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &kSendBufferBytes, sizeof(kSendBufferBytes));
+    timeval timeout{kSendTimeoutMs / 1000, (kSendTimeoutMs % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    auto conn = std::make_shared<Connection>();
+    conn->fd = fd;
+
+    if (tls) {
+        // Blocking handshake; the receive timeout bounds a silent client
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        conn->ssl = SSL_new(tls_ctx_);
+        if (!conn->ssl || SSL_set_fd(conn->ssl, fd) != 1 || SSL_accept(conn->ssl) != 1) {
+            SSL_free(conn->ssl);
+            close(fd);
+            return;
+        }
+        std::lock_guard lock(error_mutex_);
+        if (tls_cipher_.empty()) {
+            tls_cipher_ = SSL_get_cipher_name(conn->ssl);
+        }
+    }
+
+    connections_.push_back(std::move(conn));
+}
+
+bool RtspStandIn::readInput(Connection& conn) {
+    char buf[4096];
+    if (!conn.ssl) {
+        ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return false;
+        }
+        conn.input.append(buf, static_cast<size_t>(n));
+        return true;
+    }
+
+    // Drain every decrypted byte: poll() cannot see data buffered in the SSL object
+    std::lock_guard lock(conn.write_mutex);
+    do {
+        int n = SSL_read(conn.ssl, buf, sizeof(buf));
+        if (n <= 0) {
+            int err = SSL_get_error(conn.ssl, n);
+            return err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+        }
+        conn.input.append(buf, static_cast<size_t>(n));
+    } while (SSL_pending(conn.ssl) > 0);
+    return true;
+}
+
+bool RtspStandIn::writeConnection(Connection& conn, iovec* iov, size_t iovcnt) {
+    if (!conn.ssl) {
+        return writeAll(conn.fd, iov, iovcnt);
+    }
+
+    // One SSL_write per batch so records are filled instead of one per iovec
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    for (size_t i = 0; i < iovcnt; i++) {
+        const auto* data = static_cast<const uint8_t*>(iov[i].iov_base);
+        buffer.insert(buffer.end(), data, data + iov[i].iov_len);
+    }
+    return SSL_write(conn.ssl, buffer.data(), static_cast<int>(buffer.size())) > 0;
+}
+
+bool RtspStandIn::processInput(Connection& conn) {
+    while (!conn.input.empty()) {
+        // Interleaved data from the client (RTCP receiver reports): skip
+        if (conn.input[0] == '$') {
+            if (conn.input.size() < 4) {
+                return true;
+            }
+            size_t len = (static_cast<uint8_t>(conn.input[2]) << 8) |
+                         static_cast<uint8_t>(conn.input[3]);
+            if (conn.input.size() < 4 + len) {
+                return true;
+            }
+            conn.input.erase(0, 4 + len);
+            continue;
+        }
+
+        size_t end = conn.input.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            return conn.input.size() < 16384;  // Refuse unbounded headers
+        }
+
+        std::string request = conn.input.substr(0, end + 4);
+        size_t body_length = 0;
+        size_t cl = toLower(request).find("\ncontent-length:");
+        if (cl != std::string::npos) {
+            body_length = std::strtoul(request.c_str() + cl + 16, nullptr, 10);
+        }
+        if (conn.input.size() < end + 4 + body_length) {
+            return true;
+        }
+        conn.input.erase(0, end + 4 + body_length);
+
+        std::string response = handleRequest(conn, request);
+
+        std::lock_guard lock(conn.write_mutex);
+        iovec iov{response.data(), response.size()};
+        if (conn.closed || !writeConnection(conn, &iov, 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string RtspStandIn::handleRequest(Connection& conn, const std::string& request) {
+    std::istringstream in(request);
+    std::string method;
+    std::string request_url;
+    in >> method >> request_url;
+
+    std::string cseq;
+    std::string transport;
+    std::string line;
+    std::getline(in, line);  // Rest of request line
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = toLower(line.substr(0, colon));
+        std::string value = line.substr(colon + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        if (name == "cseq") cseq = value;
+        if (name == "transport") transport = value;
+    }
+
+    std::ostringstream out;
+    out << "RTSP/1.0 200 OK\r\nCSeq: " << cseq << "\r\n";
+
+    if (method == "OPTIONS") {
+        out << "Public: OPTIONS, DESCRIBE, SETUP, PLAY, TEARDOWN, GET_PARAMETER\r\n\r\n";
+    } else if (method == "DESCRIBE") {
+        out << "Content-Base: " << (conn.ssl ? tls_url_ : url_) << "/\r\n"
+            << "Content-Type: application/sdp\r\n"
+            << "Content-Length: " << sdp_.size() << "\r\n\r\n" << sdp_;
+    } else if (method == "SETUP") {
+        if (conn.session_id.empty()) {
+            conn.session_id = std::to_string(next_session_);
+            conn.ssrc = ssrc_base_ + next_session_ * 0x9E3779B9u;
+            next_session_++;
+        }
+
+        std::ostringstream reply_transport;
+        if (transport.find("interleaved=") != std::string::npos ||
+            transport.find("/TCP") != std::string::npos) {
+            conn.interleaved = true;
+            std::string channels = transportParam(transport, "interleaved");
+            conn.rtp_channel = static_cast<uint8_t>(channels.empty() ? 0 : std::stoi(channels));
+            reply_transport << "RTP/AVP/TCP;unicast;interleaved="
+                            << static_cast<int>(conn.rtp_channel) << "-"
+                            << static_cast<int>(conn.rtp_channel) + 1;
+        } else {
+            std::string ports = transportParam(transport, "client_port");
+            if (ports.empty()) {
+                return "RTSP/1.0 461 Unsupported Transport\r\nCSeq: " + cseq + "\r\n\r\n";
+            }
+
+            // Each session sends from its own socket, like separate cameras
+            if (conn.udp_fd < 0) {
+                conn.udp_fd = socket(AF_INET, SOCK_DGRAM, 0);
+                sockaddr_in local{};
+                local.sin_family = AF_INET;
+                local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                if (conn.udp_fd < 0 ||
+                    bind(conn.udp_fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+                    return "RTSP/1.0 500 Internal Server Error\r\nCSeq: " + cseq + "\r\n\r\n";
+                }
+                setsockopt(conn.udp_fd, SOL_SOCKET, SO_SNDBUF, &kSendBufferBytes,
+                           sizeof(kSendBufferBytes));
+            }
+            sockaddr_in local{};
+            socklen_t local_len = sizeof(local);
+            getsockname(conn.udp_fd, reinterpret_cast<sockaddr*>(&local), &local_len);
+
+            socklen_t peer_len = sizeof(conn.udp_dest);
+            getpeername(conn.fd, reinterpret_cast<sockaddr*>(&conn.udp_dest), &peer_len);
+            conn.udp_dest.sin_port = htons(static_cast<uint16_t>(std::stoi(ports)));
+
+            reply_transport << "RTP/AVP/UDP;unicast;client_port=" << ports
+                            << ";server_port=" << ntohs(local.sin_port)
+                            << "-" << ntohs(local.sin_port) + 1;
+        }
+
+        char ssrc_hex[9];
+        std::snprintf(ssrc_hex, sizeof(ssrc_hex), "%08X", conn.ssrc);
+        out << "Transport: " << reply_transport.str() << ";ssrc=" << ssrc_hex << "\r\n"
+            << "Session: " << conn.session_id << ";timeout=60\r\n\r\n";
+    } else if (method == "PLAY") {
+        if (conn.session_id.empty()) {
+            return "RTSP/1.0 455 Method Not Valid in This State\r\nCSeq: " + cseq + "\r\n\r\n";
+        }
+        if (!conn.playing.exchange(true)) {
+            std::lock_guard lock(sessions_mutex_);
+            for (const auto& candidate : connections_) {
+                if (candidate.get() == &conn) {
+                    sessions_.push_back(candidate);
+                }
+            }
+        }
+        out << "Session: " << conn.session_id << "\r\nRange: npt=0.000-\r\n\r\n";
+    } else if (method == "TEARDOWN") {
+        conn.playing.store(false);
+        out << "Session: " << conn.session_id << "\r\n\r\n";
+    } else if (method == "GET_PARAMETER" || method == "SET_PARAMETER") {
+        out << "\r\n";
+    } else {
+        return "RTSP/1.0 501 Not Implemented\r\nCSeq: " + cseq + "\r\n\r\n";
+    }
+    return out.str();
+}
+
+void RtspStandIn::closeConnection(std::shared_ptr<Connection> conn) {
+    {
+        std::lock_guard lock(sessions_mutex_);
+        sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), conn), sessions_.end());
+    }
+    connections_.erase(std::remove(connections_.begin(), connections_.end(), conn),
+                       connections_.end());
+
+    std::lock_guard lock(conn->write_mutex);
+    conn->closed = true;
+    conn->playing.store(false);
+    SSL_free(conn->ssl);
+    conn->ssl = nullptr;
+    close(conn->fd);
+    if (conn->udp_fd >= 0) {
+        close(conn->udp_fd);
+    }
+}
+
+void RtspStandIn::senderLoop() {
+    using Clock = std::chrono::steady_clock;
+
+    const double cpu_start = threadCpuTimeMs();
+    const AVRational in_time_base = input_ctx_->streams[video_stream_index_]->time_base;
+    const AVRational out_time_base = rtp_ctx_->streams[0]->time_base;
+    const AVRational microseconds{1, 1000000};
+
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        setError("Stand-in: failed to allocate packet");
+        return;
+    }
+
+    // Timestamps keep increasing across file loops
+    int64_t first_ts = AV_NOPTS_VALUE;
+    int64_t loop_offset = 0;
+    int64_t loop_end = 0;
+    const auto start_time = Clock::now();
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        int ret = av_read_frame(input_ctx_.get(), packet.get());
+        if (ret == AVERROR_EOF) {
+            avformat_seek_file(input_ctx_.get(), -1, INT64_MIN, 0, INT64_MAX, 0);
+            loop_offset += loop_end - (first_ts == AV_NOPTS_VALUE ? 0 : first_ts);
+            loop_end = 0;
+            continue;
+        }
+        if (ret < 0) {
+            setError("Stand-in: read error: " + ffmpegErrorString(ret));
+            break;
+        }
+        if (packet->stream_index != video_stream_index_) {
+            av_packet_unref(packet.get());
+            continue;
+        }
+
+        int64_t ts = packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts;
+        if (ts == AV_NOPTS_VALUE) {
+            av_packet_unref(packet.get());
+            continue;
+        }
+        if (first_ts == AV_NOPTS_VALUE) {
+            first_ts = ts;
+        }
+        int64_t end = std::max(ts, packet->pts) + std::max<int64_t>(packet->duration, 1);
+        loop_end = std::max(loop_end, end);
+
+        // Pace by decode timestamp, waking regularly to notice stop()
+        auto due = start_time + std::chrono::microseconds(
+            av_rescale_q(ts + loop_offset - first_ts, in_time_base, microseconds));
+        while (Clock::now() < due && !stopping_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_until(std::min(due, Clock::now() + std::chrono::milliseconds(100)));
+        }
+
+        bool keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+        if (packet->pts != AV_NOPTS_VALUE) packet->pts += loop_offset;
+        if (packet->dts != AV_NOPTS_VALUE) packet->dts += loop_offset;
+        av_packet_rescale_ts(packet.get(), in_time_base, out_time_base);
+        packet->stream_index = 0;
+
+        rtp_packet_count_ = 0;
+        ret = av_write_frame(rtp_ctx_, packet.get());
+        av_packet_unref(packet.get());
+        if (ret < 0) {
+            setError("Stand-in: RTP packetizer error: " + ffmpegErrorString(ret));
+            break;
+        }
+
+        fanOut(keyframe);
+        sender_cpu_ms_.store(threadCpuTimeMs() - cpu_start, std::memory_order_relaxed);
+    }
+}
+
+void RtspStandIn::fanOut(bool keyframe) {
+    if (rtp_packet_count_ == 0) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Connection>> targets;
+    {
+        std::lock_guard lock(sessions_mutex_);
+        targets = sessions_;
+    }
+
+    for (const auto& conn : targets) {
+        if (!conn->playing.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        // New sessions start at an IDR, as a camera would after PLAY
+        if (conn->waiting_keyframe) {
+            if (!keyframe) {
+                continue;
+            }
+            conn->waiting_keyframe = false;
+        }
+
+        bool ok = conn->interleaved ? sendInterleaved(*conn) : sendUdp(*conn);
+        if (ok) {
+            packets_sent_.fetch_add(static_cast<int64_t>(rtp_packet_count_),
+                                    std::memory_order_relaxed);
+        }
+    }
+}
+
+bool RtspStandIn::sendUdp(Connection& conn) {
+    uint8_t headers[kSendBatch][kRtpHeaderSize];
+    iovec iovs[kSendBatch][2];
+    mmsghdr msgs[kSendBatch];
+
+    for (size_t first = 0; first < rtp_packet_count_; first += kSendBatch) {
+        size_t count = std::min(kSendBatch, rtp_packet_count_ - first);
+        for (size_t i = 0; i < count; i++) {
+            std::vector<uint8_t>& rtp = rtp_packets_[first + i];
+            std::memcpy(headers[i], rtp.data(), kRtpHeaderSize);
+            headers[i][8] = static_cast<uint8_t>(conn.ssrc >> 24);
+            headers[i][9] = static_cast<uint8_t>(conn.ssrc >> 16);
+            headers[i][10] = static_cast<uint8_t>(conn.ssrc >> 8);
+            headers[i][11] = static_cast<uint8_t>(conn.ssrc);
+            iovs[i][0] = {headers[i], kRtpHeaderSize};
+            iovs[i][1] = {rtp.data() + kRtpHeaderSize, rtp.size() - kRtpHeaderSize};
+
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_name = &conn.udp_dest;
+            msgs[i].msg_hdr.msg_namelen = sizeof(conn.udp_dest);
+            msgs[i].msg_hdr.msg_iov = iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 2;
+        }
+
+        // Datagrams the receiver has no room for are lost, like on a real network
+        size_t done = 0;
+        while (done < count) {
+            int sent = sendmmsg(conn.udp_fd, msgs + done, static_cast<unsigned int>(count - done), 0);
+            if (sent <= 0) {
+                if (sent < 0 && errno == EINTR) continue;
+                return false;
+            }
+            done += static_cast<size_t>(sent);
+        }
+    }
+    return true;
+}
+
+bool RtspStandIn::sendInterleaved(Connection& conn) {
+    uint8_t prefixes[kSendBatch][4];
+    uint8_t headers[kSendBatch][kRtpHeaderSize];
+    iovec iovs[kSendBatch * 3];
+
+    std::lock_guard lock(conn.write_mutex);
+    if (conn.closed) {
+        return false;
+    }
+
+    for (size_t first = 0; first < rtp_packet_count_; first += kSendBatch) {
+        size_t count = std::min(kSendBatch, rtp_packet_count_ - first);
+        for (size_t i = 0; i < count; i++) {
+            std::vector<uint8_t>& rtp = rtp_packets_[first + i];
+            prefixes[i][0] = '$';
+            prefixes[i][1] = conn.rtp_channel;
+            prefixes[i][2] = static_cast<uint8_t>(rtp.size() >> 8);
+            prefixes[i][3] = static_cast<uint8_t>(rtp.size());
+            std::memcpy(headers[i], rtp.data(), kRtpHeaderSize);
+            headers[i][8] = static_cast<uint8_t>(conn.ssrc >> 24);
+            headers[i][9] = static_cast<uint8_t>(conn.ssrc >> 16);
+            headers[i][10] = static_cast<uint8_t>(conn.ssrc >> 8);
+            headers[i][11] = static_cast<uint8_t>(conn.ssrc);
+            iovs[i * 3] = {prefixes[i], 4};
+            iovs[i * 3 + 1] = {headers[i], kRtpHeaderSize};
+            iovs[i * 3 + 2] = {rtp.data() + kRtpHeaderSize, rtp.size() - kRtpHeaderSize};
+        }
+
+        if (!writeConnection(conn, iovs, count * 3)) {
+            // Stalled or gone: let the control thread reap it
+            conn.playing.store(false);
+            shutdown(conn.fd, SHUT_RDWR);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace video_bench
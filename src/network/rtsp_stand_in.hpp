@@ -0,0 +1,149 @@
+#ifndef RTSP_STAND_IN_HPP
+#define RTSP_STAND_IN_HPP
+
+#include "utils/ffmpeg_utils.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+#include <sys/uio.h>
+
+struct ssl_ctx_st;
+
+namespace video_bench {
+
+// In-process RTSP server on loopback that serves a local file as a live
+// camera: the file is packetized once (FFmpeg RTP muxer) and paced in real
+// time, and every playing session gets the same RTP packets with its own SSRC.
+// Supports UDP and TCP-interleaved transport, and RTSPS (TLS, interleaved)
+// on a second port. Used to benchmark the ingest path without an external
+// server.
+class RtspStandIn {
+public:
+    explicit RtspStandIn(const std::string& file_path);
+    ~RtspStandIn();
+
+    // Non-copyable, non-movable (owns threads)
+    RtspStandIn(const RtspStandIn&) = delete;
+    RtspStandIn& operator=(const RtspStandIn&) = delete;
+    RtspStandIn(RtspStandIn&&) = delete;
+    RtspStandIn& operator=(RtspStandIn&&) = delete;
+
+    // Also serve rtsps:// with a self-signed certificate generated at start()
+    // cipher_list: OpenSSL cipher list or TLS 1.3 suites ("TLS_..."); empty = defaults
+    // Call before start()
+    void enableTls(const std::string& cipher_list);
+
+    // Open the file, listen on 127.0.0.1 and start serving
+    bool start(std::string& error_message);
+
+    // Stop serving and close all sessions
+    void stop();
+
+    // URL clients connect to (valid after start())
+    std::string getUrl() const;
+
+    // Local file being served
+    const std::string& getFilePath() const { return file_path_; }
+
+    // rtsps:// URL, empty unless TLS is enabled (valid after start())
+    std::string getTlsUrl() const;
+
+    // Cipher negotiated by the first TLS client, empty before one connects
+    std::string getTlsCipher() const;
+
+    // CPU time used by the stand-in threads so far, in ms
+    // Subtracted from the measured CPU so it is not billed to ingest/decode
+    double getCpuMs() const;
+
+    // RTP packets sent over all sessions
+    int64_t getPacketsSent() const;
+
+    // Get first error from the serving threads, empty if none
+    std::string getError() const;
+
+private:
+    struct Connection;
+
+    bool openSource(std::string& error_message);
+    // Listen on 127.0.0.1 at an ephemeral port; returns the fd or -1
+    int openListener(int& port, std::string& error_message);
+    bool openTls(std::string& error_message);
+
+    void controlLoop();
+    void senderLoop();
+
+    void acceptConnection(int listen_fd, bool tls);
+
+    // Read available request bytes; false if the connection must close
+    bool readInput(Connection& conn);
+
+    // Write to the connection, through TLS if it has a session
+    // Caller holds conn.write_mutex
+    bool writeConnection(Connection& conn, iovec* iov, size_t iovcnt);
+
+    // Parse and answer buffered RTSP requests; false if the connection must close
+    bool processInput(Connection& conn);
+    std::string handleRequest(Connection& conn, const std::string& request);
+    void closeConnection(std::shared_ptr<Connection> conn);
+
+    // Send the RTP packets of the current frame to every playing session
+    void fanOut(bool keyframe);
+    bool sendUdp(Connection& conn);
+    bool sendInterleaved(Connection& conn);
+
+    // AVIO write callback (buffer became const in libavformat 62)
+#if LIBAVFORMAT_VERSION_MAJOR >= 62
+    static int writeRtpPacket(void* opaque, const uint8_t* data, int size);
+#else
+    static int writeRtpPacket(void* opaque, uint8_t* data, int size);
+#endif
+
+    void setError(const std::string& message);
+
+    std::string file_path_;
+    std::string url_;
+    std::string sdp_;
+    int listen_fd_ = -1;
+
+    // RTSPS listener (tls_listen_fd_ stays -1 without TLS)
+    bool tls_enabled_ = false;
+    std::string tls_cipher_list_;
+    std::string tls_url_;
+    int tls_listen_fd_ = -1;
+    ssl_ctx_st* tls_ctx_ = nullptr;
+    std::string tls_cipher_;  // Guarded by error_mutex_
+
+    // Source demuxer and RTP packetizer (sender thread only after start())
+    UniqueAVFormatContext input_ctx_;
+    AVFormatContext* rtp_ctx_ = nullptr;
+    int video_stream_index_ = -1;
+    std::vector<std::vector<uint8_t>> rtp_packets_;
+    size_t rtp_packet_count_ = 0;
+
+    // Control thread owns connections; the sender sees playing sessions
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::vector<std::shared_ptr<Connection>> sessions_;
+    std::mutex sessions_mutex_;
+    uint32_t next_session_ = 1;
+    uint32_t ssrc_base_ = 0;
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<double> control_cpu_ms_{0.0};
+    std::atomic<double> sender_cpu_ms_{0.0};
+    std::atomic<int64_t> packets_sent_{0};
+
+    mutable std::mutex error_mutex_;
+    std::string error_message_;
+
+    std::thread control_thread_;
+    std::thread sender_thread_;
+};
+
+} // namespace video_bench
+
+#endif // RTSP_STAND_IN_HPP
@@ -0,0 +1,566 @@
+#include "network/segment_server.hpp"
+#include "utils/thread_cpu_time.hpp"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+constexpr int kPollTimeoutMs = 100;
+constexpr int kAvioBufferSize = 64 * 1024;
+constexpr size_t kMaxRequestBytes = 16384;
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Header value from a request, empty if missing
+std::string headerValue(const std::string& request, const std::string& name) {
+    std::string lower = toLower(request);
+    size_t pos = lower.find("\n" + toLower(name) + ":");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += name.size() + 2;
+    size_t end = request.find("\r\n", pos);
+    std::string value = request.substr(pos, end - pos);
+    value.erase(0, value.find_first_not_of(' '));
+    return value;
+}
+
+std::vector<uint8_t> toBytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+} // namespace
+
+SegmentServer::SegmentServer(const std::string& file_path, Format format,
+                             const std::vector<double>& segment_durations)
+    : file_path_(file_path)
+    , format_(format) {
+    for (double duration : segment_durations) {
+        auto variant = std::make_unique<Variant>();
+        variant->target_duration = duration;
+        variants_.push_back(std::move(variant));
+    }
+}
+
+SegmentServer::~SegmentServer() {
+    stop();
+}
+
+const char* SegmentServer::formatName(Format format) {
+    return format == Format::Hls ? "hls" : "dash";
+}
+
+bool SegmentServer::start(std::string& error_message) {
+    for (auto& variant : variants_) {
+        if (!segmentVariant(*variant, error_message)) {
+            return false;
+        }
+        buildManifest(*variant);
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        error_message = "Segment server: socket() failed: " + std::string(std::strerror(errno));
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd_, SOMAXCONN) < 0) {
+        error_message = "Segment server: failed to listen: " + std::string(std::strerror(errno));
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    base_url_ = "http://127.0.0.1:" + std::to_string(ntohs(addr.sin_port));
+
+    thread_ = std::thread([this] { serveLoop(); });
+    return true;
+}
+
+void SegmentServer::stop() {
+    stopping_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    for (const auto& conn : connections_) {
+        close(conn.fd);
+    }
+    connections_.clear();
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+std::string SegmentServer::getUrl(size_t variant) const {
+    return base_url_ + "/v" + std::to_string(variant) +
+           (format_ == Format::Hls ? "/index.m3u8" : "/manifest.mpd");
+}
+
+double SegmentServer::getSegmentDuration(size_t variant) const {
+    const auto& durations = variants_[variant]->durations;
+    if (durations.empty()) {
+        return 0.0;
+    }
+    return std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size();
+}
+
+SegmentServerCounters SegmentServer::getCounters(size_t variant) const {
+    const Variant& v = *variants_[variant];
+    SegmentServerCounters counters;
+    counters.segments = v.segment_requests.load(std::memory_order_relaxed);
+    counters.manifests = v.manifest_requests.load(std::memory_order_relaxed);
+    counters.init_segments = v.init_requests.load(std::memory_order_relaxed);
+    counters.bytes = v.bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+double SegmentServer::getCpuMs() const {
+    return cpu_ms_.load(std::memory_order_relaxed);
+}
+
+std::string SegmentServer::getError() const {
+    std::lock_guard lock(error_mutex_);
+    return error_message_;
+}
+
+void SegmentServer::setError(const std::string& message) {
+    std::lock_guard lock(error_mutex_);
+    if (error_message_.empty()) {
+        error_message_ = message;
+    }
+}
+
+#if LIBAVFORMAT_VERSION_MAJOR >= 62
+int SegmentServer::writeOutput(void* opaque, const uint8_t* data, int size) {
+#else
+int SegmentServer::writeOutput(void* opaque, uint8_t* data, int size) {
+#endif
+    auto* output = static_cast<std::vector<uint8_t>*>(opaque);
+    output->insert(output->end(), data, data + size);
+    return size;
+}
+
+bool SegmentServer::segmentVariant(Variant& variant, std::string& error_message) {
+    AVFormatContext* input_raw = nullptr;
+    int ret = avformat_open_input(&input_raw, file_path_.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Segment server: failed to open source: " + ffmpegErrorString(ret);
+        return false;
+    }
+    UniqueAVFormatContext input(input_raw);
+
+    ret = avformat_find_stream_info(input.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Segment server: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+    int video_index = av_find_best_stream(input.get(), AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (video_index < 0) {
+        error_message = "Segment server: no video stream found";
+        return false;
+    }
+    const AVStream* in_stream = input->streams[video_index];
+
+    AVFormatContext* output_raw = nullptr;
+    ret = avformat_alloc_output_context2(&output_raw, nullptr, "mp4", nullptr);
+    if (ret < 0 || !output_raw) {
+        error_message = "Segment server: MP4 muxer not available";
+        return false;
+    }
+    UniqueAVFormatContext output(output_raw);
+
+    AVStream* out_stream = avformat_new_stream(output.get(), nullptr);
+    if (!out_stream) {
+        error_message = "Segment server: failed to create output stream";
+        return false;
+    }
+    avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar);
+    out_stream->codecpar->codec_tag = 0;
+    out_stream->time_base = in_stream->time_base;
+
+    // Muxer output accumulates here and is cut at every fragment flush
+    std::vector<uint8_t> pending;
+    auto* buffer = static_cast<unsigned char*>(av_malloc(kAvioBufferSize));
+    output->pb = avio_alloc_context(buffer, kAvioBufferSize, 1, &pending,
+                                    nullptr, &SegmentServer::writeOutput, nullptr);
+    if (!buffer || !output->pb) {
+        av_free(buffer);
+        error_message = "Segment server: failed to allocate muxer I/O";
+        return false;
+    }
+    // The I/O context is not freed with the format context
+    struct PbGuard {
+        AVFormatContext* ctx;
+        ~PbGuard() {
+            av_freep(&ctx->pb->buffer);
+            avio_context_free(&ctx->pb);
+        }
+    } pb_guard{output.get()};
+
+    // Fragments only when asked for, so each fragment is exactly one segment
+    AVDictionary* options = nullptr;
+    av_dict_set(&options, "movflags", "frag_custom+empty_moov+default_base_moof", 0);
+    ret = avformat_write_header(output.get(), &options);
+    av_dict_free(&options);
+    if (ret < 0) {
+        error_message = "Segment server: fMP4 muxer rejected the stream: " + ffmpegErrorString(ret);
+        return false;
+    }
+    avio_flush(output->pb);
+    variant.init = std::move(pending);
+    pending.clear();
+
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        error_message = "Segment server: failed to allocate packet";
+        return false;
+    }
+
+    const AVRational in_time_base = in_stream->time_base;
+    const AVRational out_time_base = out_stream->time_base;
+    int64_t first_dts = AV_NOPTS_VALUE;
+    int64_t segment_start = 0;
+    int64_t segment_end = 0;
+    int64_t segment_packets = 0;
+    const auto target = static_cast<int64_t>(variant.target_duration / av_q2d(in_time_base));
+
+    auto cutSegment = [&](int64_t end) {
+        av_write_frame(output.get(), nullptr);  // Flush the fragment
+        avio_flush(output->pb);
+        variant.segments.push_back(std::move(pending));
+        variant.durations.push_back((end - segment_start) * av_q2d(in_time_base));
+        pending.clear();
+        segment_start = end;
+        segment_packets = 0;
+    };
+
+    while ((ret = av_read_frame(input.get(), packet.get())) >= 0) {
+        if (packet->stream_index != video_index) {
+            av_packet_unref(packet.get());
+            continue;
+        }
+        int64_t dts = packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts;
+        if (dts == AV_NOPTS_VALUE) {
+            av_packet_unref(packet.get());
+            continue;
+        }
+        if (first_dts == AV_NOPTS_VALUE) {
+            first_dts = dts;
+        }
+        dts -= first_dts;
+
+        // Cut at the first keyframe at or past the target duration
+        bool keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+        if (keyframe && segment_packets > 0 && dts - segment_start >= target) {
+            cutSegment(dts);
+        }
+        segment_end = std::max(segment_end, dts + std::max<int64_t>(packet->duration, 1));
+
+        if (packet->pts != AV_NOPTS_VALUE) packet->pts -= first_dts;
+        packet->dts = dts;
+        av_packet_rescale_ts(packet.get(), in_time_base, out_time_base);
+        packet->stream_index = 0;
+        ret = av_write_frame(output.get(), packet.get());
+        av_packet_unref(packet.get());
+        if (ret < 0) {
+            error_message = "Segment server: muxing failed: " + ffmpegErrorString(ret);
+            return false;
+        }
+        segment_packets++;
+    }
+    if (ret != AVERROR_EOF) {
+        error_message = "Segment server: read error: " + ffmpegErrorString(ret);
+        return false;
+    }
+    if (segment_packets > 0) {
+        cutSegment(segment_end);
+    }
+    av_write_trailer(output.get());  // Trailing index boxes are not served
+
+    if (variant.segments.empty()) {
+        error_message = "Segment server: source has no video packets";
+        return false;
+    }
+    return true;
+}
+
+void SegmentServer::buildManifest(Variant& variant) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    if (format_ == Format::Hls) {
+        double longest = *std::max_element(variant.durations.begin(), variant.durations.end());
+        out << "#EXTM3U\n"
+            << "#EXT-X-VERSION:7\n"
+            << "#EXT-X-TARGETDURATION:" << static_cast<int>(std::ceil(longest)) << "\n"
+            << "#EXT-X-PLAYLIST-TYPE:VOD\n"
+            << "#EXT-X-MEDIA-SEQUENCE:0\n"
+            << "#EXT-X-INDEPENDENT-SEGMENTS\n"
+            << "#EXT-X-MAP:URI=\"init.mp4\"\n";
+        for (size_t i = 0; i < variant.segments.size(); i++) {
+            out << "#EXTINF:" << variant.durations[i] << ",\n"
+                << "seg" << i << ".m4s\n";
+        }
+        out << "#EXT-X-ENDLIST\n";
+    } else {
+        double total = std::accumulate(variant.durations.begin(), variant.durations.end(), 0.0);
+        out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+            << "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\" type=\"static\""
+            << " profiles=\"urn:mpeg:dash:profile:isoff-live:2011\""
+            << " minBufferTime=\"PT2S\" mediaPresentationDuration=\"PT" << total << "S\">\n"
+            << " <Period start=\"PT0S\">\n"
+            << "  <AdaptationSet mimeType=\"video/mp4\" segmentAlignment=\"true\">\n"
+            << "   <Representation id=\"0\" bandwidth=\"1000000\">\n"
+            << "    <SegmentTemplate timescale=\"1000\" initialization=\"init.mp4\""
+            << " media=\"seg$Number$.m4s\" startNumber=\"0\">\n"
+            << "     <SegmentTimeline>\n";
+        int64_t t = 0;
+        for (double duration : variant.durations) {
+            auto d = static_cast<int64_t>(std::llround(duration * 1000.0));
+            out << "      <S t=\"" << t << "\" d=\"" << d << "\"/>\n";
+            t += d;
+        }
+        out << "     </SegmentTimeline>\n"
+            << "    </SegmentTemplate>\n"
+            << "   </Representation>\n"
+            << "  </AdaptationSet>\n"
+            << " </Period>\n"
+            << "</MPD>\n";
+    }
+    variant.manifest = toBytes(out.str());
+}
+
+void SegmentServer::serveLoop() {
+    const double cpu_start = threadCpuTimeMs();
+    std::vector<pollfd> fds;
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        fds.clear();
+        fds.push_back({listen_fd_, POLLIN, 0});
+        for (const auto& conn : connections_) {
+            short events = POLLIN;
+            if (!conn.output.empty()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({conn.fd, events, 0});
+        }
+
+        int ready = poll(fds.data(), fds.size(), kPollTimeoutMs);
+        if (ready < 0 && errno != EINTR) {
+            setError("Segment server: poll() failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+        if (ready > 0) {
+            // Existing connections first; accepting appends to the list
+            std::vector<size_t> to_close;
+            for (size_t i = 1; i < fds.size(); i++) {
+                Connection& conn = connections_[i - 1];
+                bool ok = true;
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    char buf[4096];
+                    ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+                    if (n > 0) {
+                        conn.input.append(buf, static_cast<size_t>(n));
+                        ok = processInput(conn);
+                    } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                        ok = false;
+                    }
+                }
+                if (ok && !conn.output.empty()) {
+                    ok = flushOutput(conn);
+                }
+                if (!ok || (conn.close_after_output && conn.output.empty())) {
+                    to_close.push_back(i - 1);
+                }
+            }
+            for (auto it = to_close.rbegin(); it != to_close.rend(); ++it) {
+                close(connections_[*it].fd);
+                connections_.erase(connections_.begin() + static_cast<std::ptrdiff_t>(*it));
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listen_fd_, nullptr, nullptr);
+                if (fd >= 0) {
+                    // Non-blocking: a client that stops reading must not stall the rest
+                    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                    int one = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    Connection conn;
+                    conn.fd = fd;
+                    connections_.push_back(std::move(conn));
+                }
+            }
+        }
+
+        cpu_ms_.store(threadCpuTimeMs() - cpu_start, std::memory_order_relaxed);
+    }
+}
+
+bool SegmentServer::processInput(Connection& conn) {
+    while (!conn.close_after_output) {
+        size_t end = conn.input.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            return conn.input.size() < kMaxRequestBytes;
+        }
+        std::string request = conn.input.substr(0, end + 4);
+        conn.input.erase(0, end + 4);
+
+        bool close_after = false;
+        conn.output.push_back(handleRequest(request, close_after));
+        conn.close_after_output = close_after;
+    }
+    return true;
+}
+
+SegmentServer::Response SegmentServer::handleRequest(const std::string& request,
+                                                     bool& close_after) {
+    std::istringstream in(request);
+    std::string method;
+    std::string target;
+    std::string version;
+    in >> method >> target >> version;
+
+    close_after = version == "HTTP/1.0" ||
+                  toLower(headerValue(request, "Connection")) == "close";
+
+    Response response;
+    auto status = [&](const std::string& line) {
+        response.head = "HTTP/1.1 " + line + "\r\nContent-Length: 0\r\n";
+        response.head += close_after ? "Connection: close\r\n\r\n" : "\r\n";
+        return response;
+    };
+
+    if (method != "GET") {
+        return status("405 Method Not Allowed");
+    }
+
+    // /v<variant>/<index.m3u8|manifest.mpd|init.mp4|seg<N>.m4s>
+    size_t variant_index = 0;
+    std::string name;
+    if (std::sscanf(target.c_str(), "/v%zu/", &variant_index) != 1 ||
+        variant_index >= variants_.size()) {
+        return status("404 Not Found");
+    }
+    name = target.substr(target.find('/', 1) + 1);
+    name = name.substr(0, name.find('?'));
+    Variant& variant = *variants_[variant_index];
+
+    const char* content_type = "video/mp4";
+    if (name == "index.m3u8" || name == "manifest.mpd") {
+        response.body = &variant.manifest;
+        content_type = format_ == Format::Hls ? "application/vnd.apple.mpegurl"
+                                              : "application/dash+xml";
+        variant.manifest_requests.fetch_add(1, std::memory_order_relaxed);
+    } else if (name == "init.mp4") {
+        response.body = &variant.init;
+        variant.init_requests.fetch_add(1, std::memory_order_relaxed);
+    } else if (name.rfind("seg", 0) == 0) {
+        size_t index = std::strtoul(name.c_str() + 3, nullptr, 10);
+        if (index >= variant.segments.size()) {
+            return status("404 Not Found");
+        }
+        response.body = &variant.segments[index];
+        variant.segment_requests.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        return status("404 Not Found");
+    }
+
+    // Byte ranges: FFmpeg's HTTP client uses them to resume and seek
+    const size_t size = response.body->size();
+    response.body_begin = 0;
+    response.body_end = size;
+    std::ostringstream head;
+    std::string range = headerValue(request, "Range");
+    unsigned long long first = 0;
+    unsigned long long last = 0;
+    int fields = range.empty() ? 0 : std::sscanf(range.c_str(), "bytes=%llu-%llu", &first, &last);
+    if (fields >= 1 && first < size) {
+        response.body_begin = first;
+        response.body_end = fields == 2 ? std::min<size_t>(last + 1, size) : size;
+        head << "HTTP/1.1 206 Partial Content\r\n"
+             << "Content-Range: bytes " << response.body_begin << "-"
+             << response.body_end - 1 << "/" << size << "\r\n";
+    } else if (fields >= 1) {
+        return status("416 Range Not Satisfiable");
+    } else {
+        head << "HTTP/1.1 200 OK\r\n";
+    }
+    head << "Content-Type: " << content_type << "\r\n"
+         << "Content-Length: " << response.body_end - response.body_begin << "\r\n"
+         << "Accept-Ranges: bytes\r\n"
+         << (close_after ? "Connection: close\r\n" : "Connection: keep-alive\r\n")
+         << "\r\n";
+    response.head = head.str();
+    variant.bytes.fetch_add(static_cast<int64_t>(response.body_end - response.body_begin),
+                            std::memory_order_relaxed);
+    return response;
+}
+
+bool SegmentServer::flushOutput(Connection& conn) {
+    while (!conn.output.empty()) {
+        Response& response = conn.output.front();
+        const size_t head_size = response.head.size();
+        const size_t body_size = response.body ? response.body_end - response.body_begin : 0;
+
+        iovec iov[2];
+        int iovcnt = 0;
+        if (response.sent < head_size) {
+            iov[iovcnt++] = {response.head.data() + response.sent, head_size - response.sent};
+        }
+        if (body_size > 0) {
+            size_t body_sent = response.sent > head_size ? response.sent - head_size : 0;
+            if (body_sent < body_size) {
+                iov[iovcnt++] = {
+                    const_cast<uint8_t*>(response.body->data()) + response.body_begin + body_sent,
+                    body_size - body_sent};
+            }
+        }
+        if (iovcnt == 0) {
+            conn.output.pop_front();
+            continue;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<size_t>(iovcnt);
+        ssize_t sent = sendmsg(conn.fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return true;  // Resume on POLLOUT
+            }
+            return false;
+        }
+        response.sent += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+} // namespace video_bench
@@ -0,0 +1,136 @@
+#ifndef SEGMENT_SERVER_HPP
+#define SEGMENT_SERVER_HPP
+
+#include "utils/ffmpeg_utils.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+namespace video_bench {
+
+// Requests served for one segmentation (all clients combined)
+struct SegmentServerCounters {
+    int64_t segments = 0;       // Media segment requests
+    int64_t manifests = 0;      // Playlist/MPD requests
+    int64_t init_segments = 0;  // Initialization segment requests
+    int64_t bytes = 0;
+};
+
+// In-process HTTP server on loopback that serves a local file as HLS or
+// DASH. The file is remuxed once per segment duration into fragmented MP4
+// (an init segment plus media segments cut at the first keyframe after
+// each boundary) and served from memory as a VOD playlist or static MPD.
+class SegmentServer {
+public:
+    enum class Format { Hls, Dash };
+
+    SegmentServer(const std::string& file_path, Format format,
+                  const std::vector<double>& segment_durations);
+    ~SegmentServer();
+
+    // Non-copyable, non-movable (owns a thread)
+    SegmentServer(const SegmentServer&) = delete;
+    SegmentServer& operator=(const SegmentServer&) = delete;
+    SegmentServer(SegmentServer&&) = delete;
+    SegmentServer& operator=(SegmentServer&&) = delete;
+
+    // Segment the file for every duration, listen on 127.0.0.1 and serve
+    bool start(std::string& error_message);
+
+    // Stop serving and close all connections
+    void stop();
+
+    // One variant per requested segment duration
+    size_t getVariantCount() const { return variants_.size(); }
+
+    // Local file being served
+    const std::string& getFilePath() const { return file_path_; }
+
+    // Playlist (HLS) or MPD (DASH) URL of a variant (valid after start())
+    std::string getUrl(size_t variant) const;
+
+    // Mean duration of the variant's segments in seconds (after keyframe alignment)
+    double getSegmentDuration(size_t variant) const;
+
+    SegmentServerCounters getCounters(size_t variant) const;
+
+    // CPU time of the serving thread so far, in ms
+    double getCpuMs() const;
+
+    // Get first error from the serving thread, empty if none
+    std::string getError() const;
+
+    static const char* formatName(Format format);
+
+private:
+    struct Variant {
+        double target_duration = 0.0;
+        std::vector<uint8_t> init;
+        std::vector<std::vector<uint8_t>> segments;
+        std::vector<double> durations;
+        std::vector<uint8_t> manifest;
+
+        std::atomic<int64_t> segment_requests{0};
+        std::atomic<int64_t> manifest_requests{0};
+        std::atomic<int64_t> init_requests{0};
+        std::atomic<int64_t> bytes{0};
+    };
+
+    struct Response {
+        std::string head;
+        const std::vector<uint8_t>* body = nullptr;
+        size_t body_begin = 0;
+        size_t body_end = 0;
+        size_t sent = 0;  // Bytes of head + body range already written
+    };
+
+    struct Connection {
+        int fd = -1;
+        std::string input;
+        std::deque<Response> output;
+        bool close_after_output = false;
+    };
+
+    bool segmentVariant(Variant& variant, std::string& error_message);
+    void buildManifest(Variant& variant);
+
+    void serveLoop();
+    bool processInput(Connection& conn);
+    Response handleRequest(const std::string& request, bool& close_after);
+    // Write queued responses until done or the socket is full; false on error
+    bool flushOutput(Connection& conn);
+
+    // AVIO write callback (buffer became const in libavformat 62)
+#if LIBAVFORMAT_VERSION_MAJOR >= 62
+    static int writeOutput(void* opaque, const uint8_t* data, int size);
+#else
+    static int writeOutput(void* opaque, uint8_t* data, int size);
+#endif
+
+    void setError(const std::string& message);
+
+    std::string file_path_;
+    Format format_;
+    std::vector<std::unique_ptr<Variant>> variants_;
+    std::string base_url_;
+    int listen_fd_ = -1;
+
+    std::vector<Connection> connections_;  // Serving thread only
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<double> cpu_ms_{0.0};
+
+    mutable std::mutex error_mutex_;
+    std::string error_message_;
+
+    std::thread thread_;
+};
+
+} // namespace video_bench
+
+#endif // SEGMENT_SERVER_HPP
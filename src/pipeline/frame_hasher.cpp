@@ -0,0 +1,148 @@
+#include "pipeline/frame_hasher.hpp"
+#include "decoder/video_decoder.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include <cstring>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libavutil/imgutils.h>
+}
+
+namespace video_bench {
+
+namespace {
+
+// Final avalanche (murmur3 fmix64)
+uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace
+
+FrameHasher::FrameHasher()
+    : stripes_fn_(getHashStripesKernel()) {
+}
+
+void FrameHasher::hashRow(uint64_t* acc, const uint8_t* data, size_t len) const {
+    size_t stripes = len / kHashStripeBytes;
+    stripes_fn_(acc, data, stripes);
+
+    size_t tail = len - stripes * kHashStripeBytes;
+    if (tail > 0) {
+        uint8_t padded[kHashStripeBytes] = {};
+        std::memcpy(padded, data + stripes * kHashStripeBytes, tail);
+        stripes_fn_(acc, padded, 1);
+    }
+}
+
+uint64_t FrameHasher::hashFrame(const AVFrame* frame) const {
+    const auto format = static_cast<AVPixelFormat>(frame->format);
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+
+    int row_bytes[4] = {};
+    if (!desc || av_image_fill_linesizes(row_bytes, format, frame->width) < 0) {
+        return 0;
+    }
+
+    uint64_t acc[4] = {
+        kHashLaneKeys[0], kHashLaneKeys[1], kHashLaneKeys[2], kHashLaneKeys[3]
+    };
+
+    for (int plane = 0; plane < 4 && frame->data[plane] && row_bytes[plane] > 0; plane++) {
+        // Planes 1 and 2 are chroma (subsampled vertically); 0 is luma, 3 alpha
+        bool is_chroma = (plane == 1 || plane == 2);
+        int height = is_chroma
+            ? AV_CEIL_RSHIFT(frame->height, desc->log2_chroma_h)
+            : frame->height;
+
+        const uint8_t* row = frame->data[plane];
+        for (int y = 0; y < height; y++) {
+            hashRow(acc, row, static_cast<size_t>(row_bytes[plane]));
+            row += frame->linesize[plane];
+        }
+    }
+
+    uint64_t h = mix64(static_cast<uint64_t>(frame->width) << 32 |
+                       static_cast<uint32_t>(frame->height));
+    for (uint64_t lane : acc) {
+        h = mix64(h ^ lane);
+    }
+    return h;
+}
+
+bool FrameHasher::captureReference(const std::string& path,
+                                   std::vector<uint64_t>& hashes,
+                                   std::string& error_message) {
+    AVFormatContext* format_ctx_raw = nullptr;
+    int ret = avformat_open_input(&format_ctx_raw, path.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        error_message = "Reference: failed to open source: " + ffmpegErrorString(ret);
+        return false;
+    }
+    UniqueAVFormatContext format_ctx(format_ctx_raw);
+
+    ret = avformat_find_stream_info(format_ctx.get(), nullptr);
+    if (ret < 0) {
+        error_message = "Reference: failed to find stream info: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    int video_stream_index = -1;
+    for (unsigned int i = 0; i < format_ctx->nb_streams; i++) {
+        if (format_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+            video_stream_index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (video_stream_index < 0) {
+        error_message = "Reference: no video stream found";
+        return false;
+    }
+
+    // Single-threaded decode defines the reference output
+    VideoDecoder decoder;
+    if (!decoder.initFromParams(format_ctx->streams[video_stream_index]->codecpar,
+                                error_message, 1, false)) {
+        return false;
+    }
+
+    FrameHasher hasher;
+    UniqueAVPacket packet(av_packet_alloc());
+    if (!packet) {
+        error_message = "Reference: failed to allocate packet";
+        return false;
+    }
+
+    hashes.clear();
+    while (av_read_frame(format_ctx.get(), packet.get()) >= 0) {
+        if (packet->stream_index == video_stream_index) {
+            SingleFrameResult result = decoder.decodeFromPacket(packet.get());
+            if (!result.error_message.empty()) {
+                av_packet_unref(packet.get());
+                error_message = "Reference: " + result.error_message;
+                return false;
+            }
+            if (result.success) {
+                hashes.push_back(hasher.hashFrame(decoder.getFrame()));
+            }
+        }
+        av_packet_unref(packet.get());
+    }
+
+    while (decoder.flushDecoder().success) {
+        hashes.push_back(hasher.hashFrame(decoder.getFrame()));
+    }
+
+    if (hashes.empty()) {
+        error_message = "Reference: no frames decoded";
+        return false;
+    }
+    return true;
+}
+
+} // namespace video_bench
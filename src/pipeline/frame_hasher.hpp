@@ -0,0 +1,57 @@
+#ifndef FRAME_HASHER_HPP
+#define FRAME_HASHER_HPP
+
+#include "pipeline/simd_kernels.hpp"
+#include "utils/latency_stats.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace video_bench {
+
+// Output hash verification statistics (per stream, merged per test)
+struct HashCheckCounters {
+    int64_t frames_checked = 0;
+    int64_t mismatches = 0;
+    int64_t unchecked = 0;            // Frames beyond the reference sequence
+    std::vector<int64_t> mismatch_frames;  // First mismatching frame indices
+    LatencyRecorder cost;             // Per-frame hashing time in ms
+
+    void merge(const HashCheckCounters& other) {
+        frames_checked += other.frames_checked;
+        mismatches += other.mismatches;
+        unchecked += other.unchecked;
+        mismatch_frames.insert(mismatch_frames.end(),
+                               other.mismatch_frames.begin(), other.mismatch_frames.end());
+        cost.merge(other.cost);
+    }
+};
+
+// 64-bit hash over the visible area of every plane of a decoded frame
+// Stride-aware: row padding is skipped, so the hash only depends on pixels.
+class FrameHasher {
+public:
+    FrameHasher();
+
+    uint64_t hashFrame(const AVFrame* frame) const;
+
+    // Decode one loop of a local file single-threaded and hash every frame
+    // in output order; this is the reference for bit-exactness checks
+    static bool captureReference(const std::string& path,
+                                 std::vector<uint64_t>& hashes,
+                                 std::string& error_message);
+
+private:
+    // Hash one row: full stripes through the SIMD kernel, tail zero-padded
+    void hashRow(uint64_t* acc, const uint8_t* data, size_t len) const;
+
+    HashStripesFn stripes_fn_;
+};
+
+} // namespace video_bench
+
+#endif // FRAME_HASHER_HPP
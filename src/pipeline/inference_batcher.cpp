@@ -0,0 +1,200 @@
+#include "pipeline/inference_batcher.hpp"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace video_bench {
+
+namespace {
+// Pending frames allowed per batch slot before new submissions are dropped
+constexpr size_t kQueueDepthPerSlot = 2;
+
+// ImageNet mean and standard deviation (RGB, 0..1 scale)
+constexpr float kMean[3] = {0.485f, 0.456f, 0.406f};
+constexpr float kStd[3] = {0.229f, 0.224f, 0.225f};
+} // namespace
+
+InferenceBatcher::InferenceBatcher(int batch_size, int input_size, double deadline_ms)
+    : batch_size_(batch_size)
+    , input_size_(input_size)
+    , deadline_(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double, std::milli>(deadline_ms)))
+    , max_queue_size_(static_cast<size_t>(batch_size) * kQueueDepthPerSlot)
+    , batch_(static_cast<size_t>(batch_size) * 3 * input_size * input_size)
+    , resized_(av_frame_alloc())
+    , yuv_to_rgb_(getYuvRowToRgbKernel()) {
+    // (x / 255 - mean) / std folded into one multiply-add per channel
+    for (int c = 0; c < 3; c++) {
+        normalize_.scale[c] = 1.0f / (255.0f * kStd[c]);
+        normalize_.bias[c] = -kMean[c] / kStd[c];
+    }
+    thread_ = std::thread([this] { assembleLoop(); });
+}
+
+InferenceBatcher::~InferenceBatcher() {
+    stop();
+}
+
+bool InferenceBatcher::submit(const AVFrame* frame) {
+    auto submitted = Clock::now();
+    UniqueAVFrame ref(av_frame_clone(frame));
+
+    std::lock_guard lock(mutex_);
+    if (!ref || stopping_ || jobs_.size() >= max_queue_size_) {
+        counters_.frames_dropped++;
+        return false;
+    }
+
+    jobs_.push_back(Job{std::move(ref), submitted});
+    cv_.notify_one();
+    return true;
+}
+
+void InferenceBatcher::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+BatcherCounters InferenceBatcher::getCounters() const {
+    std::lock_guard lock(mutex_);
+    return counters_;
+}
+
+std::string InferenceBatcher::getError() const {
+    std::lock_guard lock(mutex_);
+    return error_message_;
+}
+
+bool InferenceBatcher::configure(const AVFrame* frame, std::string& error_message) {
+    if (!resized_) {
+        error_message = "Batcher: failed to allocate frame";
+        return false;
+    }
+
+    // Models take a fixed square input; the frame is stretched to fit
+    sws_ctx_.reset(sws_getContext(frame->width, frame->height,
+                                  static_cast<AVPixelFormat>(frame->format),
+                                  input_size_, input_size_, AV_PIX_FMT_YUV420P,
+                                  SWS_BILINEAR, nullptr, nullptr, nullptr));
+    if (!sws_ctx_) {
+        error_message = "Batcher: failed to create scaler";
+        return false;
+    }
+
+    if (!resized_->data[0]) {
+        resized_->format = AV_PIX_FMT_YUV420P;
+        resized_->width = input_size_;
+        resized_->height = input_size_;
+        int ret = av_frame_get_buffer(resized_.get(), 0);
+        if (ret < 0) {
+            error_message = "Batcher: failed to allocate resize buffer: " + ffmpegErrorString(ret);
+            return false;
+        }
+    }
+
+    src_width_ = frame->width;
+    src_height_ = frame->height;
+    src_format_ = frame->format;
+    return true;
+}
+
+bool InferenceBatcher::convert(const AVFrame* frame, float* slot, std::string& error_message) {
+    if (frame->width != src_width_ || frame->height != src_height_ ||
+        frame->format != src_format_) {
+        if (!configure(frame, error_message)) {
+            return false;
+        }
+    }
+
+    sws_scale(sws_ctx_.get(), frame->data, frame->linesize, 0, frame->height,
+              resized_->data, resized_->linesize);
+
+    // NCHW: the slot holds the R, G and B planes back to back
+    const size_t plane = static_cast<size_t>(input_size_) * input_size_;
+    for (int row = 0; row < input_size_; row++) {
+        const size_t offset = static_cast<size_t>(row) * input_size_;
+        yuv_to_rgb_(resized_->data[0] + static_cast<ptrdiff_t>(row) * resized_->linesize[0],
+                    resized_->data[1] + static_cast<ptrdiff_t>(row / 2) * resized_->linesize[1],
+                    resized_->data[2] + static_cast<ptrdiff_t>(row / 2) * resized_->linesize[2],
+                    input_size_, normalize_,
+                    slot + offset, slot + plane + offset, slot + 2 * plane + offset);
+    }
+    return true;
+}
+
+void InferenceBatcher::completeBatch(bool full) {
+    // Called with mutex_ held
+    counters_.assembly.add(std::chrono::duration<double, std::milli>(
+        Clock::now() - batch_oldest_).count());
+    if (full) {
+        counters_.full_batches++;
+    } else {
+        counters_.deadline_batches++;
+    }
+    batch_fill_ = 0;
+}
+
+void InferenceBatcher::assembleLoop() {
+    const size_t slot_size = static_cast<size_t>(3) * input_size_ * input_size_;
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            auto ready = [this] { return stopping_ || !jobs_.empty(); };
+            if (batch_fill_ > 0) {
+                // Wake for a new frame or when the open batch hits its deadline
+                cv_.wait_until(lock, batch_oldest_ + deadline_, ready);
+                if (Clock::now() >= batch_oldest_ + deadline_) {
+                    completeBatch(false);
+                }
+            } else {
+                cv_.wait(lock, ready);
+            }
+            if (jobs_.empty()) {
+                if (stopping_) {
+                    if (batch_fill_ > 0) {
+                        completeBatch(false);
+                    }
+                    return;  // Stopping and fully drained
+                }
+                continue;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        if (batch_fill_ == 0) {
+            batch_oldest_ = job.submitted;
+        }
+
+        std::string error;
+        auto convert_start = Clock::now();
+        bool ok = convert(job.frame.get(), batch_.data() + batch_fill_ * slot_size, error);
+        double convert_ms = std::chrono::duration<double, std::milli>(
+            Clock::now() - convert_start).count();
+
+        std::lock_guard lock(mutex_);
+        if (!ok) {
+            if (error_message_.empty()) {
+                error_message_ = error;
+            }
+            continue;
+        }
+        counters_.frames_batched++;
+        counters_.convert.add(convert_ms);
+        if (++batch_fill_ == batch_size_) {
+            completeBatch(true);
+        }
+    }
+}
+
+} // namespace video_bench
@@ -0,0 +1,106 @@
+#ifndef INFERENCE_BATCHER_HPP
+#define INFERENCE_BATCHER_HPP
+
+#include "utils/ffmpeg_utils.hpp"
+#include "utils/latency_stats.hpp"
+#include "pipeline/simd_kernels.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace video_bench {
+
+// Aggregated batcher statistics
+struct BatcherCounters {
+    int64_t frames_batched = 0;
+    int64_t frames_dropped = 0;   // Submissions rejected because the queue was full
+    int64_t full_batches = 0;
+    int64_t deadline_batches = 0;  // Partial batches flushed at the deadline
+    LatencyRecorder assembly;      // Oldest frame submitted -> batch complete, in ms
+    LatencyRecorder convert;       // Resize + YUV -> RGB per frame, in ms
+};
+
+// Gathers decoded frames from all streams into fixed-size NCHW float
+// batches, as a CPU inference node would before running a model.
+// Each frame is resized to input_size x input_size with swscale, then
+// converted to normalized planar RGB with the SIMD row kernel. A batch is
+// complete when full or when its oldest frame has waited deadline_ms.
+class InferenceBatcher {
+public:
+    InferenceBatcher(int batch_size, int input_size, double deadline_ms);
+    ~InferenceBatcher();
+
+    // Non-copyable, non-movable (owns a thread)
+    InferenceBatcher(const InferenceBatcher&) = delete;
+    InferenceBatcher& operator=(const InferenceBatcher&) = delete;
+    InferenceBatcher(InferenceBatcher&&) = delete;
+    InferenceBatcher& operator=(InferenceBatcher&&) = delete;
+
+    // Queue a frame for the next batch (takes a new reference, never blocks)
+    // Returns false if the queue is full and the frame was dropped
+    bool submit(const AVFrame* frame);
+
+    // Drain pending frames, flush the partial batch and stop the thread
+    void stop();
+
+    // Get accumulated statistics (call after stop())
+    BatcherCounters getCounters() const;
+
+    // Get first conversion error, empty if none
+    std::string getError() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        UniqueAVFrame frame;
+        Clock::time_point submitted;
+    };
+
+    void assembleLoop();
+
+    // Resize and convert one frame into the next batch slot
+    bool convert(const AVFrame* frame, float* slot, std::string& error_message);
+
+    // (Re)create the scaler for the given source geometry
+    bool configure(const AVFrame* frame, std::string& error_message);
+
+    // Batch complete: record latency and start a new one
+    void completeBatch(bool full);
+
+    int batch_size_;
+    int input_size_;
+    std::chrono::duration<double, std::milli> deadline_;
+    size_t max_queue_size_;
+
+    // Assembly thread only
+    std::vector<float> batch_;  // batch_size x 3 x input_size x input_size
+    int batch_fill_ = 0;
+    Clock::time_point batch_oldest_;
+    UniqueSwsContext sws_ctx_;
+    UniqueAVFrame resized_;
+    int src_width_ = 0;
+    int src_height_ = 0;
+    int src_format_ = -1;
+    YuvRowToRgbFn yuv_to_rgb_;
+    RgbNormalize normalize_;
+
+    std::deque<Job> jobs_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    BatcherCounters counters_;
+    std::string error_message_;
+
+    std::thread thread_;
+};
+
+} // namespace video_bench
+
+#endif // INFERENCE_BATCHER_HPP
@@ -0,0 +1,201 @@
+#include "pipeline/mosaic_compositor.hpp"
+#include <cmath>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace video_bench {
+
+namespace {
+// A tile without a new frame for this many source intervals is stale
+constexpr int kStaleIntervals = 2;
+
+// Black in limited-range YUV
+constexpr uint8_t kBlackLuma = 16;
+constexpr uint8_t kBlackChroma = 128;
+
+// Copy a rectangle of one plane between two frames of the same geometry
+void copyArea(const AVFrame* src, AVFrame* dst, int plane, int x, int y, int width, int height) {
+    const uint8_t* from = src->data[plane] + static_cast<ptrdiff_t>(y) * src->linesize[plane] + x;
+    uint8_t* to = dst->data[plane] + static_cast<ptrdiff_t>(y) * dst->linesize[plane] + x;
+    for (int row = 0; row < height; row++) {
+        std::memcpy(to, from, width);
+        from += src->linesize[plane];
+        to += dst->linesize[plane];
+    }
+}
+} // namespace
+
+MosaicCompositor::MosaicCompositor(int tiles, int canvas_width, int canvas_height, double fps,
+                                   double source_fps, const MeasurementWindow* window)
+    : columns_(static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tiles)))))
+    , tile_width_((canvas_width / columns_) & ~1)
+    , tile_height_((canvas_height / columns_) & ~1)
+    , interval_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps)))
+    , stale_after_(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(kStaleIntervals / source_fps)))
+    , window_(window)
+    , canvas_(av_frame_alloc())
+    , presented_(av_frame_alloc()) {
+    tiles_.reserve(tiles);
+    for (int i = 0; i < tiles; i++) {
+        auto tile = std::make_unique<Tile>();
+        tile->x = (i % columns_) * tile_width_;
+        tile->y = (i / columns_) * tile_height_;
+        tiles_.push_back(std::move(tile));
+    }
+
+    // Allocated here: decoder threads may update tiles before start()
+    for (AVFrame* frame : {canvas_.get(), presented_.get()}) {
+        if (!frame) {
+            continue;
+        }
+        frame->format = AV_PIX_FMT_YUV420P;
+        frame->width = canvas_width;
+        frame->height = canvas_height;
+        if (av_frame_get_buffer(frame, 0) < 0) {
+            continue;
+        }
+        for (int plane = 0; plane < 3; plane++) {
+            int rows = plane == 0 ? canvas_height : (canvas_height + 1) / 2;
+            std::memset(frame->data[plane], plane == 0 ? kBlackLuma : kBlackChroma,
+                        static_cast<size_t>(frame->linesize[plane]) * rows);
+        }
+    }
+}
+
+MosaicCompositor::~MosaicCompositor() {
+    stop();
+}
+
+bool MosaicCompositor::updateTile(int tile, const AVFrame* frame, std::string& error_message) {
+    if (!canvas_ || !canvas_->data[0]) {
+        error_message = "Mosaic: failed to allocate canvas";
+        return false;
+    }
+
+    Tile& t = *tiles_[tile];
+    auto scale_start = Clock::now();
+    if (frame->width != t.src_width || frame->height != t.src_height ||
+        frame->format != t.src_format) {
+        // Tiles are stretched to the grid cell, as most video walls do
+        t.sws_ctx.reset(sws_getContext(frame->width, frame->height,
+                                       static_cast<AVPixelFormat>(frame->format),
+                                       tile_width_, tile_height_, AV_PIX_FMT_YUV420P,
+                                       SWS_BILINEAR, nullptr, nullptr, nullptr));
+        if (!t.sws_ctx) {
+            error_message = "Mosaic: failed to create tile scaler";
+            return false;
+        }
+        t.src_width = frame->width;
+        t.src_height = frame->height;
+        t.src_format = frame->format;
+    }
+
+    uint8_t* dst[4] = {
+        canvas_->data[0] + static_cast<ptrdiff_t>(t.y) * canvas_->linesize[0] + t.x,
+        canvas_->data[1] + static_cast<ptrdiff_t>(t.y / 2) * canvas_->linesize[1] + t.x / 2,
+        canvas_->data[2] + static_cast<ptrdiff_t>(t.y / 2) * canvas_->linesize[2] + t.x / 2,
+        nullptr
+    };
+
+    std::lock_guard lock(t.mutex);
+    sws_scale(t.sws_ctx.get(), frame->data, frame->linesize, 0, frame->height,
+              dst, canvas_->linesize);
+    t.updated = Clock::now();
+    t.has_frame = true;
+    t.updates++;
+    t.scale.add(std::chrono::duration<double, std::milli>(t.updated - scale_start).count());
+    return true;
+}
+
+bool MosaicCompositor::start(std::string& error_message) {
+    if (!canvas_ || !canvas_->data[0] || !presented_ || !presented_->data[0]) {
+        error_message = "Mosaic: failed to allocate canvas";
+        return false;
+    }
+    thread_ = std::thread([this] { composeLoop(); });
+    return true;
+}
+
+void MosaicCompositor::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+MosaicCounters MosaicCompositor::getCounters() const {
+    MosaicCounters counters;
+    {
+        std::lock_guard lock(mutex_);
+        counters = counters_;
+    }
+    for (const auto& tile : tiles_) {
+        std::lock_guard lock(tile->mutex);
+        counters.tile_updates += tile->updates;
+        counters.tile_scale.merge(tile->scale);
+    }
+    return counters;
+}
+
+bool MosaicCompositor::presentTile(Tile& tile, Clock::time_point now) {
+    std::lock_guard lock(tile.mutex);
+    copyArea(canvas_.get(), presented_.get(), 0, tile.x, tile.y, tile_width_, tile_height_);
+    copyArea(canvas_.get(), presented_.get(), 1, tile.x / 2, tile.y / 2,
+             tile_width_ / 2, tile_height_ / 2);
+    copyArea(canvas_.get(), presented_.get(), 2, tile.x / 2, tile.y / 2,
+             tile_width_ / 2, tile_height_ / 2);
+    return tile.has_frame && now - tile.updated <= stale_after_;
+}
+
+void MosaicCompositor::composeLoop() {
+    auto slot = Clock::now() + interval_;
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            if (cv_.wait_until(lock, slot, [this] { return stopping_; })) {
+                return;
+            }
+        }
+
+        auto compose_start = Clock::now();
+        int64_t stale = 0;
+        for (const auto& tile : tiles_) {
+            if (!presentTile(*tile, compose_start)) {
+                stale++;
+            }
+        }
+        auto done = Clock::now();
+
+        // Skip missed slots instead of bursting
+        int64_t slots = 1;
+        slot += interval_;
+        while (slot <= done) {
+            slot += interval_;
+            slots++;
+        }
+
+        // Due before the next slot, like a frame due at the next vsync: a
+        // composite that overran k slots left the screen stale for all k
+        if (!window_ || window_->contains(MeasurementWindow::nowNs())) {
+            std::lock_guard lock(mutex_);
+            counters_.composites++;
+            counters_.slots += slots;
+            counters_.deadline_misses += slots - 1;
+            counters_.stale_tiles += stale;
+            counters_.compose.add(std::chrono::duration<double, std::milli>(
+                done - compose_start).count());
+        }
+    }
+}
+
+} // namespace video_bench
@@ -0,0 +1,105 @@
+#ifndef MOSAIC_COMPOSITOR_HPP
+#define MOSAIC_COMPOSITOR_HPP
+
+#include "decoder/measurement_window.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include "utils/latency_stats.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace video_bench {
+
+// Aggregated mosaic statistics (composites inside the measurement window)
+struct MosaicCounters {
+    int64_t composites = 0;
+    int64_t slots = 0;            // Composite slots elapsed, including skipped ones
+    int64_t deadline_misses = 0;  // Slots without a composite ready by their end
+    int64_t stale_tiles = 0;      // Tiles presented without a recent frame
+    int64_t tile_updates = 0;     // Frames scaled into tiles (whole run)
+    LatencyRecorder compose;      // Canvas copy per composite, in ms
+    LatencyRecorder tile_scale;   // Per tile update, in ms
+};
+
+// Video wall: every stream scales its decoded frames into its own tile of
+// one shared YUV 4:2:0 canvas (on its decoder thread), and a compositor
+// thread presents the canvas at a fixed rate by copying it out tile by
+// tile, as a client would for display. The grid is the smallest square
+// that holds all tiles (9 tiles: 3x3, 16 tiles: 4x4).
+class MosaicCompositor {
+public:
+    // source_fps: a tile is stale when its last frame is older than two
+    // source frame intervals; window: only composites inside it count
+    MosaicCompositor(int tiles, int canvas_width, int canvas_height, double fps,
+                     double source_fps, const MeasurementWindow* window);
+    ~MosaicCompositor();
+
+    // Non-copyable, non-movable (owns a thread)
+    MosaicCompositor(const MosaicCompositor&) = delete;
+    MosaicCompositor& operator=(const MosaicCompositor&) = delete;
+    MosaicCompositor(MosaicCompositor&&) = delete;
+    MosaicCompositor& operator=(MosaicCompositor&&) = delete;
+
+    // Scale a decoded frame into a tile (only from that tile's decoder thread)
+    bool updateTile(int tile, const AVFrame* frame, std::string& error_message);
+
+    // Start presenting; stop() ends the compositor thread
+    bool start(std::string& error_message);
+    void stop();
+
+    int getColumns() const { return columns_; }
+    int getTileWidth() const { return tile_width_; }
+    int getTileHeight() const { return tile_height_; }
+
+    // Get accumulated statistics (call after stop())
+    MosaicCounters getCounters() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Tile {
+        std::mutex mutex;  // Held while the tile's canvas area is written or read
+        int x = 0;
+        int y = 0;
+        UniqueSwsContext sws_ctx;
+        int src_width = 0;
+        int src_height = 0;
+        int src_format = -1;
+        Clock::time_point updated;
+        bool has_frame = false;
+        int64_t updates = 0;
+        LatencyRecorder scale;
+    };
+
+    void composeLoop();
+
+    // Copy one tile's canvas area to the presented frame; true if fresh
+    bool presentTile(Tile& tile, Clock::time_point now);
+
+    int columns_;
+    int tile_width_;
+    int tile_height_;
+    Clock::duration interval_;
+    Clock::duration stale_after_;
+    const MeasurementWindow* window_;
+
+    UniqueAVFrame canvas_;     // Written by decoder threads, per tile
+    UniqueAVFrame presented_;  // Compositor thread only
+    std::vector<std::unique_ptr<Tile>> tiles_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    MosaicCounters counters_;  // Compositor fields, under mutex_
+
+    std::thread thread_;
+};
+
+} // namespace video_bench
+
+#endif // MOSAIC_COMPOSITOR_HPP
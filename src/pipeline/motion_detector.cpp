@@ -0,0 +1,101 @@
+#include "pipeline/motion_detector.hpp"
+#include <algorithm>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+namespace video_bench {
+
+namespace {
+// Mean absolute luma difference per pixel above which a block counts as changed
+constexpr uint32_t kBlockDiffThreshold = 12;
+constexpr uint32_t kBlockPixels = kSadBlockWidth * kSadBlockWidth;
+} // namespace
+
+MotionDetector::MotionDetector(int downsample)
+    : downsample_(std::max(1, downsample))
+    , sad_row_(getSadRowKernel()) {
+}
+
+void MotionDetector::configure(const AVFrame* frame) {
+    const AVPixFmtDescriptor* desc =
+        av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+    luma_bytes_ = (desc && desc->comp[0].depth > 8) ? 2 : 1;
+    // Keep the top 8 significant bits; P010-style formats store them high
+    luma_shift_ = luma_bytes_ == 2 ? desc->comp[0].depth - 8 + desc->comp[0].shift : 0;
+    luma_big_endian_ = luma_bytes_ == 2 && (desc->flags & AV_PIX_FMT_FLAG_BE);
+
+    blocks_x_ = (frame->width / downsample_) / kSadBlockWidth;
+    blocks_y_ = (frame->height / downsample_) / kSadBlockWidth;
+    plane_width_ = blocks_x_ * kSadBlockWidth;
+    plane_height_ = blocks_y_ * kSadBlockWidth;
+
+    current_.assign(static_cast<size_t>(plane_width_) * plane_height_, 0);
+    previous_.assign(current_.size(), 0);
+    block_sad_.assign(static_cast<size_t>(blocks_x_), 0);
+    has_previous_ = false;
+
+    src_width_ = frame->width;
+    src_height_ = frame->height;
+    src_format_ = frame->format;
+}
+
+void MotionDetector::downsampleLuma(const AVFrame* frame) {
+    const int step = downsample_ * luma_bytes_;
+
+    for (int y = 0; y < plane_height_; y++) {
+        const uint8_t* src = frame->data[0] +
+            static_cast<ptrdiff_t>(y) * downsample_ * frame->linesize[0];
+        uint8_t* dst = current_.data() + static_cast<size_t>(y) * plane_width_;
+        if (luma_bytes_ == 1) {
+            for (int x = 0; x < plane_width_; x++) {
+                dst[x] = src[x * step];
+            }
+            continue;
+        }
+        // High bit depth: the whole sample, scaled to 8 bits for the SAD kernel
+        const int high = luma_big_endian_ ? 0 : 1;
+        for (int x = 0; x < plane_width_; x++) {
+            const uint8_t* sample = src + x * step;
+            const uint32_t value = (static_cast<uint32_t>(sample[high]) << 8) | sample[1 - high];
+            dst[x] = static_cast<uint8_t>(std::min<uint32_t>(value >> luma_shift_, 255));
+        }
+    }
+}
+
+bool MotionDetector::process(const AVFrame* frame) {
+    if (frame->width != src_width_ || frame->height != src_height_ ||
+        frame->format != src_format_) {
+        configure(frame);
+    }
+
+    changed_blocks_ = 0;
+    if (blocks_x_ == 0 || blocks_y_ == 0) {
+        return false;
+    }
+
+    downsampleLuma(frame);
+
+    if (has_previous_) {
+        for (int by = 0; by < blocks_y_; by++) {
+            std::fill(block_sad_.begin(), block_sad_.end(), 0u);
+            for (int row = 0; row < kSadBlockWidth; row++) {
+                size_t offset = static_cast<size_t>(by * kSadBlockWidth + row) * plane_width_;
+                sad_row_(current_.data() + offset, previous_.data() + offset,
+                         blocks_x_, block_sad_.data());
+            }
+            for (uint32_t sad : block_sad_) {
+                if (sad > kBlockDiffThreshold * kBlockPixels) {
+                    changed_blocks_++;
+                }
+            }
+        }
+    }
+
+    std::swap(current_, previous_);
+    has_previous_ = true;
+    return changed_blocks_ > 0;
+}
+
+} // namespace video_bench
@@ -0,0 +1,73 @@
+#ifndef MOTION_DETECTOR_HPP
+#define MOTION_DETECTOR_HPP
+
+#include "pipeline/simd_kernels.hpp"
+#include "utils/latency_stats.hpp"
+#include <vector>
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace video_bench {
+
+// Motion detection statistics (per stream, merged per test)
+struct MotionCounters {
+    int64_t frames_analyzed = 0;
+    int64_t motion_frames = 0;     // Frames with at least one changed block
+    LatencyRecorder cost;          // Per-frame processing time in ms
+
+    void merge(const MotionCounters& other) {
+        frames_analyzed += other.frames_analyzed;
+        motion_frames += other.motion_frames;
+        cost.merge(other.cost);
+    }
+};
+
+// Pixel-difference motion detector on a downsampled luma plane
+// Point-samples luma every `downsample` pixels, then compares 16x16 blocks
+// of the downsampled plane against the previous analyzed frame using SAD.
+class MotionDetector {
+public:
+    explicit MotionDetector(int downsample);
+
+    // Analyze one decoded frame; returns true if motion was detected
+    // The first frame (or a geometry change) only primes the reference plane
+    bool process(const AVFrame* frame);
+
+    // Number of changed blocks in the last processed frame
+    int getChangedBlocks() const { return changed_blocks_; }
+
+private:
+    // Resize planes and block accumulators for a new frame geometry
+    void configure(const AVFrame* frame);
+
+    // Point-sample the luma plane into current_
+    void downsampleLuma(const AVFrame* frame);
+
+    int downsample_;
+    SadRowFn sad_row_;
+
+    int src_width_ = 0;
+    int src_height_ = 0;
+    int src_format_ = -1;
+    int luma_bytes_ = 1;   // 2 for >8-bit formats
+    int luma_shift_ = 0;   // Right shift from a 16-bit sample to 8 bits
+    bool luma_big_endian_ = false;
+
+    int plane_width_ = 0;  // Downsampled width, multiple of kSadBlockWidth
+    int plane_height_ = 0; // Downsampled height, multiple of kSadBlockWidth
+    int blocks_x_ = 0;
+    int blocks_y_ = 0;
+
+    std::vector<uint8_t> current_;
+    std::vector<uint8_t> previous_;
+    std::vector<uint32_t> block_sad_;
+    bool has_previous_ = false;
+    int changed_blocks_ = 0;
+};
+
+} // namespace video_bench
+
+#endif // MOTION_DETECTOR_HPP
@@ -0,0 +1,391 @@
+#include "pipeline/segment_recorder.hpp"
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace video_bench {
+
+namespace {
+// O_DIRECT transfers must be aligned to the logical block size
+constexpr size_t kDirectBlockSize = 4096;
+constexpr size_t kDirectBufferSize = 1 << 20;
+constexpr int kIoBufferSize = 64 * 1024;
+// Newest segments kept per stream; older ones are deleted (rolling)
+constexpr size_t kKeptSegments = 3;
+
+// FFmpeg 7 made the write callback's buffer const
+#if LIBAVFORMAT_VERSION_MAJOR >= 61
+using WriteBuffer = const uint8_t*;
+#else
+using WriteBuffer = uint8_t*;
+#endif
+
+int writePacket(void* opaque, WriteBuffer data, int size) {
+    auto* recorder = static_cast<SegmentRecorder*>(opaque);
+    return recorder->writeBytes(data, static_cast<size_t>(size)) ? size : AVERROR(EIO);
+}
+
+int64_t packetStartTime(const AVPacket* packet) {
+    if (packet->dts != AV_NOPTS_VALUE) {
+        return packet->dts;
+    }
+    return packet->pts != AV_NOPTS_VALUE ? packet->pts : 0;
+}
+} // namespace
+
+std::optional<FsyncPolicy> parseFsyncPolicy(const std::string& name) {
+    if (name == "none") {
+        return FsyncPolicy::None;
+    }
+    if (name == "segment") {
+        return FsyncPolicy::Segment;
+    }
+    if (name == "keyframe") {
+        return FsyncPolicy::Keyframe;
+    }
+    return std::nullopt;
+}
+
+std::string fsyncPolicyName(FsyncPolicy policy) {
+    switch (policy) {
+        case FsyncPolicy::None: return "none";
+        case FsyncPolicy::Segment: return "segment";
+        case FsyncPolicy::Keyframe: return "keyframe";
+    }
+    return "none";
+}
+
+SegmentRecorder::SegmentRecorder(const SegmentRecorderOptions& options, int stream_id)
+    : options_(options)
+    , stream_id_(stream_id)
+    , packet_(av_packet_alloc()) {
+}
+
+SegmentRecorder::~SegmentRecorder() {
+    releaseSegment();
+    avcodec_parameters_free(&codec_params_);
+    std::free(direct_buffer_);
+}
+
+bool SegmentRecorder::onStreamStart(const AVCodecParameters* codec_params, AVRational time_base,
+                                    std::string& error_message) {
+    codec_params_ = avcodec_parameters_alloc();
+    if (!packet_ || !codec_params_ ||
+        avcodec_parameters_copy(codec_params_, codec_params) < 0) {
+        error_message = "Recorder: failed to allocate stream parameters";
+        return false;
+    }
+    time_base_ = time_base;
+
+    if (options_.direct_io) {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, kDirectBlockSize, kDirectBufferSize) != 0) {
+            error_message = "Recorder: failed to allocate direct I/O buffer";
+            return false;
+        }
+        direct_buffer_ = static_cast<uint8_t*>(buffer);
+    }
+    return true;
+}
+
+void SegmentRecorder::onPacket(const AVPacket* packet) {
+    if (!error_message_.empty() || !codec_params_) {
+        return;
+    }
+    // Errors can come from inside the muxer's write callback; the muxer is
+    // only freed once it has returned
+    if (!recordPacket(packet)) {
+        releaseSegment();
+    }
+}
+
+bool SegmentRecorder::recordPacket(const AVPacket* packet) {
+    const bool keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+    if (!mux_ctx_) {
+        // Segments must start decodable
+        if (!keyframe) {
+            return true;
+        }
+        if (!openSegment(packet)) {
+            return false;
+        }
+    } else if (keyframe) {
+        double segment_seconds = static_cast<double>(
+            packetStartTime(packet) - segment_start_dts_) * av_q2d(time_base_);
+        if (segment_seconds >= options_.segment_seconds) {
+            if (!closeSegment() || !openSegment(packet)) {
+                return false;
+            }
+        } else if (options_.fsync == FsyncPolicy::Keyframe) {
+            // The previous GOP is complete, but the muxer still buffers it
+            // (the open MP4 fragment or Matroska cluster): flush that first
+            int ret = av_write_frame(mux_ctx_, nullptr);
+            if (ret < 0) {
+                fail("failed to flush muxer: " + ffmpegErrorString(ret));
+                return false;
+            }
+            avio_flush(io_ctx_);
+            if (!error_message_.empty() || !syncFile()) {
+                return false;
+            }
+        }
+    }
+
+    if (av_packet_ref(packet_.get(), packet) < 0) {
+        fail("failed to reference packet");
+        return false;
+    }
+    // Each segment starts at timestamp 0
+    if (packet_->pts != AV_NOPTS_VALUE) {
+        packet_->pts -= segment_start_dts_;
+    }
+    if (packet_->dts != AV_NOPTS_VALUE) {
+        packet_->dts -= segment_start_dts_;
+    }
+    packet_->stream_index = 0;
+    av_packet_rescale_ts(packet_.get(), time_base_, mux_ctx_->streams[0]->time_base);
+    int ret = av_write_frame(mux_ctx_, packet_.get());
+    av_packet_unref(packet_.get());
+    if (ret < 0) {
+        fail("failed to write packet: " + ffmpegErrorString(ret));
+        return false;
+    }
+    counters_.packets++;
+    return true;
+}
+
+void SegmentRecorder::onDiscontinuity() {
+    // Timestamps restart; the next segment starts at the next keyframe
+    if (mux_ctx_ && error_message_.empty() && !closeSegment()) {
+        releaseSegment();
+    }
+}
+
+void SegmentRecorder::close() {
+    if (mux_ctx_ && error_message_.empty()) {
+        closeSegment();
+    }
+    releaseSegment();
+}
+
+bool SegmentRecorder::openSegment(const AVPacket* first_packet) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "stream%03d-%06lld.%s", stream_id_,
+                  static_cast<long long>(next_segment_index_++), options_.format.c_str());
+    path_ = (std::filesystem::path(options_.directory) / name).string();
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    if (options_.direct_io) {
+        flags |= O_DIRECT;
+    }
+    fd_ = ::open(path_.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        if (options_.direct_io && errno == EINVAL) {
+            fail("the filesystem of " + options_.directory + " does not support O_DIRECT");
+        } else {
+            fail("cannot create " + path_ + ": " + std::strerror(errno));
+        }
+        return false;
+    }
+    file_offset_ = 0;
+    logical_size_ = 0;
+    direct_fill_ = 0;
+
+    const char* format_name = options_.format == "mkv" ? "matroska" : "mp4";
+    if (avformat_alloc_output_context2(&mux_ctx_, nullptr, format_name, nullptr) < 0 || !mux_ctx_) {
+        fail(std::string("muxer not available: ") + format_name);
+        return false;
+    }
+    AVStream* stream = avformat_new_stream(mux_ctx_, nullptr);
+    if (!stream || avcodec_parameters_copy(stream->codecpar, codec_params_) < 0) {
+        fail("failed to create output stream");
+        return false;
+    }
+    stream->codecpar->codec_tag = 0;
+    stream->time_base = time_base_;
+
+    auto* io_buffer = static_cast<unsigned char*>(av_malloc(kIoBufferSize));
+    if (io_buffer) {
+        io_ctx_ = avio_alloc_context(io_buffer, kIoBufferSize, 1, this, nullptr,
+                                     writePacket, nullptr);
+    }
+    if (!io_ctx_) {
+        av_free(io_buffer);
+        fail("failed to allocate output context");
+        return false;
+    }
+    mux_ctx_->pb = io_ctx_;
+    mux_ctx_->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+    // Non-seekable output: MP4 needs fragments, not a moov written at the end
+    AVDictionary* mux_options = nullptr;
+    if (options_.format == "mp4") {
+        av_dict_set(&mux_options, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0);
+    }
+    int ret = avformat_write_header(mux_ctx_, &mux_options);
+    av_dict_free(&mux_options);
+    if (ret < 0) {
+        fail("failed to write " + options_.format + " header: " + ffmpegErrorString(ret));
+        return false;
+    }
+
+    segment_start_dts_ = packetStartTime(first_packet);
+    return true;
+}
+
+bool SegmentRecorder::closeSegment() {
+    int ret = av_write_trailer(mux_ctx_);
+    if (ret < 0) {
+        fail("failed to finish " + path_ + ": " + ffmpegErrorString(ret));
+        return false;
+    }
+    avio_flush(io_ctx_);
+    if (!error_message_.empty()) {
+        return false;
+    }
+
+    if (options_.direct_io) {
+        // The last block is padded on disk; cut the file back to its size
+        if (!flushDirect(true)) {
+            return false;
+        }
+        if (ftruncate(fd_, logical_size_) != 0) {
+            fail("ftruncate failed on " + path_ + ": " + std::strerror(errno));
+            return false;
+        }
+    }
+    if (options_.fsync != FsyncPolicy::None && !syncFile()) {
+        return false;
+    }
+    releaseSegment();
+    counters_.segments++;
+
+    kept_segments_.push_back(path_);
+    while (kept_segments_.size() > kKeptSegments) {
+        ::unlink(kept_segments_.front().c_str());
+        kept_segments_.pop_front();
+    }
+    return true;
+}
+
+void SegmentRecorder::releaseSegment() {
+    if (io_ctx_) {
+        av_freep(&io_ctx_->buffer);
+        avio_context_free(&io_ctx_);
+    }
+    if (mux_ctx_) {
+        avformat_free_context(mux_ctx_);
+        mux_ctx_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool SegmentRecorder::syncFile() {
+    if (options_.direct_io && !flushDirect(false)) {
+        return false;
+    }
+    // fdatasync: data and the file size, not timestamps
+    auto sync_start = std::chrono::steady_clock::now();
+    if (fdatasync(fd_) != 0) {
+        fail("fdatasync failed on " + path_ + ": " + std::strerror(errno));
+        return false;
+    }
+    counters_.fsync.add(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - sync_start).count());
+    return true;
+}
+
+bool SegmentRecorder::writeBytes(const uint8_t* data, size_t size) {
+    if (fd_ < 0) {
+        return false;
+    }
+    logical_size_ += static_cast<int64_t>(size);
+    counters_.bytes_written += static_cast<int64_t>(size);
+    if (options_.window && options_.window->contains(MeasurementWindow::nowNs())) {
+        counters_.window_bytes_written += static_cast<int64_t>(size);
+    }
+    if (!options_.direct_io) {
+        return writeAll(data, size);
+    }
+
+    while (size > 0) {
+        size_t chunk = std::min(size, kDirectBufferSize - direct_fill_);
+        std::memcpy(direct_buffer_ + direct_fill_, data, chunk);
+        direct_fill_ += chunk;
+        data += chunk;
+        size -= chunk;
+        if (direct_fill_ == kDirectBufferSize && !flushDirect(false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SegmentRecorder::writeAll(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd_, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail("write failed on " + path_ + ": " + std::strerror(errno));
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool SegmentRecorder::flushDirect(bool final_block) {
+    // Whole blocks only; the final flush pads the tail with zeros
+    size_t length = final_block
+        ? (direct_fill_ + kDirectBlockSize - 1) / kDirectBlockSize * kDirectBlockSize
+        : direct_fill_ / kDirectBlockSize * kDirectBlockSize;
+    if (length == 0) {
+        return true;
+    }
+    if (length > direct_fill_) {
+        std::memset(direct_buffer_ + direct_fill_, 0, length - direct_fill_);
+    }
+
+    size_t done = 0;
+    while (done < length) {
+        ssize_t written = ::pwrite(fd_, direct_buffer_ + done, length - done,
+                                   file_offset_ + static_cast<off_t>(done));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0 || (static_cast<size_t>(written) % kDirectBlockSize) != 0) {
+            fail("direct write failed on " + path_ + ": " +
+                 (written < 0 ? std::strerror(errno) : "short write"));
+            return false;
+        }
+        done += static_cast<size_t>(written);
+    }
+    file_offset_ += static_cast<int64_t>(length);
+
+    // Keep the partial block staged at the start of the buffer
+    const size_t remainder = direct_fill_ > length ? direct_fill_ - length : 0;
+    if (remainder > 0) {
+        std::memmove(direct_buffer_, direct_buffer_ + length, remainder);
+    }
+    direct_fill_ = remainder;
+    return true;
+}
+
+void SegmentRecorder::fail(const std::string& message) {
+    if (error_message_.empty()) {
+        error_message_ = "Recorder: stream " + std::to_string(stream_id_) + ": " + message;
+    }
+}
+
+} // namespace video_bench
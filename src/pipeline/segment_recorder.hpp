@@ -0,0 +1,127 @@
+#ifndef SEGMENT_RECORDER_HPP
+#define SEGMENT_RECORDER_HPP
+
+#include "decoder/measurement_window.hpp"
+#include "decoder/packet_observer.hpp"
+#include "utils/ffmpeg_utils.hpp"
+#include "utils/latency_stats.hpp"
+#include <string>
+#include <deque>
+#include <optional>
+#include <cstdint>
+
+namespace video_bench {
+
+// When recorded data is forced to disk
+enum class FsyncPolicy {
+    None,      // Never: the page cache decides (data loss window unbounded)
+    Segment,   // When a segment is closed
+    Keyframe   // At every keyframe, i.e. once per GOP
+};
+
+std::optional<FsyncPolicy> parseFsyncPolicy(const std::string& name);
+std::string fsyncPolicyName(FsyncPolicy policy);
+
+struct SegmentRecorderOptions {
+    std::string directory;
+    std::string format = "mp4";      // "mp4" (fragmented) or "mkv"
+    double segment_seconds = 60.0;   // Cut at the first keyframe after this
+    FsyncPolicy fsync = FsyncPolicy::Segment;
+    bool direct_io = false;          // O_DIRECT: bypass the page cache
+    const MeasurementWindow* window = nullptr;  // nullptr counts no window bytes
+};
+
+// Recording statistics of one stream (or merged per test)
+struct RecorderCounters {
+    int64_t bytes_written = 0;
+    int64_t window_bytes_written = 0;  // Inside the measurement window
+    int64_t packets = 0;
+    int64_t segments = 0;          // Segments closed
+    LatencyRecorder fsync;         // Duration of each fsync()
+
+    void merge(const RecorderCounters& other) {
+        bytes_written += other.bytes_written;
+        window_bytes_written += other.window_bytes_written;
+        packets += other.packets;
+        segments += other.segments;
+        fsync.merge(other.fsync);
+    }
+};
+
+// NVR-style recorder (Linux): remuxes a stream's packets, without
+// re-encoding, into rolling segment files on the reader thread. Segments
+// start on a keyframe; a file loop closes the segment (timestamps restart).
+// The muxer writes through its own non-seekable I/O callbacks into a file
+// descriptor, so every byte, write() and fsync() is accounted here; MP4 is
+// therefore fragmented (empty moov, one fragment per keyframe). With
+// direct_io, writes go through an aligned buffer in whole blocks and the
+// file is truncated to its real size on close. Only the newest few
+// segments per stream are kept on disk.
+class SegmentRecorder : public PacketObserver {
+public:
+    SegmentRecorder(const SegmentRecorderOptions& options, int stream_id);
+    ~SegmentRecorder() override;
+
+    // Non-copyable, non-movable (owns a muxer and a file)
+    SegmentRecorder(const SegmentRecorder&) = delete;
+    SegmentRecorder& operator=(const SegmentRecorder&) = delete;
+    SegmentRecorder(SegmentRecorder&&) = delete;
+    SegmentRecorder& operator=(SegmentRecorder&&) = delete;
+
+    // PacketObserver (reader thread)
+    bool onStreamStart(const AVCodecParameters* codec_params, AVRational time_base,
+                       std::string& error_message) override;
+    void onPacket(const AVPacket* packet) override;
+    void onDiscontinuity() override;
+
+    // Finish the open segment (after the reader thread has stopped)
+    void close();
+
+    // Valid after close()
+    const RecorderCounters& getCounters() const { return counters_; }
+    std::string getError() const { return error_message_; }
+
+    // Muxer output, from the segment's AVIOContext write callback
+    bool writeBytes(const uint8_t* data, size_t size);
+
+private:
+    // Write one packet, cutting segments at keyframes; false on error
+    bool recordPacket(const AVPacket* packet);
+    bool openSegment(const AVPacket* first_packet);
+    bool closeSegment();
+    void releaseSegment();
+    bool syncFile();
+
+    bool writeAll(const uint8_t* data, size_t size);
+    bool flushDirect(bool final_block);
+
+    void fail(const std::string& message);
+
+    SegmentRecorderOptions options_;
+    int stream_id_;
+    AVCodecParameters* codec_params_ = nullptr;
+    AVRational time_base_{1, 90000};
+
+    // Open segment
+    AVFormatContext* mux_ctx_ = nullptr;
+    AVIOContext* io_ctx_ = nullptr;
+    int fd_ = -1;
+    std::string path_;
+    int64_t segment_start_dts_ = 0;
+    int64_t file_offset_ = 0;   // Direct I/O: bytes already on disk (block aligned)
+    int64_t logical_size_ = 0;  // Bytes the muxer produced for this segment
+
+    // Direct I/O staging buffer (block aligned)
+    uint8_t* direct_buffer_ = nullptr;
+    size_t direct_fill_ = 0;
+
+    UniqueAVPacket packet_;
+    int64_t next_segment_index_ = 0;
+    std::deque<std::string> kept_segments_;
+    RecorderCounters counters_;
+    std::string error_message_;  // First error; recording stops after it
+};
+
+} // namespace video_bench
+
+#endif // SEGMENT_RECORDER_HPP
@@ -0,0 +1,465 @@
+#include "pipeline/simd_kernels.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define VIDEO_BENCH_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define VIDEO_BENCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace video_bench {
+
+const uint64_t kHashLaneKeys[4] = {
+    0x9e3779b185ebca87ULL, 0xc2b2ae3d27d4eb4fULL,
+    0x165667b19e3779f9ULL, 0x85ebca77c2b2ae63ULL,
+};
+
+namespace {
+
+struct SadKernel {
+    SadRowFn fn;
+    const char* name;
+};
+
+[[maybe_unused]] void sadRowScalar(const uint8_t* a, const uint8_t* b, int blocks, uint32_t* acc) {
+    for (int j = 0; j < blocks; j++) {
+        uint32_t sum = 0;
+        for (int i = 0; i < kSadBlockWidth; i++) {
+            sum += static_cast<uint32_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+        }
+        acc[j] += sum;
+        a += kSadBlockWidth;
+        b += kSadBlockWidth;
+    }
+}
+
+#if defined(VIDEO_BENCH_X86)
+void sadRowSse2(const uint8_t* a, const uint8_t* b, int blocks, uint32_t* acc) {
+    for (int j = 0; j < blocks; j++) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+        // psadbw yields two 64-bit partial sums (low and high 8 bytes)
+        __m128i sad = _mm_sad_epu8(va, vb);
+        acc[j] += static_cast<uint32_t>(_mm_cvtsi128_si32(sad) +
+                                        _mm_cvtsi128_si32(_mm_srli_si128(sad, 8)));
+        a += kSadBlockWidth;
+        b += kSadBlockWidth;
+    }
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+void sadRowAvx2(const uint8_t* a, const uint8_t* b, int blocks, uint32_t* acc) {
+    int j = 0;
+    // Two blocks per 256-bit load: lanes 0-1 belong to block j, lanes 2-3 to j+1
+    for (; j + 2 <= blocks; j += 2) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        __m256i sad = _mm256_sad_epu8(va, vb);
+        __m128i lo = _mm256_castsi256_si128(sad);
+        __m128i hi = _mm256_extracti128_si256(sad, 1);
+        acc[j] += static_cast<uint32_t>(_mm_cvtsi128_si32(lo) +
+                                        _mm_cvtsi128_si32(_mm_srli_si128(lo, 8)));
+        acc[j + 1] += static_cast<uint32_t>(_mm_cvtsi128_si32(hi) +
+                                            _mm_cvtsi128_si32(_mm_srli_si128(hi, 8)));
+        a += 2 * kSadBlockWidth;
+        b += 2 * kSadBlockWidth;
+    }
+    if (j < blocks) {
+        sadRowSse2(a, b, blocks - j, acc + j);
+    }
+}
+#endif // __GNUC__
+#endif // VIDEO_BENCH_X86
+
+#if defined(VIDEO_BENCH_NEON)
+void sadRowNeon(const uint8_t* a, const uint8_t* b, int blocks, uint32_t* acc) {
+    for (int j = 0; j < blocks; j++) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8(a), vld1q_u8(b));
+        acc[j] += vaddlvq_u8(diff);
+        a += kSadBlockWidth;
+        b += kSadBlockWidth;
+    }
+}
+#endif // VIDEO_BENCH_NEON
+
+struct HashKernel {
+    HashStripesFn fn;
+    const char* name;
+};
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+[[maybe_unused]] void hashStripesScalar(uint64_t* acc, const uint8_t* data, size_t stripes) {
+    for (size_t s = 0; s < stripes; s++) {
+        for (int lane = 0; lane < 4; lane++) {
+            uint64_t d = load64(data + lane * 8);
+            uint64_t dk = d ^ kHashLaneKeys[lane];
+            acc[lane] += (dk & 0xffffffffULL) * (dk >> 32) + d;
+        }
+        data += kHashStripeBytes;
+    }
+}
+
+#if defined(VIDEO_BENCH_X86)
+void hashStripesSse2(uint64_t* acc, const uint8_t* data, size_t stripes) {
+    __m128i acc0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc));
+    __m128i acc1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2));
+    const __m128i key0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHashLaneKeys));
+    const __m128i key1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHashLaneKeys + 2));
+
+    for (size_t s = 0; s < stripes; s++) {
+        __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        __m128i dk0 = _mm_xor_si128(d0, key0);
+        __m128i dk1 = _mm_xor_si128(d1, key1);
+        // pmuludq multiplies the low 32 bits of each 64-bit lane
+        __m128i p0 = _mm_mul_epu32(dk0, _mm_srli_epi64(dk0, 32));
+        __m128i p1 = _mm_mul_epu32(dk1, _mm_srli_epi64(dk1, 32));
+        acc0 = _mm_add_epi64(acc0, _mm_add_epi64(p0, d0));
+        acc1 = _mm_add_epi64(acc1, _mm_add_epi64(p1, d1));
+        data += kHashStripeBytes;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), acc0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2), acc1);
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+void hashStripesAvx2(uint64_t* acc, const uint8_t* data, size_t stripes) {
+    __m256i vacc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+    const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kHashLaneKeys));
+
+    for (size_t s = 0; s < stripes; s++) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i dk = _mm256_xor_si256(d, key);
+        __m256i prod = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+        vacc = _mm256_add_epi64(vacc, _mm256_add_epi64(prod, d));
+        data += kHashStripeBytes;
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), vacc);
+}
+#endif // __GNUC__
+#endif // VIDEO_BENCH_X86
+
+#if defined(VIDEO_BENCH_NEON)
+void hashStripesNeon(uint64_t* acc, const uint8_t* data, size_t stripes) {
+    uint64x2_t acc0 = vld1q_u64(acc);
+    uint64x2_t acc1 = vld1q_u64(acc + 2);
+    const uint64x2_t key0 = vld1q_u64(kHashLaneKeys);
+    const uint64x2_t key1 = vld1q_u64(kHashLaneKeys + 2);
+
+    for (size_t s = 0; s < stripes; s++) {
+        uint64x2_t d0 = vreinterpretq_u64_u8(vld1q_u8(data));
+        uint64x2_t d1 = vreinterpretq_u64_u8(vld1q_u8(data + 16));
+        uint64x2_t dk0 = veorq_u64(d0, key0);
+        uint64x2_t dk1 = veorq_u64(d1, key1);
+        // vmlal: acc += lo32 * hi32 as 64-bit products
+        acc0 = vmlal_u32(vaddq_u64(acc0, d0), vmovn_u64(dk0), vshrn_n_u64(dk0, 32));
+        acc1 = vmlal_u32(vaddq_u64(acc1, d1), vmovn_u64(dk1), vshrn_n_u64(dk1, 32));
+        data += kHashStripeBytes;
+    }
+
+    vst1q_u64(acc, acc0);
+    vst1q_u64(acc + 2, acc1);
+}
+#endif // VIDEO_BENCH_NEON
+
+// BT.601 limited-range coefficients
+constexpr float kLumaScale = 1.164f;
+constexpr float kVToR = 1.596f;
+constexpr float kUToG = 0.392f;
+constexpr float kVToG = 0.813f;
+constexpr float kUToB = 2.017f;
+
+struct YuvKernel {
+    YuvRowToRgbFn fn;
+    const char* name;
+};
+
+// Scalar conversion of pixels [start, width), also used for SIMD row tails
+void yuvRowToRgbTail(const uint8_t* y, const uint8_t* u, const uint8_t* v, int start,
+                     int width, const RgbNormalize& norm, float* r, float* g, float* b) {
+    for (int x = start; x < width; x++) {
+        float yf = (static_cast<float>(y[x]) - 16.0f) * kLumaScale;
+        float uf = static_cast<float>(u[x / 2]) - 128.0f;
+        float vf = static_cast<float>(v[x / 2]) - 128.0f;
+        float rgb[3] = {
+            yf + kVToR * vf,
+            yf - kUToG * uf - kVToG * vf,
+            yf + kUToB * uf,
+        };
+        float* out[3] = {r, g, b};
+        for (int c = 0; c < 3; c++) {
+            float value = std::min(std::max(rgb[c], 0.0f), 255.0f);
+            out[c][x] = value * norm.scale[c] + norm.bias[c];
+        }
+    }
+}
+
+[[maybe_unused]] void yuvRowToRgbScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                                        int width, const RgbNormalize& norm,
+                                        float* r, float* g, float* b) {
+    yuvRowToRgbTail(y, u, v, 0, width, norm, r, g, b);
+}
+
+#if defined(VIDEO_BENCH_X86)
+// Convert 4 pixels already widened to float
+inline void yuvToRgb4Sse2(__m128 yf, __m128 uf, __m128 vf, const RgbNormalize& norm,
+                          float* r, float* g, float* b) {
+    const __m128 lo = _mm_setzero_ps();
+    const __m128 hi = _mm_set1_ps(255.0f);
+    yf = _mm_mul_ps(_mm_sub_ps(yf, _mm_set1_ps(16.0f)), _mm_set1_ps(kLumaScale));
+    uf = _mm_sub_ps(uf, _mm_set1_ps(128.0f));
+    vf = _mm_sub_ps(vf, _mm_set1_ps(128.0f));
+
+    __m128 rf = _mm_add_ps(yf, _mm_mul_ps(vf, _mm_set1_ps(kVToR)));
+    __m128 gf = _mm_sub_ps(_mm_sub_ps(yf, _mm_mul_ps(uf, _mm_set1_ps(kUToG))),
+                           _mm_mul_ps(vf, _mm_set1_ps(kVToG)));
+    __m128 bf = _mm_add_ps(yf, _mm_mul_ps(uf, _mm_set1_ps(kUToB)));
+
+    rf = _mm_min_ps(_mm_max_ps(rf, lo), hi);
+    gf = _mm_min_ps(_mm_max_ps(gf, lo), hi);
+    bf = _mm_min_ps(_mm_max_ps(bf, lo), hi);
+    _mm_storeu_ps(r, _mm_add_ps(_mm_mul_ps(rf, _mm_set1_ps(norm.scale[0])), _mm_set1_ps(norm.bias[0])));
+    _mm_storeu_ps(g, _mm_add_ps(_mm_mul_ps(gf, _mm_set1_ps(norm.scale[1])), _mm_set1_ps(norm.bias[1])));
+    _mm_storeu_ps(b, _mm_add_ps(_mm_mul_ps(bf, _mm_set1_ps(norm.scale[2])), _mm_set1_ps(norm.bias[2])));
+}
+
+void yuvRowToRgbSse2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                     int width, const RgbNormalize& norm, float* r, float* g, float* b) {
+    const __m128i zero = _mm_setzero_si128();
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        int32_t u4;
+        int32_t v4;
+        std::memcpy(&u4, u + x / 2, sizeof(u4));
+        std::memcpy(&v4, v + x / 2, sizeof(v4));
+        // Duplicate each chroma sample for its two luma columns
+        __m128i u8 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), _mm_cvtsi32_si128(u4));
+        __m128i v8 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v4), _mm_cvtsi32_si128(v4));
+        __m128i y16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + x)), zero);
+        __m128i u16 = _mm_unpacklo_epi8(u8, zero);
+        __m128i v16 = _mm_unpacklo_epi8(v8, zero);
+
+        yuvToRgb4Sse2(_mm_cvtepi32_ps(_mm_unpacklo_epi16(y16, zero)),
+                      _mm_cvtepi32_ps(_mm_unpacklo_epi16(u16, zero)),
+                      _mm_cvtepi32_ps(_mm_unpacklo_epi16(v16, zero)),
+                      norm, r + x, g + x, b + x);
+        yuvToRgb4Sse2(_mm_cvtepi32_ps(_mm_unpackhi_epi16(y16, zero)),
+                      _mm_cvtepi32_ps(_mm_unpackhi_epi16(u16, zero)),
+                      _mm_cvtepi32_ps(_mm_unpackhi_epi16(v16, zero)),
+                      norm, r + x + 4, g + x + 4, b + x + 4);
+    }
+    yuvRowToRgbTail(y, u, v, x, width, norm, r, g, b);
+}
+
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+inline void yuvToRgb8Avx2(__m256 yf, __m256 uf, __m256 vf, const RgbNormalize& norm,
+                          float* r, float* g, float* b) {
+    const __m256 lo = _mm256_setzero_ps();
+    const __m256 hi = _mm256_set1_ps(255.0f);
+    yf = _mm256_mul_ps(_mm256_sub_ps(yf, _mm256_set1_ps(16.0f)), _mm256_set1_ps(kLumaScale));
+    uf = _mm256_sub_ps(uf, _mm256_set1_ps(128.0f));
+    vf = _mm256_sub_ps(vf, _mm256_set1_ps(128.0f));
+
+    __m256 rf = _mm256_add_ps(yf, _mm256_mul_ps(vf, _mm256_set1_ps(kVToR)));
+    __m256 gf = _mm256_sub_ps(_mm256_sub_ps(yf, _mm256_mul_ps(uf, _mm256_set1_ps(kUToG))),
+                              _mm256_mul_ps(vf, _mm256_set1_ps(kVToG)));
+    __m256 bf = _mm256_add_ps(yf, _mm256_mul_ps(uf, _mm256_set1_ps(kUToB)));
+
+    rf = _mm256_min_ps(_mm256_max_ps(rf, lo), hi);
+    gf = _mm256_min_ps(_mm256_max_ps(gf, lo), hi);
+    bf = _mm256_min_ps(_mm256_max_ps(bf, lo), hi);
+    _mm256_storeu_ps(r, _mm256_add_ps(_mm256_mul_ps(rf, _mm256_set1_ps(norm.scale[0])),
+                                      _mm256_set1_ps(norm.bias[0])));
+    _mm256_storeu_ps(g, _mm256_add_ps(_mm256_mul_ps(gf, _mm256_set1_ps(norm.scale[1])),
+                                      _mm256_set1_ps(norm.bias[1])));
+    _mm256_storeu_ps(b, _mm256_add_ps(_mm256_mul_ps(bf, _mm256_set1_ps(norm.scale[2])),
+                                      _mm256_set1_ps(norm.bias[2])));
+}
+
+__attribute__((target("avx2")))
+void yuvRowToRgbAvx2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                     int width, const RgbNormalize& norm, float* r, float* g, float* b) {
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i y16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+        __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+        __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+        // Duplicate each chroma sample for its two luma columns
+        __m128i u16 = _mm_unpacklo_epi8(u8, u8);
+        __m128i v16 = _mm_unpacklo_epi8(v8, v8);
+
+        for (int half = 0; half < 2; half++) {
+            // cvtepu8 widens the low 8 bytes
+            __m256 yf = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(y16));
+            __m256 uf = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(u16));
+            __m256 vf = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v16));
+            int offset = x + half * 8;
+            yuvToRgb8Avx2(yf, uf, vf, norm, r + offset, g + offset, b + offset);
+            y16 = _mm_srli_si128(y16, 8);
+            u16 = _mm_srli_si128(u16, 8);
+            v16 = _mm_srli_si128(v16, 8);
+        }
+    }
+    yuvRowToRgbTail(y, u, v, x, width, norm, r, g, b);
+}
+#endif // __GNUC__
+#endif // VIDEO_BENCH_X86
+
+#if defined(VIDEO_BENCH_NEON)
+// Convert 4 pixels already widened to float
+inline void yuvToRgb4Neon(float32x4_t yf, float32x4_t uf, float32x4_t vf,
+                          const RgbNormalize& norm, float* r, float* g, float* b) {
+    const float32x4_t lo = vdupq_n_f32(0.0f);
+    const float32x4_t hi = vdupq_n_f32(255.0f);
+    yf = vmulq_n_f32(vsubq_f32(yf, vdupq_n_f32(16.0f)), kLumaScale);
+    uf = vsubq_f32(uf, vdupq_n_f32(128.0f));
+    vf = vsubq_f32(vf, vdupq_n_f32(128.0f));
+
+    float32x4_t rf = vmlaq_n_f32(yf, vf, kVToR);
+    float32x4_t gf = vmlsq_n_f32(vmlsq_n_f32(yf, uf, kUToG), vf, kVToG);
+    float32x4_t bf = vmlaq_n_f32(yf, uf, kUToB);
+
+    rf = vminq_f32(vmaxq_f32(rf, lo), hi);
+    gf = vminq_f32(vmaxq_f32(gf, lo), hi);
+    bf = vminq_f32(vmaxq_f32(bf, lo), hi);
+    vst1q_f32(r, vmlaq_n_f32(vdupq_n_f32(norm.bias[0]), rf, norm.scale[0]));
+    vst1q_f32(g, vmlaq_n_f32(vdupq_n_f32(norm.bias[1]), gf, norm.scale[1]));
+    vst1q_f32(b, vmlaq_n_f32(vdupq_n_f32(norm.bias[2]), bf, norm.scale[2]));
+}
+
+inline float32x4_t widenNeon(uint16x4_t v) {
+    return vcvtq_f32_u32(vmovl_u16(v));
+}
+
+void yuvRowToRgbNeon(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                     int width, const RgbNormalize& norm, float* r, float* g, float* b) {
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t y8 = vld1q_u8(y + x);
+        uint8x8_t u8 = vld1_u8(u + x / 2);
+        uint8x8_t v8 = vld1_u8(v + x / 2);
+        // Duplicate each chroma sample for its two luma columns
+        uint8x8x2_t uu = vzip_u8(u8, u8);
+        uint8x8x2_t vv = vzip_u8(v8, v8);
+
+        uint16x8_t y16[2] = {vmovl_u8(vget_low_u8(y8)), vmovl_u8(vget_high_u8(y8))};
+        uint16x8_t u16[2] = {vmovl_u8(uu.val[0]), vmovl_u8(uu.val[1])};
+        uint16x8_t v16[2] = {vmovl_u8(vv.val[0]), vmovl_u8(vv.val[1])};
+        for (int half = 0; half < 2; half++) {
+            int offset = x + half * 8;
+            yuvToRgb4Neon(widenNeon(vget_low_u16(y16[half])), widenNeon(vget_low_u16(u16[half])),
+                          widenNeon(vget_low_u16(v16[half])), norm,
+                          r + offset, g + offset, b + offset);
+            yuvToRgb4Neon(widenNeon(vget_high_u16(y16[half])), widenNeon(vget_high_u16(u16[half])),
+                          widenNeon(vget_high_u16(v16[half])), norm,
+                          r + offset + 4, g + offset + 4, b + offset + 4);
+        }
+    }
+    yuvRowToRgbTail(y, u, v, x, width, norm, r, g, b);
+}
+#endif // VIDEO_BENCH_NEON
+
+HashKernel selectHashKernel() {
+#if defined(VIDEO_BENCH_X86)
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {hashStripesAvx2, "avx2"};
+    }
+#endif
+    return {hashStripesSse2, "sse2"};
+#elif defined(VIDEO_BENCH_NEON)
+    return {hashStripesNeon, "neon"};
+#else
+    return {hashStripesScalar, "scalar"};
+#endif
+}
+
+const HashKernel& hashKernel() {
+    static const HashKernel kernel = selectHashKernel();
+    return kernel;
+}
+
+SadKernel selectSadKernel() {
+#if defined(VIDEO_BENCH_X86)
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {sadRowAvx2, "avx2"};
+    }
+#endif
+    return {sadRowSse2, "sse2"};
+#elif defined(VIDEO_BENCH_NEON)
+    return {sadRowNeon, "neon"};
+#else
+    return {sadRowScalar, "scalar"};
+#endif
+}
+
+const SadKernel& sadKernel() {
+    static const SadKernel kernel = selectSadKernel();
+    return kernel;
+}
+
+YuvKernel selectYuvKernel() {
+#if defined(VIDEO_BENCH_X86)
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {yuvRowToRgbAvx2, "avx2"};
+    }
+#endif
+    return {yuvRowToRgbSse2, "sse2"};
+#elif defined(VIDEO_BENCH_NEON)
+    return {yuvRowToRgbNeon, "neon"};
+#else
+    return {yuvRowToRgbScalar, "scalar"};
+#endif
+}
+
+const YuvKernel& yuvKernel() {
+    static const YuvKernel kernel = selectYuvKernel();
+    return kernel;
+}
+
+} // namespace
+
+SadRowFn getSadRowKernel() {
+    return sadKernel().fn;
+}
+
+const char* getSadRowKernelName() {
+    return sadKernel().name;
+}
+
+HashStripesFn getHashStripesKernel() {
+    return hashKernel().fn;
+}
+
+const char* getHashStripesKernelName() {
+    return hashKernel().name;
+}
+
+YuvRowToRgbFn getYuvRowToRgbKernel() {
+    return yuvKernel().fn;
+}
+
+const char* getYuvRowToRgbKernelName() {
+    return yuvKernel().name;
+}
+
+} // namespace video_bench
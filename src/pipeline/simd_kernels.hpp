@@ -0,0 +1,62 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace video_bench {
+
+// Width of one SAD block in pixels (one 128-bit vector)
+constexpr int kSadBlockWidth = 16;
+
+// Accumulate per-block sums of absolute differences for one pixel row
+// a, b: row pointers with at least blocks * kSadBlockWidth bytes
+// acc[j] += SAD(a[16j .. 16j+15], b[16j .. 16j+15])
+using SadRowFn = void (*)(const uint8_t* a, const uint8_t* b, int blocks, uint32_t* acc);
+
+// Best SAD row kernel for the running CPU (AVX2 / SSE2 / NEON / scalar)
+// Selected once on first call
+SadRowFn getSadRowKernel();
+
+// Name of the kernel returned by getSadRowKernel()
+const char* getSadRowKernelName();
+
+// Bytes consumed per step by the hash kernels (4 x 64-bit lanes)
+constexpr int kHashStripeBytes = 32;
+
+// Accumulate `stripes` 32-byte stripes into a 4-lane 64-bit hash state
+// Per lane: dk = d ^ key; acc += lo32(dk) * hi32(dk) + d
+// All kernels produce bit-identical state for the same input.
+using HashStripesFn = void (*)(uint64_t* acc, const uint8_t* data, size_t stripes);
+
+// Best hash kernel for the running CPU (AVX2 / SSE2 / NEON / scalar)
+HashStripesFn getHashStripesKernel();
+
+// Name of the kernel returned by getHashStripesKernel()
+const char* getHashStripesKernelName();
+
+// Lane keys used by the hash kernels
+extern const uint64_t kHashLaneKeys[4];
+
+// Per-channel affine normalization applied after YUV -> RGB (RGB in 0..255)
+// out[c] = rgb[c] * scale[c] + bias[c]
+struct RgbNormalize {
+    float scale[3];
+    float bias[3];
+};
+
+// Convert one 4:2:0 row (BT.601 limited range) to normalized planar float RGB
+// y: width samples; u, v: (width + 1) / 2 samples; r, g, b: width floats
+using YuvRowToRgbFn = void (*)(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                               int width, const RgbNormalize& norm,
+                               float* r, float* g, float* b);
+
+// Best YUV -> RGB row kernel for the running CPU (AVX2 / SSE2 / NEON / scalar)
+YuvRowToRgbFn getYuvRowToRgbKernel();
+
+// Name of the kernel returned by getYuvRowToRgbKernel()
+const char* getYuvRowToRgbKernelName();
+
+} // namespace video_bench
+
+#endif // SIMD_KERNELS_HPP
@@ -0,0 +1,210 @@
+#include "pipeline/snapshot_stage.hpp"
+#include <algorithm>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace video_bench {
+
+namespace {
+// JPEG quality scale (2 = best, 31 = worst); 5 matches typical NVR thumbnails
+constexpr int kJpegQScale = 5;
+// Pending jobs allowed per worker before new requests are dropped
+constexpr size_t kQueueDepthPerWorker = 4;
+} // namespace
+
+SnapshotEncoder::SnapshotEncoder(int target_width)
+    : target_width_(target_width)
+    , scaled_(av_frame_alloc())
+    , packet_(av_packet_alloc()) {
+}
+
+bool SnapshotEncoder::configure(const AVFrame* frame, std::string& error_message) {
+    if (!scaled_ || !packet_) {
+        error_message = "Snapshot: failed to allocate frame or packet";
+        return false;
+    }
+
+    // Keep aspect ratio; MJPEG 4:2:0 needs even dimensions
+    int dst_width = std::min(target_width_, frame->width) & ~1;
+    int dst_height = static_cast<int>(static_cast<int64_t>(frame->height) * dst_width
+                                      / frame->width) & ~1;
+    if (dst_width <= 0 || dst_height <= 0) {
+        error_message = "Snapshot: invalid source frame size";
+        return false;
+    }
+
+    sws_ctx_.reset(sws_getContext(frame->width, frame->height,
+                                  static_cast<AVPixelFormat>(frame->format),
+                                  dst_width, dst_height, AV_PIX_FMT_YUVJ420P,
+                                  SWS_BILINEAR, nullptr, nullptr, nullptr));
+    if (!sws_ctx_) {
+        error_message = "Snapshot: failed to create scaler";
+        return false;
+    }
+
+    const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MJPEG);
+    if (!codec) {
+        error_message = "Snapshot: MJPEG encoder not available";
+        return false;
+    }
+
+    encoder_ctx_.reset(avcodec_alloc_context3(codec));
+    if (!encoder_ctx_) {
+        error_message = "Snapshot: failed to allocate encoder context";
+        return false;
+    }
+
+    encoder_ctx_->width = dst_width;
+    encoder_ctx_->height = dst_height;
+    encoder_ctx_->pix_fmt = AV_PIX_FMT_YUVJ420P;
+    encoder_ctx_->time_base = AVRational{1, 25};
+    encoder_ctx_->flags |= AV_CODEC_FLAG_QSCALE;
+    encoder_ctx_->global_quality = FF_QP2LAMBDA * kJpegQScale;
+    encoder_ctx_->thread_count = 1;
+
+    int ret = avcodec_open2(encoder_ctx_.get(), codec, nullptr);
+    if (ret < 0) {
+        error_message = "Snapshot: failed to open MJPEG encoder: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    av_frame_unref(scaled_.get());
+    scaled_->format = AV_PIX_FMT_YUVJ420P;
+    scaled_->width = dst_width;
+    scaled_->height = dst_height;
+    ret = av_frame_get_buffer(scaled_.get(), 0);
+    if (ret < 0) {
+        error_message = "Snapshot: failed to allocate scaled frame: " + ffmpegErrorString(ret);
+        return false;
+    }
+
+    src_width_ = frame->width;
+    src_height_ = frame->height;
+    src_format_ = frame->format;
+    return true;
+}
+
+int64_t SnapshotEncoder::encode(const AVFrame* frame, std::string& error_message) {
+    if (frame->width != src_width_ || frame->height != src_height_ ||
+        frame->format != src_format_) {
+        if (!configure(frame, error_message)) {
+            return -1;
+        }
+    }
+
+    // Encoder may still reference the previous picture
+    int ret = av_frame_make_writable(scaled_.get());
+    if (ret < 0) {
+        error_message = "Snapshot: frame not writable: " + ffmpegErrorString(ret);
+        return -1;
+    }
+
+    sws_scale(sws_ctx_.get(), frame->data, frame->linesize, 0, frame->height,
+              scaled_->data, scaled_->linesize);
+    scaled_->quality = encoder_ctx_->global_quality;
+
+    ret = avcodec_send_frame(encoder_ctx_.get(), scaled_.get());
+    if (ret < 0) {
+        error_message = "Snapshot: send_frame error: " + ffmpegErrorString(ret);
+        return -1;
+    }
+
+    ret = avcodec_receive_packet(encoder_ctx_.get(), packet_.get());
+    if (ret < 0) {
+        error_message = "Snapshot: receive_packet error: " + ffmpegErrorString(ret);
+        return -1;
+    }
+
+    int64_t size = packet_->size;
+    av_packet_unref(packet_.get());
+    return size;
+}
+
+SnapshotWorkerPool::SnapshotWorkerPool(int worker_count, int target_width)
+    : max_queue_size_(static_cast<size_t>(worker_count) * kQueueDepthPerWorker)
+    , target_width_(target_width) {
+    workers_.reserve(worker_count);
+    for (int i = 0; i < worker_count; i++) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+SnapshotWorkerPool::~SnapshotWorkerPool() {
+    stop();
+}
+
+bool SnapshotWorkerPool::submit(const AVFrame* frame) {
+    auto requested = Clock::now();
+    UniqueAVFrame ref(av_frame_clone(frame));
+
+    std::lock_guard lock(mutex_);
+    if (!ref || stopping_ || jobs_.size() >= max_queue_size_) {
+        counters_.dropped++;
+        return false;
+    }
+
+    jobs_.push_back(Job{std::move(ref), requested});
+    cv_.notify_one();
+    return true;
+}
+
+void SnapshotWorkerPool::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+SnapshotCounters SnapshotWorkerPool::getCounters() const {
+    std::lock_guard lock(mutex_);
+    return counters_;
+}
+
+std::string SnapshotWorkerPool::getError() const {
+    std::lock_guard lock(mutex_);
+    return error_message_;
+}
+
+void SnapshotWorkerPool::workerLoop() {
+    SnapshotEncoder encoder(target_width_);
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;  // Stopping and fully drained
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        std::string error;
+        int64_t size = encoder.encode(job.frame.get(), error);
+        double latency_ms = std::chrono::duration<double, std::milli>(
+            Clock::now() - job.requested).count();
+
+        std::lock_guard lock(mutex_);
+        if (size < 0) {
+            if (error_message_.empty()) {
+                error_message_ = error;
+            }
+            continue;
+        }
+        counters_.taken++;
+        counters_.bytes += size;
+        counters_.latency.add(latency_ms);
+    }
+}
+
+} // namespace video_bench
@@ -0,0 +1,115 @@
+#ifndef SNAPSHOT_STAGE_HPP
+#define SNAPSHOT_STAGE_HPP
+
+#include "utils/ffmpeg_utils.hpp"
+#include "utils/latency_stats.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace video_bench {
+
+// Scales a decoded frame to thumbnail size and encodes it as JPEG
+// using the libavcodec MJPEG encoder. One instance per encoding thread.
+class SnapshotEncoder {
+public:
+    explicit SnapshotEncoder(int target_width);
+
+    // Non-copyable, non-movable
+    SnapshotEncoder(const SnapshotEncoder&) = delete;
+    SnapshotEncoder& operator=(const SnapshotEncoder&) = delete;
+    SnapshotEncoder(SnapshotEncoder&&) = delete;
+    SnapshotEncoder& operator=(SnapshotEncoder&&) = delete;
+
+    // Scale and encode one frame
+    // Returns encoded JPEG size in bytes, or -1 on error (error_message set)
+    int64_t encode(const AVFrame* frame, std::string& error_message);
+
+private:
+    // (Re)open encoder and scaler for the given source geometry
+    bool configure(const AVFrame* frame, std::string& error_message);
+
+    int target_width_;
+    int src_width_ = 0;
+    int src_height_ = 0;
+    int src_format_ = -1;
+
+    UniqueSwsContext sws_ctx_;
+    UniqueAVCodecContext encoder_ctx_;
+    UniqueAVFrame scaled_;
+    UniqueAVPacket packet_;
+};
+
+// Aggregated snapshot statistics (per stream or per pool)
+struct SnapshotCounters {
+    int64_t taken = 0;
+    int64_t dropped = 0;   // Requests rejected because the pool queue was full
+    int64_t bytes = 0;
+    LatencyRecorder latency;  // Request-to-encoded latency in ms
+
+    void merge(const SnapshotCounters& other) {
+        taken += other.taken;
+        dropped += other.dropped;
+        bytes += other.bytes;
+        latency.merge(other.latency);
+    }
+};
+
+// Shared worker pool that encodes snapshots off the decoder threads
+// Decoder threads submit frame references; workers scale and encode them
+class SnapshotWorkerPool {
+public:
+    SnapshotWorkerPool(int worker_count, int target_width);
+    ~SnapshotWorkerPool();
+
+    // Non-copyable, non-movable (owns threads)
+    SnapshotWorkerPool(const SnapshotWorkerPool&) = delete;
+    SnapshotWorkerPool& operator=(const SnapshotWorkerPool&) = delete;
+    SnapshotWorkerPool(SnapshotWorkerPool&&) = delete;
+    SnapshotWorkerPool& operator=(SnapshotWorkerPool&&) = delete;
+
+    // Queue a snapshot of the frame (takes a new reference, never blocks)
+    // Returns false if the queue is full and the request was dropped
+    bool submit(const AVFrame* frame);
+
+    // Drain pending jobs and stop workers
+    void stop();
+
+    // Get accumulated statistics (call after stop())
+    SnapshotCounters getCounters() const;
+
+    // Get first encoder error, empty if none
+    std::string getError() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        UniqueAVFrame frame;
+        Clock::time_point requested;
+    };
+
+    void workerLoop();
+
+    size_t max_queue_size_;
+    int target_width_;
+
+    std::deque<Job> jobs_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    SnapshotCounters counters_;
+    std::string error_message_;
+
+    std::vector<std::thread> workers_;
+};
+
+} // namespace video_bench
+
+#endif // SNAPSHOT_STAGE_HPP
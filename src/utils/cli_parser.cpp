@@ -3,6 +3,7 @@
 #include <iostream>
 #include <charconv>
 #include <filesystem>
+#include <sstream>
 
 namespace video_bench {
 
@@ -101,6 +102,734 @@ CliParseResult CliParser::parse(int argc, char* argv[]) {
             continue;
         }
 
+        if (arg == "--cache-dir") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --cache-dir";
+                return result;
+            }
+            result.config.cache_dir = args[++i];
+            continue;
+        }
+
+        if (arg == "--force") {
+            result.config.force_remeasure = true;
+            continue;
+        }
+
+        if (arg == "--snapshot-interval") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --snapshot-interval";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --snapshot-interval: must be a positive number";
+                return result;
+            }
+            result.config.snapshot_interval = *value;
+            continue;
+        }
+
+        if (arg == "--snapshot-width") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --snapshot-width";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 16) {
+                result.success = false;
+                result.error_message = "Invalid value for --snapshot-width: must be at least 16";
+                return result;
+            }
+            result.config.snapshot_width = *value;
+            continue;
+        }
+
+        if (arg == "--snapshot-workers") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --snapshot-workers";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --snapshot-workers: must be a non-negative integer";
+                return result;
+            }
+            result.config.snapshot_workers = *value;
+            continue;
+        }
+
+        if (arg == "--motion-fps") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --motion-fps";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --motion-fps: must be a positive number";
+                return result;
+            }
+            result.config.motion_fps = *value;
+            continue;
+        }
+
+        if (arg == "--motion-downsample") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --motion-downsample";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --motion-downsample: must be a positive integer";
+                return result;
+            }
+            result.config.motion_downsample = *value;
+            continue;
+        }
+
+        if (arg == "--infer-batch") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --infer-batch";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0 || *value > 256) {
+                result.success = false;
+                result.error_message = "Invalid value for --infer-batch: must be between 1 and 256";
+                return result;
+            }
+            result.config.infer_batch = *value;
+            continue;
+        }
+
+        if (arg == "--infer-fps") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --infer-fps";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --infer-fps: must be a positive number";
+                return result;
+            }
+            result.config.infer_fps = *value;
+            continue;
+        }
+
+        if (arg == "--infer-input") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --infer-input";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 16 || *value > 1024) {
+                result.success = false;
+                result.error_message = "Invalid value for --infer-input: must be between 16 and 1024";
+                return result;
+            }
+            result.config.infer_input = *value;
+            continue;
+        }
+
+        if (arg == "--infer-deadline") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --infer-deadline";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --infer-deadline: must be a positive number";
+                return result;
+            }
+            result.config.infer_deadline_ms = *value;
+            continue;
+        }
+
+        if (arg == "--switch-interval") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --switch-interval";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --switch-interval: must be a positive number";
+                return result;
+            }
+            result.config.switch_interval = *value;
+            continue;
+        }
+
+        if (arg == "--substreams") {
+            result.config.substream_mode = true;
+            continue;
+        }
+
+        if (arg == "--stand-in") {
+            result.config.stand_in = true;
+            continue;
+        }
+
+        if (arg == "--rtsp-transport") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --rtsp-transport";
+                return result;
+            }
+            const std::string& value = args[++i];
+            if (value != "tcp" && value != "udp") {
+                result.success = false;
+                result.error_message = "Invalid value for --rtsp-transport: must be tcp or udp";
+                return result;
+            }
+            result.config.rtsp_transport = value;
+            continue;
+        }
+
+        if (arg == "--batched-udp") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --batched-udp";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0 || *value > 64) {
+                result.success = false;
+                result.error_message = "Invalid value for --batched-udp: must be between 1 and 64";
+                return result;
+            }
+            result.config.batched_udp = *value;
+            continue;
+        }
+
+        if (arg == "--tls") {
+            result.config.tls = true;
+            continue;
+        }
+
+        if (arg == "--tls-cipher") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --tls-cipher";
+                return result;
+            }
+            result.config.tls_cipher = args[++i];
+            continue;
+        }
+
+        if (arg == "--segmented") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --segmented";
+                return result;
+            }
+            const std::string& value = args[++i];
+            if (value != "hls" && value != "dash") {
+                result.success = false;
+                result.error_message = "Invalid value for --segmented: must be hls or dash";
+                return result;
+            }
+            result.config.segment_format = value;
+            continue;
+        }
+
+        if (arg == "--segment-duration") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --segment-duration";
+                return result;
+            }
+            // Comma-separated list sweeps several durations in one run
+            std::vector<double> durations;
+            const std::string& list = args[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) end = list.size();
+                auto value = parseDouble(list.substr(start, end - start));
+                if (!value || *value <= 0 || *value > 60) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --segment-duration: must be seconds in (0, 60], comma-separated";
+                    return result;
+                }
+                durations.push_back(*value);
+                start = end + 1;
+            }
+            result.config.segment_durations = durations;
+            continue;
+        }
+
+        if (arg == "--profile") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --profile";
+                return result;
+            }
+            result.config.profile_dir = args[++i];
+            continue;
+        }
+
+        if (arg == "--profile-hz") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --profile-hz";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0 || *value > 10000) {
+                result.success = false;
+                result.error_message = "Invalid value for --profile-hz: must be between 1 and 10000";
+                return result;
+            }
+            result.config.profile_hz = *value;
+            continue;
+        }
+
+        if (arg == "--decoder-sched") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --decoder-sched";
+                return result;
+            }
+            auto policy = SchedPolicy::parse(args[++i]);
+            if (!policy) {
+                result.success = false;
+                result.error_message = "Invalid value for --decoder-sched: " + args[i];
+                return result;
+            }
+            result.config.decoder_sched = *policy;
+            continue;
+        }
+
+        if (arg == "--reader-sched") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --reader-sched";
+                return result;
+            }
+            auto policy = SchedPolicy::parse(args[++i]);
+            if (!policy) {
+                result.success = false;
+                result.error_message = "Invalid value for --reader-sched: " + args[i];
+                return result;
+            }
+            result.config.reader_sched = *policy;
+            continue;
+        }
+
+        if (arg == "--background-sched") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --background-sched";
+                return result;
+            }
+            auto policy = SchedPolicy::parse(args[++i]);
+            if (!policy) {
+                result.success = false;
+                result.error_message = "Invalid value for --background-sched: " + args[i];
+                return result;
+            }
+            result.config.background_sched = *policy;
+            continue;
+        }
+
+        if (arg == "--background-streams") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --background-streams";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --background-streams: must be a non-negative integer";
+                return result;
+            }
+            result.config.background_streams = *value;
+            continue;
+        }
+
+        if (arg == "--sched-compare") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --sched-compare";
+                return result;
+            }
+            std::vector<SchedPolicy> policies;
+            std::istringstream list(args[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                auto policy = SchedPolicy::parse(item);
+                if (!policy) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --sched-compare: " + item;
+                    return result;
+                }
+                policies.push_back(*policy);
+            }
+            if (policies.size() < 2) {
+                result.success = false;
+                result.error_message = "Invalid value for --sched-compare: list at least two policies";
+                return result;
+            }
+            result.config.sched_compare = policies;
+            continue;
+        }
+
+        if (arg == "--agent") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --agent";
+                return result;
+            }
+            result.config.agent_listen = args[++i];
+            continue;
+        }
+
+        if (arg == "--coordinator") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --coordinator";
+                return result;
+            }
+            std::istringstream list(args[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (item.find(':') == std::string::npos) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --coordinator: agents must be host:port";
+                    return result;
+                }
+                result.config.coordinator_agents.push_back(item);
+            }
+            continue;
+        }
+
+        if (arg == "--record") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --record";
+                return result;
+            }
+            result.config.record_dir = args[++i];
+            continue;
+        }
+
+        if (arg == "--record-format") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --record-format";
+                return result;
+            }
+            std::string format = args[++i];
+            if (format != "mp4" && format != "mkv") {
+                result.success = false;
+                result.error_message = "Invalid value for --record-format: must be mp4 or mkv";
+                return result;
+            }
+            result.config.record_format = format;
+            continue;
+        }
+
+        if (arg == "--record-segment") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --record-segment";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0.0) {
+                result.success = false;
+                result.error_message = "Invalid value for --record-segment: must be a positive number";
+                return result;
+            }
+            result.config.record_segment = *value;
+            continue;
+        }
+
+        if (arg == "--record-fsync") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --record-fsync";
+                return result;
+            }
+            std::string policy = args[++i];
+            if (policy != "none" && policy != "segment" && policy != "keyframe") {
+                result.success = false;
+                result.error_message = "Invalid value for --record-fsync: must be none, segment or keyframe";
+                return result;
+            }
+            result.config.record_fsync = policy;
+            continue;
+        }
+
+        if (arg == "--record-direct") {
+            result.config.record_direct = true;
+            continue;
+        }
+
+        if (arg == "--loop-bench") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --loop-bench";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --loop-bench: must be a positive integer";
+                return result;
+            }
+            result.config.loop_bench_frames = *value;
+            continue;
+        }
+
+        if (arg == "--canary") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --canary";
+                return result;
+            }
+            result.config.canary_baseline = args[++i];
+            continue;
+        }
+
+        if (arg == "--canary-budget") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --canary-budget";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0 || *value > 100) {
+                result.success = false;
+                result.error_message = "Invalid value for --canary-budget: must be between 0 and 100 percent";
+                return result;
+            }
+            result.config.canary_budget = *value;
+            continue;
+        }
+
+        if (arg == "--canary-tolerance") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --canary-tolerance";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0 || *value >= 100) {
+                result.success = false;
+                result.error_message = "Invalid value for --canary-tolerance: must be between 0 and 100 percent";
+                return result;
+            }
+            result.config.canary_tolerance = *value;
+            continue;
+        }
+
+        if (arg == "--canary-interval") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --canary-interval";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value < 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --canary-interval: must be a non-negative number of seconds";
+                return result;
+            }
+            result.config.canary_interval = *value;
+            continue;
+        }
+
+        if (arg == "--canary-metrics") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --canary-metrics";
+                return result;
+            }
+            result.config.canary_metrics = args[++i];
+            continue;
+        }
+
+        if (arg == "--playback") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --playback";
+                return result;
+            }
+            // One ladder per speed
+            std::vector<int> speeds;
+            const std::string& list = args[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) end = list.size();
+                auto value = parseInteger(list.substr(start, end - start));
+                if (!value || *value < 2 || *value > 64) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --playback: must be speeds in [2, 64], comma-separated";
+                    return result;
+                }
+                speeds.push_back(*value);
+                start = end + 1;
+            }
+            result.config.playback_speeds = speeds;
+            continue;
+        }
+
+        if (arg == "--reverse") {
+            result.config.reverse = true;
+            continue;
+        }
+
+        if (arg == "--reverse-cache") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --reverse-cache";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value <= 0) {
+                result.success = false;
+                result.error_message = "Invalid value for --reverse-cache: must be a positive integer";
+                return result;
+            }
+            result.config.reverse_cache = *value;
+            continue;
+        }
+
+        if (arg == "--reverse-width") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --reverse-width";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 16) {
+                result.success = false;
+                result.error_message = "Invalid value for --reverse-width: must be at least 16";
+                return result;
+            }
+            result.config.reverse_width = *value;
+            continue;
+        }
+
+        if (arg == "--temporal-layers") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --temporal-layers";
+                return result;
+            }
+            // One ladder per highest layer kept
+            std::vector<int> layers;
+            const std::string& list = args[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) end = list.size();
+                auto value = parseInteger(list.substr(start, end - start));
+                if (!value || *value < 0 || *value > 6) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --temporal-layers: must be layers in [0, 6], comma-separated";
+                    return result;
+                }
+                layers.push_back(*value);
+                start = end + 1;
+            }
+            result.config.temporal_layers = layers;
+            continue;
+        }
+
+        if (arg == "--cpu-latency") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --cpu-latency";
+                return result;
+            }
+            auto value = parseInteger(args[++i]);
+            if (!value || *value < 0 || *value > 100000) {
+                result.success = false;
+                result.error_message = "Invalid value for --cpu-latency: must be between 0 and 100000 us";
+                return result;
+            }
+            result.config.cpu_latency_us = *value;
+            continue;
+        }
+
+        if (arg == "--mosaic") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --mosaic";
+                return result;
+            }
+            // One ladder per canvas size
+            std::vector<std::pair<int, int>> canvases;
+            const std::string& list = args[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) end = list.size();
+                std::string size = list.substr(start, end - start);
+                size_t x = size.find('x');
+                std::optional<int> width;
+                std::optional<int> height;
+                if (x != std::string::npos) {
+                    width = parseInteger(size.substr(0, x));
+                    height = parseInteger(size.substr(x + 1));
+                }
+                if (!width || !height || *width < 64 || *height < 64 ||
+                    *width > 16384 || *height > 16384) {
+                    result.success = false;
+                    result.error_message = "Invalid value for --mosaic: must be canvas sizes WxH "
+                                           "(64 to 16384), comma-separated";
+                    return result;
+                }
+                canvases.emplace_back(*width, *height);
+                start = end + 1;
+            }
+            result.config.mosaic_canvases = canvases;
+            continue;
+        }
+
+        if (arg == "--mosaic-fps") {
+            if (i + 1 >= args.size()) {
+                result.success = false;
+                result.error_message = "Missing value for --mosaic-fps";
+                return result;
+            }
+            auto value = parseDouble(args[++i]);
+            if (!value || *value <= 0 || *value > 240) {
+                result.success = false;
+                result.error_message = "Invalid value for --mosaic-fps: must be between 0 and 240";
+                return result;
+            }
+            result.config.mosaic_fps = *value;
+            continue;
+        }
+
+        if (arg == "--verify-output") {
+            result.config.verify_output = true;
+            continue;
+        }
+
         if (arg[0] == '-') {
             result.success = false;
             result.error_message = "Unknown option: " + arg;
@@ -117,12 +846,57 @@ CliParseResult CliParser::parse(int argc, char* argv[]) {
         }
     }
 
+#ifndef VIDEO_BENCH_NETWORK_INGEST
+    if (!result.config.agent_listen.empty() || !result.config.coordinator_agents.empty()) {
+        result.success = false;
+        result.error_message = "--agent and --coordinator are only supported on Linux";
+        return result;
+    }
+#endif
+
+    // An agent gets its command line from the coordinator
+    if (!result.config.agent_listen.empty()) {
+        if (!result.config.coordinator_agents.empty()) {
+            result.success = false;
+            result.error_message = "--agent cannot be combined with --coordinator";
+            return result;
+        }
+        return result;
+    }
+
     if (video_path.empty()) {
         result.success = false;
         result.error_message = "Missing video file path or RTSP URL";
         return result;
     }
 
+    // The coordinator forwards everything but its own and output options;
+    // the source path is resolved and validated on each agent. Agents only
+    // run the base ladder, so options adding comparison ladders are out
+    if (!result.config.coordinator_agents.empty()) {
+        if (result.config.loop_bench_frames > 0 || result.config.canary_baseline ||
+            !result.config.playback_speeds.empty() || !result.config.temporal_layers.empty() ||
+            result.config.mosaic_canvases.size() > 1 || result.config.record_dir ||
+            result.config.cpu_latency_us) {
+            result.success = false;
+            result.error_message = "--loop-bench, --canary, --playback, --temporal-layers, a "
+                                   "--mosaic list, --record and --cpu-latency cannot be "
+                                   "combined with --coordinator";
+            return result;
+        }
+        for (size_t i = 1; i < args.size(); i++) {
+            const std::string& arg = args[i];
+            if (arg == "--coordinator" || arg == "-c" || arg == "--csv-file" ||
+                arg == "-l" || arg == "--log-file") {
+                i++;
+                continue;
+            }
+            result.config.agent_args.push_back(arg);
+        }
+        result.config.video_path = video_path;
+        return result;
+    }
+
     // Check if it's an RTSP URL or file
     bool is_rtsp = (video_path.find("rtsp://") == 0 || video_path.find("rtsps://") == 0);
 
@@ -132,6 +906,269 @@ CliParseResult CliParser::parse(int argc, char* argv[]) {
         return result;
     }
 
+    if (is_rtsp && result.config.cache_dir) {
+        result.success = false;
+        result.error_message = "--cache-dir requires a local file source";
+        return result;
+    }
+
+    if (is_rtsp && result.config.loop_bench_frames > 0) {
+        result.success = false;
+        result.error_message = "--loop-bench requires a local file source";
+        return result;
+    }
+
+    if (is_rtsp && result.config.canary_baseline) {
+        result.success = false;
+        result.error_message = "--canary requires a local file source";
+        return result;
+    }
+
+    if (result.config.canary_baseline && result.config.loop_bench_frames > 0) {
+        result.success = false;
+        result.error_message = "--canary cannot be combined with --loop-bench";
+        return result;
+    }
+
+    if (!result.config.canary_baseline &&
+        (result.config.canary_metrics || result.config.canary_interval > 0 ||
+         result.config.canary_budget != 10.0 || result.config.canary_tolerance != 10.0)) {
+        result.success = false;
+        result.error_message = "--canary-budget, --canary-tolerance, --canary-interval and "
+                               "--canary-metrics require --canary";
+        return result;
+    }
+
+    if (is_rtsp && result.config.verify_output) {
+        result.success = false;
+        result.error_message = "--verify-output requires a local file source";
+        return result;
+    }
+
+#ifndef VIDEO_BENCH_NETWORK_INGEST
+    if (result.config.stand_in || result.config.batched_udp ||
+        !result.config.segment_format.empty()) {
+        result.success = false;
+        result.error_message = "--stand-in, --batched-udp and --segmented are only supported on Linux";
+        return result;
+    }
+#endif
+
+#ifndef VIDEO_BENCH_SAMPLING_PROFILER
+    if (result.config.profile_dir) {
+        result.success = false;
+        result.error_message = "--profile is only supported on Linux";
+        return result;
+    }
+#endif
+
+#ifndef VIDEO_BENCH_SEGMENT_RECORDER
+    if (result.config.record_dir) {
+        result.success = false;
+        result.error_message = "--record is only supported on Linux";
+        return result;
+    }
+#endif
+
+    if ((result.config.record_direct || result.config.record_fsync != "segment" ||
+         result.config.record_format != "mp4" || result.config.record_segment != 60.0) &&
+        !result.config.record_dir) {
+        result.success = false;
+        result.error_message = "--record-format, --record-segment, --record-fsync and --record-direct require --record";
+        return result;
+    }
+
+    // Recording runs a second ladder without it; batched UDP has no reader to tap
+    if (result.config.record_dir) {
+        if (result.config.tls || !result.config.sched_compare.empty() ||
+            result.config.segment_durations.size() > 1 || result.config.batched_udp) {
+            result.success = false;
+            result.error_message = "--record cannot be combined with --tls, --sched-compare, "
+                                   "a --segment-duration list or --batched-udp";
+            return result;
+        }
+    }
+
+    // Cached points are not measured, so there would be nothing to sample
+    if (result.config.profile_dir && result.config.cache_dir) {
+        result.success = false;
+        result.error_message = "--profile cannot be combined with --cache-dir";
+        return result;
+    }
+
+    // Each compared policy gets its own ladder
+    if (!result.config.sched_compare.empty()) {
+        if (!result.config.decoder_sched.isDefault()) {
+            result.success = false;
+            result.error_message = "--sched-compare sets the decoder policy; drop --decoder-sched";
+            return result;
+        }
+        if (result.config.tls || result.config.segment_durations.size() > 1) {
+            result.success = false;
+            result.error_message = "--sched-compare cannot be combined with --tls or a --segment-duration list";
+            return result;
+        }
+    }
+
+    if (!result.config.segment_format.empty()) {
+        if (is_rtsp) {
+            result.success = false;
+            result.error_message = "--segmented requires a local file source";
+            return result;
+        }
+        if (result.config.stand_in || result.config.verify_output) {
+            result.success = false;
+            result.error_message = "--segmented cannot be combined with --stand-in or --verify-output";
+            return result;
+        }
+    }
+
+    // Fast-forward needs a seekable recording; each speed runs its own ladder,
+    // and the stages assume real-time frames
+    if (!result.config.playback_speeds.empty()) {
+        if (is_rtsp || result.config.stand_in || !result.config.segment_format.empty()) {
+            result.success = false;
+            result.error_message = "--playback requires a local file source without --stand-in or --segmented";
+            return result;
+        }
+        if (result.config.record_dir || !result.config.sched_compare.empty()) {
+            result.success = false;
+            result.error_message = "--playback cannot be combined with --record or --sched-compare";
+            return result;
+        }
+        if (result.config.snapshot_interval || result.config.motion_fps ||
+            result.config.infer_batch || result.config.verify_output) {
+            result.success = false;
+            result.error_message = "--playback cannot be combined with --snapshot-interval, --motion-fps, "
+                                   "--infer-batch or --verify-output";
+            return result;
+        }
+    }
+
+    if ((result.config.reverse_cache != 120 || result.config.reverse_width != 0) &&
+        !result.config.reverse) {
+        result.success = false;
+        result.error_message = "--reverse-cache and --reverse-width require --reverse";
+        return result;
+    }
+
+    // Reverse sessions seek in the file themselves, outside the packet pipeline
+    if (result.config.reverse) {
+        if (is_rtsp || result.config.stand_in || !result.config.segment_format.empty()) {
+            result.success = false;
+            result.error_message = "--reverse requires a local file source without --stand-in or --segmented";
+            return result;
+        }
+        if (result.config.substream_mode || result.config.record_dir ||
+            !result.config.playback_speeds.empty() || result.config.switch_interval) {
+            result.success = false;
+            result.error_message = "--reverse cannot be combined with --substreams, --record, "
+                                   "--playback or --switch-interval";
+            return result;
+        }
+        if (result.config.snapshot_interval || result.config.motion_fps ||
+            result.config.infer_batch || result.config.verify_output) {
+            result.success = false;
+            result.error_message = "--reverse cannot be combined with --snapshot-interval, --motion-fps, "
+                                   "--infer-batch or --verify-output";
+            return result;
+        }
+    }
+
+    // Each layer gets its own ladder, paced on the media clock like
+    // playback, so the stages are out as well
+    if (!result.config.temporal_layers.empty()) {
+        if (result.config.record_dir || result.config.tls ||
+            !result.config.sched_compare.empty() || result.config.segment_durations.size() > 1) {
+            result.success = false;
+            result.error_message = "--temporal-layers cannot be combined with --record, "
+                                   "--tls, --sched-compare or a --segment-duration list";
+            return result;
+        }
+        if (!result.config.playback_speeds.empty() || result.config.reverse ||
+            !result.config.mosaic_canvases.empty()) {
+            result.success = false;
+            result.error_message = "--temporal-layers cannot be combined with --playback, --reverse or --mosaic";
+            return result;
+        }
+        if (result.config.snapshot_interval || result.config.motion_fps ||
+            result.config.infer_batch || result.config.verify_output) {
+            result.success = false;
+            result.error_message = "--temporal-layers cannot be combined with --snapshot-interval, "
+                                   "--motion-fps, --infer-batch or --verify-output";
+            return result;
+        }
+    }
+
+    if (result.config.mosaic_fps != 30.0 && result.config.mosaic_canvases.empty()) {
+        result.success = false;
+        result.error_message = "--mosaic-fps requires --mosaic";
+        return result;
+    }
+
+    // Each further canvas gets its own ladder; reverse sessions bypass the
+    // per-frame stages the tiles are fed from
+    if (!result.config.mosaic_canvases.empty()) {
+        if (result.config.record_dir || result.config.tls ||
+            !result.config.sched_compare.empty() || result.config.segment_durations.size() > 1) {
+            result.success = false;
+            result.error_message = "--mosaic cannot be combined with --record, --tls, "
+                                   "--sched-compare or a --segment-duration list";
+            return result;
+        }
+        if (!result.config.playback_speeds.empty() || result.config.reverse) {
+            result.success = false;
+            result.error_message = "--mosaic cannot be combined with --playback or --reverse";
+            return result;
+        }
+    }
+
+    if (result.config.stand_in) {
+        if (is_rtsp) {
+            result.success = false;
+            result.error_message = "--stand-in requires a local file source";
+            return result;
+        }
+        if (result.config.verify_output) {
+            result.success = false;
+            result.error_message = "--stand-in cannot be combined with --verify-output";
+            return result;
+        }
+    }
+
+    if (!result.config.tls_cipher.empty() && !result.config.tls) {
+        result.success = false;
+        result.error_message = "--tls-cipher requires --tls";
+        return result;
+    }
+
+    if (result.config.tls) {
+        if (!result.config.stand_in) {
+            result.success = false;
+            result.error_message = "--tls requires --stand-in";
+            return result;
+        }
+        if (result.config.batched_udp || result.config.rtsp_transport == "udp") {
+            result.success = false;
+            result.error_message = "--tls uses interleaved TCP; it cannot be combined with UDP ingest";
+            return result;
+        }
+    }
+
+    if (result.config.batched_udp) {
+        if (!is_rtsp && !result.config.stand_in) {
+            result.success = false;
+            result.error_message = "--batched-udp requires an RTSP source or --stand-in";
+            return result;
+        }
+        if (is_rtsp && video_path.find("rtsps://") == 0) {
+            result.success = false;
+            result.error_message = "--batched-udp does not support rtsps://";
+            return result;
+        }
+        result.config.rtsp_transport = "udp";
+    }
+
     result.config.video_path = video_path;
     return result;
 }
@@ -149,17 +1186,68 @@ void CliParser::printUsage(const std::string& program_name) {
               << "  -f, --target-fps FPS   Target FPS for real-time threshold (default: video's native FPS)\n"
               << "  -l, --log-file PATH    Log file path (default: video-benchmark.log)\n"
               << "  -c, --csv-file PATH    Export results to CSV file\n"
+              << "  --cache-dir DIR        Reuse results cached for this host, source and config\n"
+              << "  --force                Re-measure cached points (cache is still updated)\n"
+              << "  --snapshot-interval SEC  Encode a JPEG snapshot per stream every SEC seconds\n"
+              << "  --substreams          High stream count mode: shared readers, small queues, ladder to 4096\n"
+              << "  --verify-output        Hash every frame and compare with a single-threaded reference decode\n"
+              << "  --stand-in             Serve the file from an in-process loopback RTSP server (Linux)\n"
+              << "  --rtsp-transport T     RTP transport for RTSP sources: tcp or udp (default: tcp)\n"
+              << "  --batched-udp N        Receive RTP with N recvmmsg() threads on one shared port (Linux)\n"
+              << "  --tls                  Stand-in also serves RTSPS; rerun the ladder with TLS ingest\n"
+              << "  --tls-cipher LIST      Stand-in OpenSSL cipher list or TLS 1.3 suites (with --tls)\n"
+              << "  --segmented FMT        Serve the file as hls or dash from a loopback HTTP server (Linux)\n"
+              << "  --segment-duration S   Segment length in seconds, comma list to sweep (default: 4)\n"
+              << "  --snapshot-width PX    Snapshot width in pixels (default: 320)\n"
+              << "  --snapshot-workers N   Shared snapshot encoder threads (default: 0 = inline)\n"
+              << "  --motion-fps FPS       Run motion detection on up to FPS frames/s per stream\n"
+              << "  --motion-downsample N  Motion detection luma downsampling factor (default: 4)\n"
+              << "  --switch-interval SEC  Keep last-GOP rings and simulate a channel switch every SEC seconds\n"
+              << "  --infer-batch N        Gather frames from all streams into NCHW float batches of N\n"
+              << "  --infer-fps FPS        Frames per second per stream sent to the batcher (default: 5)\n"
+              << "  --infer-input PX       Square model input size in pixels (default: 224)\n"
+              << "  --infer-deadline MS    Flush a partial batch after MS milliseconds (default: 100)\n"
+              << "  --profile DIR          Sample all threads during each test; write flat and folded profiles (Linux)\n"
+              << "  --profile-hz HZ        Profiler samples per CPU-second per thread (default: 499)\n"
+              << "  --decoder-sched SPEC   Decoder thread policy: default, other[:NICE], batch[:NICE], idle, fifo:PRIO, rr:PRIO\n"
+              << "  --reader-sched SPEC    Reader thread policy (same syntax)\n"
+              << "  --background-streams N Last N streams of each test are background streams (not in pass/fail)\n"
+              << "  --background-sched SPEC  Background stream decoder policy (default: idle)\n"
+              << "  --sched-compare LIST   Repeat the ladder per decoder policy, e.g. default,batch,fifo:10\n"
+              << "  --agent [ADDR:]PORT    Fleet agent: run tests sent by a coordinator (Linux)\n"
+              << "  --coordinator LIST     Fleet coordinator: run the ladder on host:port agents in lockstep\n"
+              << "  --loop-bench FRAMES    Measure per-frame decode loop overhead, bare vs instrumented\n"
+              << "  --canary FILE          Decode a short reference clip within a CPU budget; compare with the baseline in FILE\n"
+              << "  --canary-budget PCT    Canary CPU budget in percent of one core (default: 10)\n"
+              << "  --canary-tolerance PCT Canary fails when this much slower than the baseline (default: 10)\n"
+              << "  --canary-interval SEC  Repeat the canary every SEC seconds (default: 0 = once)\n"
+              << "  --canary-metrics FILE  Write canary metrics in Prometheus text format\n"
+              << "  --record DIR           Remux every stream to rolling segments in DIR while decoding (Linux)\n"
+              << "  --record-format FMT    Segment container: mp4 (fragmented) or mkv (default: mp4)\n"
+              << "  --record-segment SEC   Segment length in seconds (default: 60)\n"
+              << "  --record-fsync POLICY  fsync recorded data: none, segment or keyframe (default: segment)\n"
+              << "  --record-direct        Write segments with O_DIRECT (bypass the page cache)\n"
+              << "  --playback SPEEDS      Repeat the ladder as fast-forward playback, e.g. 2,4,8,16\n"
+              << "  --reverse              Every stream plays the file backwards (reverse playback sessions)\n"
+              << "  --reverse-cache N      Decoded frames cached per reverse session (default: 120)\n"
+              << "  --reverse-width PX     Cache reverse frames scaled to PX wide (default: decoded size)\n"
+              << "  --mosaic SIZES         Video wall: scale every stream into a tile of a shared canvas, e.g. 1920x1080,3840x2160\n"
+              << "  --mosaic-fps FPS       Canvas composite rate (default: 30)\n"
+              << "  --temporal-layers LIST Repeat the ladder decoding temporal layers up to each, e.g. 0,1\n"
+              << "  --cpu-latency US       Hold a PM QoS wakeup latency request per test; rerun without it (Linux, root)\n"
               << "  -h, --help             Show this help message\n"
               << "  -v, --version          Show version information\n"
               << "\n"
-              << "Supported codecs: H.264, H.265/HEVC, VP9, AV1\n"
+              << "Supported codecs: H.264, H.265/HEVC, VP9, AV1, H.266/VVC, MPEG-4 Part 2, MPEG-2, MJPEG\n"
               << "Supported inputs: Local files, RTSP streams (rtsp://)\n"
               << "\n"
               << "Examples:\n"
               << "  " << program_name << " video.mp4\n"
               << "  " << program_name << " --max-streams 8 video.mp4\n"
               << "  " << program_name << " rtsp://192.168.1.100:554/stream\n"
-              << "  " << program_name << " -f 30 -m 4 rtsp://camera.local/live\n";
+              << "  " << program_name << " -f 30 -m 4 rtsp://camera.local/live\n"
+              << "  " << program_name << " --stand-in --batched-udp 4 video.mp4\n"
+              << "  " << program_name << " --segmented hls --segment-duration 2,6 video.mp4\n";
 }
 
 void CliParser::printVersion() {
@@ -1,8 +1,21 @@
 #include "utils/csv_exporter.hpp"
 #include <fstream>
+#include <algorithm>
 
 namespace video_bench {
 
+namespace {
+// Quote a free-text field (C++ symbols contain commas)
+std::string csvQuote(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+} // namespace
+
 bool CsvExporter::exportToFile(const BenchmarkResult& result,
                                const std::string& path,
                                std::string& error) {
@@ -12,8 +25,119 @@ bool CsvExporter::exportToFile(const BenchmarkResult& result,
         return false;
     }
 
+    // Optional stage columns are only present when the stage was enabled
+    const bool has_snapshot = !result.test_results.empty() &&
+                              result.test_results.front().snapshot.has_value();
+    const bool has_motion = !result.test_results.empty() &&
+                            result.test_results.front().motion.has_value();
+    const bool has_switch = !result.test_results.empty() &&
+                            result.test_results.front().channel_switch.has_value();
+    const bool has_hash = !result.test_results.empty() &&
+                          result.test_results.front().hash_check.has_value();
+    const bool has_batch = !result.test_results.empty() &&
+                           result.test_results.front().batch.has_value();
+    const bool has_harness = !result.test_results.empty() &&
+                             result.test_results.front().harness.has_value();
+    const bool has_network = !result.test_results.empty() &&
+                             result.test_results.front().network.has_value();
+    const bool has_ingest = !result.test_results.empty() &&
+                            result.test_results.front().ingest.has_value();
+    const bool has_segment = !result.test_results.empty() &&
+                             result.test_results.front().segment.has_value();
+    const bool has_sched = !result.test_results.empty() &&
+                           result.test_results.front().sched.has_value();
+    const bool has_profile = !result.test_results.empty() &&
+                             result.test_results.front().profile.has_value();
+    const bool has_record = !result.test_results.empty() &&
+                            result.test_results.front().record.has_value();
+    const bool has_reverse = !result.test_results.empty() &&
+                             result.test_results.front().reverse.has_value();
+    const bool has_power = !result.test_results.empty() &&
+                           result.test_results.front().power.has_value();
+    const bool has_mosaic = !result.test_results.empty() &&
+                            result.test_results.front().mosaic.has_value();
+    // Playback and layer ladders follow the real-time one
+    const bool has_playback = std::any_of(result.test_results.begin(), result.test_results.end(),
+                                          [](const StreamTestResult& test) {
+                                              return test.playback.has_value();
+                                          });
+    const bool has_layers = std::any_of(result.test_results.begin(), result.test_results.end(),
+                                        [](const StreamTestResult& test) {
+                                            return test.layers.has_value();
+                                        });
+
     file << "stream_count,avg_fps,min_fps,max_fps,cpu_usage,memory_mb,"
-            "fps_passed,cpu_passed,passed\n";
+            "fps_passed,cpu_passed,passed,window_seconds,legacy_avg_fps,late_frames,max_lag_ms,lag_slow_decode,"
+            "lag_slow_decode_key,lag_slow_decode_delta,lag_stage_work,lag_reader_starved,"
+            "lag_scheduler_delay,lag_oversleep,lateness_p50_ms,lateness_p95_ms,lateness_p99_ms";
+    if (has_snapshot) {
+        file << ",snapshots,snapshot_dropped,snapshot_avg_bytes,"
+                "snapshot_latency_avg_ms,snapshot_latency_p95_ms,snapshot_latency_max_ms";
+    }
+    if (has_motion) {
+        file << ",motion_frames_analyzed,motion_frames,motion_cost_avg_us,motion_cost_p95_us";
+    }
+    if (has_switch) {
+        file << ",switches,switch_latency_avg_ms,switch_latency_p95_ms,switch_latency_max_ms,"
+                "switch_cpu_ms,switch_frames,gop_ring_kb_per_stream,gop_ring_kb_total";
+    }
+    if (has_hash) {
+        file << ",hash_frames_checked,hash_mismatches,hash_unchecked,"
+                "hash_cost_avg_us,hash_cost_p95_us";
+    }
+    if (has_batch) {
+        file << ",batch_size,batch_frames,batch_dropped,full_batches,deadline_batches,"
+                "batches_per_sec,batch_assembly_avg_ms,batch_assembly_p95_ms,"
+                "batch_assembly_max_ms,batch_convert_avg_us,batch_convert_p95_us";
+    }
+    if (has_harness) {
+        file << ",harness_kb_per_stream,readers,queue_size";
+    }
+    if (has_network) {
+        file << ",net_cpu_usage,decode_cpu_usage,rx_mbps,net_cpu_ms_per_mbit,"
+                "net_core_pct_per_stream,udp_rcvbuf_errors";
+    }
+    if (has_ingest) {
+        file << ",ingest_path,receiver_threads,recv_syscalls_per_sec,datagrams_per_sec,"
+                "ingest_core_pct_per_stream,stand_in_cpu_usage,reader_cpu_ms_per_mbit,"
+                "lost_packets,dropped_units";
+    }
+    if (has_segment) {
+        file << ",segment_format,segment_duration,segments_fetched,manifest_fetches,"
+                "reader_cpu_ms_per_segment,segment_server_cpu_usage";
+    }
+    if (has_sched) {
+        file << ",decoder_sched,reader_sched,background_sched,background_streams,"
+                "background_avg_fps,background_min_fps";
+    }
+    if (has_profile) {
+        file << ",profile_samples,profile_dropped,profile_threads,profile_top_function,"
+                "profile_top_self_pct,profile_folded_path";
+    }
+    if (has_record) {
+        file << ",record_format,record_segment_s,record_fsync,record_direct,record_bytes,"
+                "record_mb_per_s,record_segments,fsync_p50_ms,fsync_p95_ms,fsync_p99_ms";
+    }
+    if (has_playback) {
+        file << ",playback_speed,playback_strategy,displayed_fps,skipped_pct";
+    }
+    if (has_reverse) {
+        file << ",reverse_cache_frames,reverse_cache_width,reverse_cache_mb_per_session,"
+                "reverse_rss_mb_per_session,reverse_decode_ratio,reverse_chunks_per_sec";
+    }
+    if (has_power) {
+        file << ",cpu_latency_us,package_watts,idle_entries_per_sec,cstate_residency_pct";
+    }
+    if (has_layers) {
+        file << ",max_layer,highest_layer,decoded_fps,dropped_pct,parse_ns_per_packet,"
+                "parse_us_per_sec";
+    }
+    if (has_mosaic) {
+        file << ",mosaic_canvas,mosaic_layout,mosaic_tile_width,mosaic_tile_height,mosaic_fps,"
+                "mosaic_composites,mosaic_slots,mosaic_deadline_misses,mosaic_stale_tile_pct,"
+                "mosaic_compose_p95_ms,mosaic_tile_scale_p95_ms";
+    }
+    file << "\n";
 
     for (const auto& test : result.test_results) {
         file << test.stream_count << ","
@@ -24,7 +148,191 @@ bool CsvExporter::exportToFile(const BenchmarkResult& result,
              << test.memory_usage_mb << ","
              << (test.fps_passed ? "true" : "false") << ","
              << (test.cpu_passed ? "true" : "false") << ","
-             << (test.passed ? "true" : "false") << "\n";
+             << (test.passed ? "true" : "false") << ","
+             << test.window_seconds << ","
+             << test.legacy_fps_per_stream << ","
+             << test.lag.late_frames << ","
+             << test.lag.max_lag_ms << ","
+             << test.lag.slow_decode << ","
+             << test.lag.slow_decode_key << ","
+             << test.lag.slow_decode_delta << ","
+             << test.lag.stage_work << ","
+             << test.lag.reader_starved << ","
+             << test.lag.scheduler_delay << ","
+             << test.lag.oversleep << ","
+             << test.lag.lateness.p50_ms << ","
+             << test.lag.lateness.p95_ms << ","
+             << test.lag.lateness.p99_ms;
+        if (has_snapshot) {
+            const SnapshotStats snap = test.snapshot.value_or(SnapshotStats{});
+            file << "," << snap.taken
+                 << "," << snap.dropped
+                 << "," << snap.avg_bytes
+                 << "," << snap.latency.avg_ms
+                 << "," << snap.latency.p95_ms
+                 << "," << snap.latency.max_ms;
+        }
+        if (has_motion) {
+            const MotionStats motion = test.motion.value_or(MotionStats{});
+            file << "," << motion.frames_analyzed
+                 << "," << motion.motion_frames
+                 << "," << motion.cost.avg_ms * 1000.0
+                 << "," << motion.cost.p95_ms * 1000.0;
+        }
+        if (has_switch) {
+            const SwitchStats sw = test.channel_switch.value_or(SwitchStats{});
+            file << "," << sw.switches
+                 << "," << sw.latency.avg_ms
+                 << "," << sw.latency.p95_ms
+                 << "," << sw.latency.max_ms
+                 << "," << sw.avg_cpu_ms
+                 << "," << sw.avg_frames
+                 << "," << sw.ring_kb_per_stream
+                 << "," << sw.ring_kb_total;
+        }
+        if (has_hash) {
+            const HashCheckStats hash = test.hash_check.value_or(HashCheckStats{});
+            file << "," << hash.frames_checked
+                 << "," << hash.mismatches
+                 << "," << hash.unchecked
+                 << "," << hash.cost.avg_ms * 1000.0
+                 << "," << hash.cost.p95_ms * 1000.0;
+        }
+        if (has_batch) {
+            const BatchStats batch = test.batch.value_or(BatchStats{});
+            file << "," << batch.batch_size
+                 << "," << batch.frames_batched
+                 << "," << batch.frames_dropped
+                 << "," << batch.full_batches
+                 << "," << batch.deadline_batches
+                 << "," << batch.batches_per_sec
+                 << "," << batch.assembly.avg_ms
+                 << "," << batch.assembly.p95_ms
+                 << "," << batch.assembly.max_ms
+                 << "," << batch.convert.avg_ms * 1000.0
+                 << "," << batch.convert.p95_ms * 1000.0;
+        }
+        if (has_harness) {
+            const HarnessStats harness = test.harness.value_or(HarnessStats{});
+            file << "," << harness.kb_per_stream
+                 << "," << harness.readers
+                 << "," << harness.queue_size;
+        }
+        if (has_network) {
+            const NetworkStats net = test.network.value_or(NetworkStats{});
+            file << "," << net.cpu_usage
+                 << "," << net.decode_cpu_usage
+                 << "," << net.rx_mbps
+                 << "," << net.cpu_ms_per_mbit
+                 << "," << net.core_pct_per_stream
+                 << "," << net.udp_rcvbuf_errors;
+        }
+        if (has_ingest) {
+            const IngestStats ingest = test.ingest.value_or(IngestStats{});
+            file << "," << ingest.path
+                 << "," << ingest.receiver_threads
+                 << "," << ingest.recv_syscalls_per_sec
+                 << "," << ingest.datagrams_per_sec
+                 << "," << ingest.core_pct_per_stream
+                 << "," << ingest.stand_in_cpu_usage
+                 << "," << ingest.reader_cpu_ms_per_mbit
+                 << "," << ingest.lost_packets
+                 << "," << ingest.dropped_units;
+        }
+        if (has_segment) {
+            const SegmentStats segment = test.segment.value_or(SegmentStats{});
+            file << "," << segment.format
+                 << "," << segment.segment_duration
+                 << "," << segment.segments_fetched
+                 << "," << segment.manifest_fetches
+                 << "," << segment.reader_cpu_ms_per_segment
+                 << "," << segment.server_cpu_usage;
+        }
+        if (has_sched) {
+            const SchedStats sched = test.sched.value_or(SchedStats{});
+            file << "," << sched.decoder
+                 << "," << sched.reader
+                 << "," << sched.background
+                 << "," << sched.background_streams
+                 << "," << sched.background_avg_fps
+                 << "," << sched.background_min_fps;
+        }
+        if (has_profile) {
+            const ProfileStats profile = test.profile.value_or(ProfileStats{});
+            file << "," << profile.samples
+                 << "," << profile.dropped
+                 << "," << profile.threads
+                 << "," << csvQuote(profile.top_symbols.empty() ? "" : profile.top_symbols.front())
+                 << "," << (profile.top_self_pct.empty() ? 0.0 : profile.top_self_pct.front())
+                 << "," << csvQuote(profile.folded_path);
+        }
+        if (has_record) {
+            // Empty format: a row of the ladder without recording
+            const RecordStats record = test.record.value_or(RecordStats{});
+            file << "," << record.format
+                 << "," << record.segment_seconds
+                 << "," << record.fsync
+                 << "," << (record.direct_io ? 1 : 0)
+                 << "," << record.bytes_written
+                 << "," << record.write_mb_per_sec
+                 << "," << record.segments
+                 << "," << record.fsync_latency.p50_ms
+                 << "," << record.fsync_latency.p95_ms
+                 << "," << record.fsync_latency.p99_ms;
+        }
+        if (has_playback) {
+            // Speed 0: a row of the real-time ladder
+            const PlaybackStats playback = test.playback.value_or(PlaybackStats{});
+            file << "," << playback.speed
+                 << "," << playback.strategy
+                 << "," << playback.displayed_fps
+                 << "," << playback.skipped_pct;
+        }
+        if (has_reverse) {
+            const ReverseStats reverse = test.reverse.value_or(ReverseStats{});
+            file << "," << reverse.cache_frames
+                 << "," << reverse.cache_width
+                 << "," << reverse.cache_mb_per_session
+                 << "," << reverse.rss_mb_per_session
+                 << "," << reverse.decode_ratio
+                 << "," << reverse.chunks_per_sec;
+        }
+        if (has_power) {
+            // Residency as NAME:PCT pairs, shallowest state first
+            const PowerStats& power = *test.power;
+            file << "," << power.cpu_latency_us
+                 << "," << (power.has_energy ? std::to_string(power.package_watts) : "")
+                 << "," << power.idle_entries_per_sec << ",";
+            for (size_t i = 0; i < power.cstate_names.size(); i++) {
+                file << (i == 0 ? "" : ";") << power.cstate_names[i] << ":"
+                     << power.cstate_residency_pct[i];
+            }
+        }
+        if (has_layers) {
+            // Max layer -1: a row of the real-time ladder
+            const LayerStats layers = test.layers.value_or(LayerStats{-1});
+            file << "," << layers.max_layer
+                 << "," << layers.highest_layer
+                 << "," << layers.decoded_fps
+                 << "," << layers.dropped_pct
+                 << "," << layers.parse_ns_per_packet
+                 << "," << layers.parse_us_per_sec;
+        }
+        if (has_mosaic) {
+            const MosaicStats mosaic = test.mosaic.value_or(MosaicStats{});
+            file << "," << mosaic.canvas
+                 << "," << mosaic.layout
+                 << "," << mosaic.tile_width
+                 << "," << mosaic.tile_height
+                 << "," << mosaic.fps
+                 << "," << mosaic.composites
+                 << "," << mosaic.slots
+                 << "," << mosaic.deadline_misses
+                 << "," << mosaic.stale_tile_pct
+                 << "," << mosaic.compose.p95_ms
+                 << "," << mosaic.tile_scale.p95_ms;
+        }
+        file << "\n";
     }
 
     if (!file.good()) {
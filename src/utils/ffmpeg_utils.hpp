@@ -8,6 +8,7 @@ extern "C" {
 #include <libavformat/avformat.h>
 #include <libavcodec/avcodec.h>
 #include <libavutil/error.h>
+#include <libswscale/swscale.h>
 }
 
 namespace video_bench {
@@ -46,11 +47,20 @@ struct AVPacketDeleter {
     }
 };
 
+struct SwsContextDeleter {
+    void operator()(SwsContext* ctx) const {
+        if (ctx) {
+            sws_freeContext(ctx);
+        }
+    }
+};
+
 // Type aliases for RAII-managed FFmpeg objects
 using UniqueAVFormatContext = std::unique_ptr<AVFormatContext, AVFormatContextDeleter>;
 using UniqueAVCodecContext = std::unique_ptr<AVCodecContext, AVCodecContextDeleter>;
 using UniqueAVFrame = std::unique_ptr<AVFrame, AVFrameDeleter>;
 using UniqueAVPacket = std::unique_ptr<AVPacket, AVPacketDeleter>;
+using UniqueSwsContext = std::unique_ptr<SwsContext, SwsContextDeleter>;
 
 // Convert FFmpeg error code to human-readable string
 inline std::string ffmpegErrorString(int errnum) {
@@ -59,10 +69,10 @@ inline std::string ffmpegErrorString(int errnum) {
     return std::string(buf);
 }
 
-// Create standard RTSP options (TCP transport, 5s timeout)
-inline AVDictionary* createRtspOptions() {
+// Create standard RTSP options (TCP transport by default, 5s timeout)
+inline AVDictionary* createRtspOptions(const std::string& transport = "tcp") {
     AVDictionary* options = nullptr;
-    av_dict_set(&options, "rtsp_transport", "tcp", 0);
+    av_dict_set(&options, "rtsp_transport", transport.c_str(), 0);
     av_dict_set(&options, "stimeout", "5000000", 0);
     return options;
 }
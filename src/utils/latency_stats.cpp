@@ -0,0 +1,101 @@
+#include "utils/latency_stats.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace video_bench {
+
+namespace {
+
+// Nearest-rank percentile on a sorted sample set
+double percentile(const std::vector<double>& sorted, double pct) {
+    size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * static_cast<double>(sorted.size())));
+    if (rank == 0) rank = 1;
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+} // namespace
+
+void LatencyHistogram::add(double ms) {
+    size_t bucket = 0;
+    if (ms > kMinMs) {
+        double index = std::ceil(std::log(ms / kMinMs) / std::log(kGrowth));
+        bucket = std::min(static_cast<size_t>(index), kBuckets - 1);
+    }
+    buckets_[bucket]++;
+    count_++;
+    sum_ms_ += ms;
+    max_ms_ = std::max(max_ms_, ms);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; i++) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ms_ += other.sum_ms_;
+    max_ms_ = std::max(max_ms_, other.max_ms_);
+}
+
+double LatencyHistogram::upperBoundMs(size_t bucket) const {
+    if (bucket == 0) {
+        return 0.0;
+    }
+    return std::min(kMinMs * std::pow(kGrowth, static_cast<double>(bucket)), max_ms_);
+}
+
+LatencySummary LatencyHistogram::summarize() const {
+    LatencySummary summary;
+    if (count_ == 0) {
+        return summary;
+    }
+    summary.count = count_;
+    summary.avg_ms = sum_ms_ / static_cast<double>(count_);
+    summary.max_ms = max_ms_;
+
+    // Nearest rank, as for LatencyRecorder
+    auto percentile = [this](double pct) {
+        auto rank = static_cast<int64_t>(std::ceil(pct / 100.0 * static_cast<double>(count_)));
+        rank = std::max<int64_t>(rank, 1);
+        int64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                return upperBoundMs(i);
+            }
+        }
+        return max_ms_;
+    };
+    summary.p50_ms = percentile(50.0);
+    summary.p95_ms = percentile(95.0);
+    summary.p99_ms = percentile(99.0);
+    return summary;
+}
+
+void LatencyRecorder::merge(const LatencyRecorder& other) {
+    samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+}
+
+LatencySummary LatencyRecorder::summarize() const {
+    LatencySummary summary;
+    if (samples_.empty()) {
+        return summary;
+    }
+
+    std::vector<double> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (double v : sorted) {
+        sum += v;
+    }
+
+    summary.count = static_cast<int64_t>(sorted.size());
+    summary.avg_ms = sum / static_cast<double>(sorted.size());
+    summary.p50_ms = percentile(sorted, 50.0);
+    summary.p95_ms = percentile(sorted, 95.0);
+    summary.p99_ms = percentile(sorted, 99.0);
+    summary.max_ms = sorted.back();
+    return summary;
+}
+
+} // namespace video_bench
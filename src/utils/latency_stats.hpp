@@ -0,0 +1,71 @@
+#ifndef LATENCY_STATS_HPP
+#define LATENCY_STATS_HPP
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace video_bench {
+
+// Summary of a set of latency samples (all values in milliseconds)
+struct LatencySummary {
+    int64_t count = 0;
+    double avg_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Collects latency samples and computes percentile summaries
+// Not thread-safe: use one recorder per thread and merge() afterwards
+class LatencyRecorder {
+public:
+    void add(double ms) { samples_.push_back(ms); }
+
+    // Append all samples from another recorder
+    void merge(const LatencyRecorder& other);
+
+    size_t size() const { return samples_.size(); }
+    bool empty() const { return samples_.empty(); }
+
+    LatencySummary summarize() const;
+
+private:
+    std::vector<double> samples_;
+};
+
+// Fixed-size latency distribution for per-frame samples: buckets 2% wide
+// on a log scale from 1 us to 100 s, so memory and merge cost do not grow
+// with the frame count. Percentiles are bucket upper bounds (at most 2%
+// high, never above the maximum); samples below 1 us read as 0.
+// Not thread-safe: use one histogram per thread and merge() afterwards
+class LatencyHistogram {
+public:
+    void add(double ms);
+
+    void merge(const LatencyHistogram& other);
+
+    int64_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    LatencySummary summarize() const;
+
+private:
+    static constexpr double kMinMs = 0.001;
+    static constexpr double kGrowth = 1.02;
+    // ceil(log(100 s / kMinMs) / log(kGrowth)) + 1
+    static constexpr size_t kBuckets = 932;
+
+    double upperBoundMs(size_t bucket) const;
+
+    std::array<int64_t, kBuckets> buckets_{};
+    int64_t count_ = 0;
+    double sum_ms_ = 0.0;
+    double max_ms_ = 0.0;
+};
+
+} // namespace video_bench
+
+#endif // LATENCY_STATS_HPP
@@ -46,12 +46,12 @@ void OutputFormatter::printTestingStart() {
     printInfoLine("Testing...");
 }
 
-void OutputFormatter::printTestResult(const StreamTestResult& result) {
+void OutputFormatter::printTestResult(const StreamTestResult& result, const std::string& prefix) {
     // Format: " N stream(s): XXXfps (min:XX/avg:XX/max:XX) (CPU: YY%) [status]"
     std::string stream_word = result.stream_count == 1 ? "stream: " : "streams:";
 
     std::ostringstream line;
-    line << std::setw(2) << result.stream_count << " " << stream_word
+    line << prefix << std::setw(2) << result.stream_count << " " << stream_word
          << std::setw(5) << static_cast<int>(result.fps_per_stream) << "fps"
          << " (min:" << static_cast<int>(result.min_fps)
          << "/avg:" << static_cast<int>(result.fps_per_stream)
@@ -64,8 +64,335 @@ void OutputFormatter::printTestResult(const StreamTestResult& result) {
         line << " " << result.getFailureReason();
     }
 
+    if (result.from_cache) {
+        line << " (cached)";
+    }
+
     printInfoLine(line.str());
 
+    if (result.lag.late_frames > 0) {
+        const LagStats& lag = result.lag;
+        std::ostringstream lag_line;
+        lag_line << std::fixed << std::setprecision(1)
+                 << "    late frames: " << lag.late_frames
+                 << " (max " << lag.max_lag_ms << "ms): decode " << lag.slow_decode
+                 << " (key " << lag.slow_decode_key << "/delta " << lag.slow_decode_delta
+                 << "), stages " << lag.stage_work
+                 << ", reader starved " << lag.reader_starved
+                 << ", scheduler ";
+        if (lag.run_delay_available) {
+            lag_line << lag.scheduler_delay;
+        } else {
+            lag_line << "n/a";
+        }
+        lag_line << ", oversleep " << lag.oversleep;
+        printInfoLine(lag_line.str());
+    }
+
+    if (result.snapshot) {
+        const SnapshotStats& snap = *result.snapshot;
+        std::ostringstream snap_line;
+        snap_line << std::fixed << std::setprecision(1)
+                  << "    snapshots: " << snap.taken
+                  << " (latency avg:" << snap.latency.avg_ms
+                  << "/p95:" << snap.latency.p95_ms
+                  << "/max:" << snap.latency.max_ms << "ms"
+                  << ", " << (snap.avg_bytes / 1024) << "KB avg)";
+        if (snap.dropped > 0) {
+            snap_line << " dropped: " << snap.dropped;
+        }
+        printInfoLine(snap_line.str());
+    }
+
+    if (result.motion) {
+        const MotionStats& motion = *result.motion;
+        double motion_pct = motion.frames_analyzed > 0
+            ? 100.0 * static_cast<double>(motion.motion_frames) / motion.frames_analyzed
+            : 0.0;
+        std::ostringstream motion_line;
+        motion_line << std::fixed << std::setprecision(1)
+                    << "    motion: " << motion.frames_analyzed << " frames"
+                    << " (cost avg:" << motion.cost.avg_ms * 1000.0
+                    << "/p95:" << motion.cost.p95_ms * 1000.0 << "us, "
+                    << motion.kernel << ")"
+                    << " motion in " << motion_pct << "%";
+        printInfoLine(motion_line.str());
+    }
+
+    if (result.channel_switch) {
+        const SwitchStats& sw = *result.channel_switch;
+        std::ostringstream switch_line;
+        switch_line << std::fixed << std::setprecision(1)
+                    << "    switches: " << sw.switches
+                    << " (latency avg:" << sw.latency.avg_ms
+                    << "/p95:" << sw.latency.p95_ms
+                    << "/max:" << sw.latency.max_ms << "ms"
+                    << ", CPU " << sw.avg_cpu_ms << "ms/" << sw.avg_frames << " frames per switch)"
+                    << " ring: " << sw.ring_kb_per_stream << "KB/stream, "
+                    << sw.ring_kb_total << "KB total";
+        printInfoLine(switch_line.str());
+    }
+
+    if (result.hash_check) {
+        const HashCheckStats& hash = *result.hash_check;
+        std::ostringstream hash_line;
+        hash_line << std::fixed << std::setprecision(1)
+                  << "    output hash: " << hash.frames_checked << " frames checked"
+                  << " (cost avg:" << hash.cost.avg_ms * 1000.0
+                  << "/p95:" << hash.cost.p95_ms * 1000.0 << "us, "
+                  << hash.kernel << ")";
+        if (hash.mismatches > 0) {
+            hash_line << " MISMATCH: " << hash.mismatches << " frames";
+        } else {
+            hash_line << " bit-exact";
+        }
+        printInfoLine(hash_line.str());
+
+        // Per-stream mismatch counts and first bad frame index (log file only)
+        for (size_t i = 0; i < hash.per_stream_mismatches.size(); i++) {
+            if (hash.per_stream_mismatches[i] == 0) continue;
+            std::ostringstream mismatch_line;
+            mismatch_line << "  stream " << i << ": " << hash.per_stream_mismatches[i]
+                          << " mismatched frames";
+            if (i < hash.per_stream_first_mismatch.size()) {
+                mismatch_line << ", first at frame " << hash.per_stream_first_mismatch[i];
+            }
+            video_bench::Logger::info(mismatch_line.str());
+        }
+    }
+
+    if (result.batch) {
+        const BatchStats& batch = *result.batch;
+        std::ostringstream batch_line;
+        batch_line << std::fixed << std::setprecision(1)
+                   << "    batches: " << (batch.full_batches + batch.deadline_batches)
+                   << " x" << batch.batch_size << " (" << batch.batches_per_sec << "/s, "
+                   << batch.deadline_batches << " at deadline)"
+                   << " assembly avg:" << batch.assembly.avg_ms
+                   << "/p95:" << batch.assembly.p95_ms
+                   << "/max:" << batch.assembly.max_ms << "ms"
+                   << ", convert " << batch.convert.avg_ms * 1000.0 << "us/frame ("
+                   << batch.kernel << ")";
+        if (batch.frames_dropped > 0) {
+            batch_line << " dropped: " << batch.frames_dropped;
+        }
+        printInfoLine(batch_line.str());
+    }
+
+    if (result.harness) {
+        const HarnessStats& harness = *result.harness;
+        std::ostringstream harness_line;
+        harness_line << std::fixed << std::setprecision(1)
+                     << "    harness: " << harness.kb_per_stream << "KB/stream"
+                     << " (" << harness.readers << " readers, queue "
+                     << harness.queue_size << ", fd limit " << harness.fd_limit << ")";
+        printInfoLine(harness_line.str());
+    }
+
+    if (result.network) {
+        const NetworkStats& net = *result.network;
+        std::ostringstream net_line;
+        net_line << std::fixed << std::setprecision(1)
+                 << "    network: CPU " << net.cpu_usage << "% (decode "
+                 << net.decode_cpu_usage << "%), " << net.rx_mbps << " Mbit/s"
+                 << std::setprecision(3)
+                 << ", " << net.cpu_ms_per_mbit << " core-ms/Mbit"
+                 << ", " << net.core_pct_per_stream << "% core/stream";
+        if (net.udp_rcvbuf_errors > 0) {
+            net_line << " rcvbuf drops: " << net.udp_rcvbuf_errors;
+        }
+        printInfoLine(net_line.str());
+
+        std::ostringstream counters_line;
+        counters_line << "  network counters: NET_RX softirqs " << net.net_rx_softirqs
+                      << ", NIC IRQs " << net.nic_interrupts
+                      << ", UDP in " << net.udp_in_datagrams
+                      << ", TCP in " << net.tcp_in_segs;
+        video_bench::Logger::info(counters_line.str());
+    }
+
+    if (result.ingest) {
+        const IngestStats& ingest = *result.ingest;
+        std::ostringstream ingest_line;
+        ingest_line << std::fixed << std::setprecision(0)
+                    << "    ingest: " << ingest.path;
+        if (ingest.receiver_threads > 0) {
+            ingest_line << " x" << ingest.receiver_threads;
+        }
+        ingest_line << ", ";
+        if (ingest.recv_syscalls_per_sec > 0) {
+            ingest_line << ingest.recv_syscalls_per_sec << " recv/s";
+        } else {
+            ingest_line << "recv/s n/a";
+        }
+        ingest_line << ", " << ingest.datagrams_per_sec << " datagrams/s"
+                    << std::setprecision(1)
+                    << ", " << ingest.core_pct_per_stream << "% core/stream";
+        if (ingest.reader_cpu_ms_per_mbit > 0) {
+            ingest_line << std::setprecision(3)
+                        << ", reader " << ingest.reader_cpu_ms_per_mbit << " core-ms/Mbit"
+                        << std::setprecision(1);
+        }
+        if (ingest.stand_in_cpu_usage > 0) {
+            ingest_line << " (stand-in " << ingest.stand_in_cpu_usage << "% excluded)";
+        }
+        if (ingest.lost_packets > 0 || ingest.dropped_units > 0) {
+            ingest_line << " lost: " << ingest.lost_packets
+                        << " dropped AUs: " << ingest.dropped_units;
+        }
+        printInfoLine(ingest_line.str());
+    }
+
+    if (result.segment) {
+        const SegmentStats& segment = *result.segment;
+        std::ostringstream segment_line;
+        segment_line << std::fixed << std::setprecision(1)
+                     << "    segments: " << segment.format << " " << segment.segment_duration
+                     << "s, " << segment.segments_fetched << " fetched, "
+                     << segment.manifest_fetches << " manifest fetches"
+                     << std::setprecision(3)
+                     << ", reader " << segment.reader_cpu_ms_per_segment << " core-ms/segment"
+                     << std::setprecision(1)
+                     << " (server " << segment.server_cpu_usage << "% excluded)";
+        printInfoLine(segment_line.str());
+    }
+
+    if (result.sched) {
+        const SchedStats& sched = *result.sched;
+        std::ostringstream sched_line;
+        sched_line << std::fixed << std::setprecision(1)
+                   << "    sched: decoder " << sched.decoder << ", reader " << sched.reader
+                   << ", lateness p50/p95/p99 " << result.lag.lateness.p50_ms << "/"
+                   << result.lag.lateness.p95_ms << "/" << result.lag.lateness.p99_ms << "ms";
+        if (sched.background_streams > 0) {
+            sched_line << ", " << sched.background_streams << " background (" << sched.background
+                       << ") min:" << sched.background_min_fps
+                       << "/avg:" << sched.background_avg_fps << "fps";
+        }
+        printInfoLine(sched_line.str());
+    }
+
+    if (result.profile) {
+        const ProfileStats& profile = *result.profile;
+        std::ostringstream profile_line;
+        profile_line << std::fixed << std::setprecision(1)
+                     << "    profile: " << profile.samples << " samples on "
+                     << profile.threads << " threads";
+        for (size_t i = 0; i < profile.top_symbols.size() && i < 3; i++) {
+            profile_line << (i == 0 ? ", top: " : ", ")
+                         << profile.top_symbols[i] << " " << profile.top_self_pct[i] << "%";
+        }
+        if (profile.dropped > 0) {
+            profile_line << " (" << profile.dropped << " dropped)";
+        }
+        printInfoLine(profile_line.str());
+        video_bench::Logger::info("  profile files: " + profile.flat_path + ", " +
+                                  profile.folded_path);
+    }
+
+    if (result.record) {
+        const RecordStats& record = *result.record;
+        std::ostringstream record_line;
+        record_line << std::fixed << std::setprecision(1)
+                    << "    record: " << record.format << " " << record.segment_seconds
+                    << "s segments" << (record.direct_io ? " (O_DIRECT)" : "")
+                    << ", " << record.write_mb_per_sec << " MB/s, "
+                    << record.segments << " segment" << (record.segments == 1 ? "" : "s")
+                    << " closed, fsync " << record.fsync;
+        if (record.fsync_latency.count > 0) {
+            record_line << std::setprecision(2) << " p50/p95/p99 "
+                        << record.fsync_latency.p50_ms << "/" << record.fsync_latency.p95_ms
+                        << "/" << record.fsync_latency.p99_ms << "ms";
+        }
+        printInfoLine(record_line.str());
+    }
+
+    if (result.playback) {
+        const PlaybackStats& playback = *result.playback;
+        std::ostringstream playback_line;
+        playback_line << std::fixed << std::setprecision(1)
+                      << "    playback: " << playback.speed << "x " << playback.strategy
+                      << ", " << playback.displayed_fps << " displayed fps/session, "
+                      << playback.skipped_pct << "% of frames not shown";
+        printInfoLine(playback_line.str());
+    }
+
+    if (result.reverse) {
+        const ReverseStats& reverse = *result.reverse;
+        std::ostringstream reverse_line;
+        reverse_line << std::fixed << std::setprecision(1)
+                     << "    reverse: " << reverse.cache_frames << " frame cache";
+        if (reverse.cache_width > 0) {
+            reverse_line << " at " << reverse.cache_width << "px";
+        }
+        reverse_line << ", " << reverse.cache_mb_per_session << " MB cache/"
+                     << reverse.rss_mb_per_session << " MB RSS per session"
+                     << std::setprecision(2) << ", " << reverse.decode_ratio
+                     << " frames decoded per frame shown, " << reverse.chunks_per_sec
+                     << " chunks/s per session";
+        printInfoLine(reverse_line.str());
+    }
+
+    if (result.mosaic) {
+        const MosaicStats& mosaic = *result.mosaic;
+        std::ostringstream mosaic_line;
+        mosaic_line << std::fixed << std::setprecision(1)
+                    << "    mosaic: " << mosaic.canvas << " " << mosaic.layout << " ("
+                    << mosaic.tile_width << "x" << mosaic.tile_height << " tiles) at "
+                    << mosaic.fps << "fps, " << mosaic.deadline_misses << "/"
+                    << mosaic.slots << " slots missed, "
+                    << mosaic.stale_tile_pct << "% stale tiles"
+                    << std::setprecision(2) << ", compose p95 " << mosaic.compose.p95_ms
+                    << "ms, tile scale p95 " << mosaic.tile_scale.p95_ms << "ms";
+        printInfoLine(mosaic_line.str());
+    }
+
+    if (result.layers) {
+        const LayerStats& layers = *result.layers;
+        std::ostringstream layer_line;
+        layer_line << std::fixed << std::setprecision(1)
+                   << "    layers: 0-" << layers.max_layer << " of 0-" << layers.highest_layer
+                   << ", " << layers.decoded_fps << " decoded fps/session, "
+                   << layers.dropped_pct << "% of packets dropped, parse "
+                   << layers.parse_ns_per_packet << " ns/packet"
+                   << " (" << layers.parse_us_per_sec << " us/s per session)";
+        printInfoLine(layer_line.str());
+    }
+
+    if (result.power) {
+        const PowerStats& power = *result.power;
+        std::ostringstream power_line;
+        power_line << std::fixed << std::setprecision(1) << "    power: PM QoS ";
+        if (power.cpu_latency_us >= 0) {
+            power_line << power.cpu_latency_us << "us";
+        } else {
+            power_line << "off";
+        }
+        if (power.has_energy) {
+            power_line << ", " << power.package_watts << " W package";
+        }
+        for (size_t i = 0; i < power.cstate_names.size(); i++) {
+            power_line << (i == 0 ? ", " : "/") << power.cstate_names[i] << " "
+                       << power.cstate_residency_pct[i] << "%";
+        }
+        power_line << std::setprecision(0) << ", " << power.idle_entries_per_sec
+                   << " idle entries/s per core";
+        printInfoLine(power_line.str());
+    }
+
+    // Window-counted FPS against the previous counting method (log file only)
+    if (result.window_seconds > 0 && result.fps_per_stream > 0) {
+        double correction_pct = 100.0 * (result.legacy_fps_per_stream - result.fps_per_stream)
+                                / result.fps_per_stream;
+        std::ostringstream window_line;
+        window_line << std::fixed << std::setprecision(3)
+                    << "  measurement window: " << result.window_seconds << "s, "
+                    << std::setprecision(2) << result.fps_per_stream << "fps/stream"
+                    << " (legacy count " << result.legacy_fps_per_stream << "fps/stream, "
+                    << std::showpos << correction_pct << std::noshowpos << "%)";
+        video_bench::Logger::info(window_line.str());
+    }
+
     // Log per-stream frame counts (log file only)
     if (!result.per_stream_frames.empty()) {
         std::ostringstream frames_line;
@@ -92,6 +419,186 @@ void OutputFormatter::printSummary(const BenchmarkResult& result) {
     }
 
     printInfoLine(line.str());
+
+    // Reverse mode: memory per session at the capacity found
+    for (const StreamTestResult& test : result.test_results) {
+        if (test.reverse && test.stream_count == result.max_streams) {
+            std::ostringstream reverse_line;
+            reverse_line << std::fixed << std::setprecision(1)
+                         << "Reverse playback: max " << result.max_streams << " session"
+                         << (result.max_streams == 1 ? "" : "s") << ", "
+                         << test.reverse->rss_mb_per_session << " MB RSS per session ("
+                         << test.reverse->cache_mb_per_session << " MB frame cache), CPU "
+                         << static_cast<int>(test.cpu_usage) << "%";
+            printInfoLine(reverse_line.str());
+            break;
+        }
+    }
+
+    if (result.tls) {
+        const TlsComparison& tls = *result.tls;
+        std::ostringstream tls_line;
+        tls_line << std::fixed << std::setprecision(3)
+                 << "TLS ingest (" << (tls.cipher.empty() ? "unknown cipher" : tls.cipher)
+                 << "): max streams " << tls.plain_max_streams << " -> " << tls.tls_max_streams
+                 << ", +" << tls.tls_cpu_ms_per_mbit << " core-ms/Mbit ("
+                 << tls.plain_reader_cpu_ms_per_mbit << " -> "
+                 << tls.tls_reader_cpu_ms_per_mbit << " reader core-ms/Mbit at 1 stream)";
+        printInfoLine(tls_line.str());
+    }
+
+    if (result.recording) {
+        const RecordComparison& recording = *result.recording;
+        std::ostringstream record_line;
+        record_line << "Recording: max streams " << recording.baseline_max_streams
+                    << " without -> " << recording.recording_max_streams << " with recording";
+        printInfoLine(record_line.str());
+    }
+
+    if (result.snapshots) {
+        const SnapshotComparison& snapshots = *result.snapshots;
+        std::ostringstream snapshot_line;
+        snapshot_line << "Snapshots: max streams " << snapshots.baseline_max_streams
+                      << " without -> " << snapshots.snapshot_max_streams << " with snapshots";
+        printInfoLine(snapshot_line.str());
+    }
+
+    if (result.cpu_latency) {
+        const CpuLatencyComparison& latency = *result.cpu_latency;
+        std::ostringstream latency_line;
+        latency_line << std::fixed << std::setprecision(2)
+                     << "PM QoS " << latency.latency_us << "us: max streams "
+                     << latency.released_max_streams << " without -> " << latency.held_max_streams
+                     << " with; at " << latency.streams << " stream"
+                     << (latency.streams == 1 ? "" : "s") << ", lateness p99 "
+                     << latency.released_lateness.p99_ms << " -> "
+                     << latency.held_lateness.p99_ms << "ms";
+        if (latency.has_energy) {
+            latency_line << std::setprecision(1) << ", package " << latency.released_watts
+                         << " -> " << latency.held_watts << " W";
+        }
+        printInfoLine(latency_line.str());
+    }
+
+    for (const PlaybackPoint& point : result.playback) {
+        std::ostringstream playback_line;
+        playback_line << std::fixed << std::setprecision(1)
+                      << "Playback " << point.speed << "x (" << point.strategy << "): max "
+                      << point.max_sessions << " session" << (point.max_sessions == 1 ? "" : "s")
+                      << ", " << point.displayed_fps << " displayed fps/session";
+        printInfoLine(playback_line.str());
+    }
+
+    for (const LayerPoint& point : result.layers) {
+        std::ostringstream layer_line;
+        layer_line << std::fixed << std::setprecision(1)
+                   << "Temporal layers 0-" << point.max_layer << ": max streams "
+                   << point.max_streams << ", " << point.decoded_fps << " decoded fps/stream, "
+                   << point.dropped_pct << "% of packets dropped";
+        printInfoLine(layer_line.str());
+    }
+
+    for (const MosaicPoint& point : result.mosaic) {
+        std::ostringstream mosaic_line;
+        mosaic_line << std::fixed << std::setprecision(1)
+                    << "Mosaic " << point.canvas << ": max " << point.max_tiles << " tile"
+                    << (point.max_tiles == 1 ? "" : "s");
+        if (!point.layout.empty()) {
+            mosaic_line << " (" << point.layout << " layout), " << point.deadline_miss_pct
+                        << "% slots missed";
+        }
+        printInfoLine(mosaic_line.str());
+    }
+
+    for (const SchedComparisonPoint& point : result.sched_comparison) {
+        std::ostringstream sched_line;
+        sched_line << std::fixed << std::setprecision(1)
+                   << "Decoder policy " << point.decoder << ": max streams " << point.max_streams
+                   << ", lateness p50/p95/p99 " << point.lateness.p50_ms << "/"
+                   << point.lateness.p95_ms << "/" << point.lateness.p99_ms
+                   << "ms at max streams";
+        printInfoLine(sched_line.str());
+    }
+
+    for (const SegmentSweepPoint& point : result.segment_sweep) {
+        std::ostringstream sweep_line;
+        sweep_line << std::fixed << std::setprecision(1)
+                   << "Segment duration " << point.segment_duration << "s: max streams "
+                   << point.max_streams << std::setprecision(3)
+                   << ", reader " << point.reader_cpu_ms_per_segment
+                   << " core-ms/segment at 1 stream";
+        printInfoLine(sweep_line.str());
+    }
+}
+
+void OutputFormatter::printFleetSummary(const FleetResult& result) {
+    std::cout << "\n";
+
+    std::ostringstream line;
+    line << "Fleet result: " << result.total_max_streams << " concurrent streams in real-time on "
+         << result.hosts.size() << " agent" << (result.hosts.size() == 1 ? "" : "s");
+    printInfoLine(line.str());
+
+    for (const FleetHostResult& host : result.hosts) {
+        std::ostringstream host_line;
+        host_line << "  " << host.agent << " (" << host.result.cpu_name << ", "
+                  << host.result.thread_count << " threads): max "
+                  << host.result.max_streams << " stream"
+                  << (host.result.max_streams == 1 ? "" : "s") << " of "
+                  << host.result.codec_name << " " << host.result.video_resolution;
+        printInfoLine(host_line.str());
+    }
+}
+
+void OutputFormatter::printLoopMicrobench(const LoopMicrobenchResult& result) {
+    std::ostringstream header;
+    header << "Decode loop: " << result.frames << " packets per round from "
+           << result.preloaded_packets << " in memory, fastest of " << result.rounds
+           << " rounds, unpaced, 1 decoder thread";
+    printInfoLine(header.str());
+
+    double overhead_pct = result.bare_ns_per_frame > 0.0
+        ? 100.0 * result.overheadNsPerFrame() / result.bare_ns_per_frame : 0.0;
+    std::ostringstream lines[3];
+    lines[0] << std::fixed << std::setprecision(0)
+             << "  bare:         " << result.bare_ns_per_frame << " ns/frame";
+    lines[1] << std::fixed << std::setprecision(0)
+             << "  instrumented: " << result.instrumented_ns_per_frame << " ns/frame";
+    lines[2] << std::fixed << std::setprecision(0)
+             << "  overhead:     " << result.overheadNsPerFrame() << " ns/frame ("
+             << std::setprecision(2) << overhead_pct << "%)";
+    for (const auto& line : lines) {
+        printInfoLine(line.str());
+    }
+}
+
+void OutputFormatter::printCanary(const CanaryResult& result) {
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(1)
+           << "Canary: " << result.packets << " packets per round, median of " << result.rounds
+           << " rounds, unpaced, 1 decoder thread, " << std::setprecision(0)
+           << result.cpu_budget_pct << "% CPU budget (" << std::setprecision(1)
+           << result.elapsed_seconds << "s)";
+    printInfoLine(header.str());
+
+    std::ostringstream speed;
+    speed << std::fixed << std::setprecision(1) << "  decode speed: " << result.fps << " fps";
+    printInfoLine(speed.str());
+
+    std::ostringstream baseline;
+    baseline << std::fixed << std::setprecision(1) << "  baseline:     ";
+    if (result.baseline_recorded) {
+        baseline << "recorded to " << result.baseline_path;
+    } else {
+        baseline << result.baseline_fps << " fps (" << std::showpos << result.drift_pct
+                 << std::noshowpos << "%, tolerance " << std::setprecision(0)
+                 << result.tolerance_pct << "%) " << (result.degraded ? "DEGRADED" : "OK");
+    }
+    printInfoLine(baseline.str());
+
+    for (const std::string& change : result.host_changes) {
+        printInfoLine("  host changed: " + change);
+    }
 }
 
 void OutputFormatter::printError(const std::string& message) {
@@ -2,6 +2,8 @@
 #define OUTPUT_FORMATTER_HPP
 
 #include "benchmark/benchmark_result.hpp"
+#include "benchmark/loop_microbench.hpp"
+#include "benchmark/canary_check.hpp"
 #include <string>
 
 namespace video_bench {
@@ -14,12 +16,21 @@ public:
     // Print "Testing..." line
     static void printTestingStart();
 
-    // Print a single test result line
-    static void printTestResult(const StreamTestResult& result);
+    // Print a single test result line (prefix: e.g. the fleet agent)
+    static void printTestResult(const StreamTestResult& result, const std::string& prefix = "");
 
     // Print the final summary
     static void printSummary(const BenchmarkResult& result);
 
+    // Print per-agent max streams and the fleet total
+    static void printFleetSummary(const FleetResult& result);
+
+    // Print the decode loop microbenchmark (--loop-bench)
+    static void printLoopMicrobench(const LoopMicrobenchResult& result);
+
+    // Print a canary check against the host baseline (--canary)
+    static void printCanary(const CanaryResult& result);
+
     // Print an error message
     static void printError(const std::string& message);
 };
@@ -0,0 +1,35 @@
+#ifndef THREAD_CPU_TIME_HPP
+#define THREAD_CPU_TIME_HPP
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace video_bench {
+
+// CPU time consumed by the calling thread in milliseconds
+inline double threadCpuTimeMs() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    auto to_100ns = [](const FILETIME& ft) {
+        return (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return static_cast<double>(to_100ns(kernel) + to_100ns(user)) / 10000.0;
+#else
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+#endif
+}
+
+} // namespace video_bench
+
+#endif // THREAD_CPU_TIME_HPP
@@ -0,0 +1,120 @@
+#include "utils/thread_scheduling.hpp"
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace video_bench {
+
+namespace {
+std::optional<int> parseNumber(const std::string& str) {
+    int value;
+    auto result = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (result.ec == std::errc() && result.ptr == str.data() + str.size()) {
+        return value;
+    }
+    return std::nullopt;
+}
+} // namespace
+
+std::optional<SchedPolicy> SchedPolicy::parse(const std::string& spec) {
+    size_t colon = spec.find(':');
+    const std::string name = spec.substr(0, colon);
+    const bool has_arg = colon != std::string::npos;
+    std::optional<int> arg;
+    if (has_arg) {
+        arg = parseNumber(spec.substr(colon + 1));
+        if (!arg) {
+            return std::nullopt;
+        }
+    }
+
+    SchedPolicy policy;
+    if (name == "default" || name == "idle") {
+        if (has_arg) {
+            return std::nullopt;
+        }
+        policy.kind = name == "idle" ? Kind::Idle : Kind::Default;
+    } else if (name == "other" || name == "batch") {
+        if (arg && (*arg < -20 || *arg > 19)) {
+            return std::nullopt;
+        }
+        policy.kind = name == "batch" ? Kind::Batch : Kind::Other;
+        policy.nice = arg.value_or(0);
+    } else if (name == "fifo" || name == "rr") {
+        if (!arg || *arg < 1 || *arg > 99) {
+            return std::nullopt;
+        }
+        policy.kind = name == "rr" ? Kind::Rr : Kind::Fifo;
+        policy.priority = *arg;
+    } else {
+        return std::nullopt;
+    }
+    return policy;
+}
+
+std::string SchedPolicy::toString() const {
+    switch (kind) {
+        case Kind::Default: return "default";
+        case Kind::Other: return "other:" + std::to_string(nice);
+        case Kind::Batch: return "batch:" + std::to_string(nice);
+        case Kind::Idle: return "idle";
+        case Kind::Fifo: return "fifo:" + std::to_string(priority);
+        case Kind::Rr: return "rr:" + std::to_string(priority);
+    }
+    return "default";
+}
+
+bool applySchedPolicy(const SchedPolicy& policy, std::string& error_message) {
+    if (policy.isDefault()) {
+        return true;
+    }
+#if defined(__linux__)
+    int linux_policy = SCHED_OTHER;
+    sched_param param{};
+    switch (policy.kind) {
+        case SchedPolicy::Kind::Batch: linux_policy = SCHED_BATCH; break;
+        case SchedPolicy::Kind::Idle: linux_policy = SCHED_IDLE; break;
+        case SchedPolicy::Kind::Fifo: linux_policy = SCHED_FIFO; break;
+        case SchedPolicy::Kind::Rr: linux_policy = SCHED_RR; break;
+        default: break;
+    }
+    if (linux_policy == SCHED_FIFO || linux_policy == SCHED_RR) {
+        param.sched_priority = policy.priority;
+    }
+
+    // pid 0 is the calling thread, not the whole process
+    if (sched_setscheduler(0, linux_policy, &param) != 0) {
+        error_message = "Failed to set scheduling policy " + policy.toString() + ": " +
+                        std::strerror(errno);
+        return false;
+    }
+    // Nice is per thread on Linux: address the thread by its tid
+    if ((linux_policy == SCHED_OTHER || linux_policy == SCHED_BATCH) &&
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), policy.nice) != 0) {
+        error_message = "Failed to set nice " + std::to_string(policy.nice) + ": " +
+                        std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    error_message = "Scheduling policy " + policy.toString() + " is only supported on Linux";
+    return false;
+#endif
+}
+
+bool checkSchedPolicy(const SchedPolicy& policy, std::string& error_message) {
+    bool ok = false;
+    std::thread probe([&] { ok = applySchedPolicy(policy, error_message); });
+    probe.join();
+    return ok;
+}
+
+} // namespace video_bench
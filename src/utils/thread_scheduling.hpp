@@ -0,0 +1,39 @@
+#ifndef THREAD_SCHEDULING_HPP
+#define THREAD_SCHEDULING_HPP
+
+#include <string>
+#include <optional>
+
+namespace video_bench {
+
+// Scheduling policy for one thread role (decoder, reader, background).
+// Spec syntax: "default" (inherit), "other[:NICE]", "batch[:NICE]", "idle",
+// "fifo:PRIO" or "rr:PRIO" (NICE -20..19, PRIO 1..99).
+struct SchedPolicy {
+    enum class Kind { Default, Other, Batch, Idle, Fifo, Rr };
+
+    Kind kind = Kind::Default;
+    int nice = 0;      // Other and Batch
+    int priority = 0;  // Fifo and Rr
+
+    // Parse a spec; nullopt if malformed or out of range
+    static std::optional<SchedPolicy> parse(const std::string& spec);
+
+    // Spec form, e.g. "batch:5"
+    std::string toString() const;
+
+    bool isDefault() const { return kind == Kind::Default; }
+};
+
+// Apply the policy to the calling thread (Linux). Threads it creates later,
+// such as FFmpeg's decoder workers, inherit policy and nice level.
+// Fails if not permitted: real-time policies and negative nice need
+// CAP_SYS_NICE or a matching RLIMIT_RTPRIO / RLIMIT_NICE.
+bool applySchedPolicy(const SchedPolicy& policy, std::string& error_message);
+
+// Apply the policy on a short-lived thread to find out if it is permitted
+bool checkSchedPolicy(const SchedPolicy& policy, std::string& error_message);
+
+} // namespace video_bench
+
+#endif // THREAD_SCHEDULING_HPP
@@ -34,6 +34,14 @@ VideoCodec VideoAnalyzer::codecIdToType(AVCodecID codec_id) {
             return VideoCodec::VP9;
         case AV_CODEC_ID_AV1:
             return VideoCodec::AV1;
+        case AV_CODEC_ID_MJPEG:
+            return VideoCodec::MJPEG;
+        case AV_CODEC_ID_MPEG2VIDEO:
+            return VideoCodec::MPEG2;
+        case AV_CODEC_ID_MPEG4:
+            return VideoCodec::MPEG4;
+        case AV_CODEC_ID_VVC:
+            return VideoCodec::H266;
         default:
             return VideoCodec::Unknown;
     }
@@ -49,6 +57,14 @@ std::string VideoAnalyzer::codecIdToName(AVCodecID codec_id) {
             return "VP9";
         case AV_CODEC_ID_AV1:
             return "AV1";
+        case AV_CODEC_ID_MJPEG:
+            return "MJPEG";
+        case AV_CODEC_ID_MPEG2VIDEO:
+            return "MPEG-2";
+        case AV_CODEC_ID_MPEG4:
+            return "MPEG-4";
+        case AV_CODEC_ID_VVC:
+            return "H.266";
         default:
             return "Unknown";
     }
@@ -139,6 +155,11 @@ std::optional<VideoInfo> VideoAnalyzer::analyze(const std::string& file_path,
     info.video_stream_index = video_stream_index;
     info.is_live_stream = is_rtsp;
 
+    // VVC needs FFmpeg 7.0 or later (native decoder) or libvvdec
+    info.has_decoder = avcodec_find_decoder(codec_params->codec_id) != nullptr;
+    const AVCodecDescriptor* descriptor = avcodec_descriptor_get(codec_params->codec_id);
+    info.intra_only = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+
     return info;
 }
 
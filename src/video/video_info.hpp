@@ -18,6 +18,10 @@ enum class VideoCodec {
     H265,
     VP9,
     AV1,
+    MJPEG,
+    MPEG2,
+    MPEG4,  // Part 2 (ASP)
+    H266,
     Unknown
 };
 
@@ -33,6 +37,8 @@ struct VideoInfo {
     int64_t total_frames;
     int video_stream_index = -1;
     bool is_live_stream = false;  // True for RTSP and other live sources
+    bool intra_only = false;      // Every frame is a keyframe (MJPEG)
+    bool has_decoder = false;     // This FFmpeg build can decode the codec
 
     // Format resolution as string (e.g., "1080p", "4K")
     std::string getResolutionString() const;